@@ -1,4 +1,4 @@
-#version 330 core
+#version 430 core
 out vec4 FragColor;
 
 struct Material {
@@ -9,6 +9,16 @@ struct Material {
     vec3 baseColour;  
 };
 
+struct MaterialEntry {
+    vec4 diffuse;
+    vec4 specular;
+    vec4 baseColour;
+    int diffuseTexture;
+    int specularTexture;
+    int normalTexture;
+    int heightTexture;
+};
+
 struct DirLight {
     vec3 direction;
 	
@@ -20,46 +30,132 @@ struct DirLight {
 };
 
 struct PointLight {
-    vec3 position;
-    
-    float constant;
-    float linear;
-    float quadratic;
-	
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool isActive;
+    vec4 positionRadius;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+    vec4 attenuation; // constant, linear, quadratic
 };
 
-#define NR_POINT_LIGHTS 16
-
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
+flat in int MaterialIndex;
+in vec4 ClipPos;
+
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 clusterParams; // x, y map log(view depth) to a slice, z near, w far
+    ivec4 clusterGrid;
+};
 
-uniform vec3 viewPos;
 uniform DirLight dirLight;
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-uniform Material material;
+
+layout (std140, binding = 2) uniform ShadowData
+{
+    mat4 cascadeViewProjection[4];
+    vec4 cascadeSplits; // view depth each cascade ends at
+    vec4 shadowParams;  // x cascade count, y point shadow near plane, z cascade texel size
+};
+
+layout (binding = 8) uniform sampler2DArrayShadow shadowCascades;
+layout (binding = 9) uniform samplerCubeArrayShadow pointShadows;
+
+layout (std430, binding = 2) readonly buffer MaterialTable
+{
+    MaterialEntry materials[];
+};
+
+layout (std430, binding = 4) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
+
+layout (std430, binding = 5) readonly buffer LightClusters
+{
+    uvec2 clusters[]; // offset into lightIndices, light count
+};
+
+layout (std430, binding = 6) readonly buffer LightIndices
+{
+    uint lightIndices[];
+};
+
+Material material;
 
 vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
+float CascadeShadow(vec3 normal, vec3 lightDir)
+{
+    // ClipPos.w is the view space depth, pick the first cascade that reaches it
+    int cascadeCount = int(shadowParams.x);
+    int cascade = 0;
+    while (cascade < cascadeCount && ClipPos.w > cascadeSplits[cascade])
+        cascade++;
+
+    if (cascade >= cascadeCount)
+        return 1.0;
+
+    vec4 lightSpace = cascadeViewProjection[cascade] * vec4(FragPos, 1.0);
+    vec3 coords = lightSpace.xyz / lightSpace.w * 0.5 + 0.5;
+    float bias = max(0.002 * (1.0 - dot(normal, lightDir)), 0.0005);
+
+    float shadow = 0.0;
+    for (int y = -1; y <= 1; y++)
+        for (int x = -1; x <= 1; x++)
+            shadow += texture(shadowCascades, vec4(coords.xy + vec2(x, y) * shadowParams.z, float(cascade), coords.z - bias));
+
+    return shadow / 9.0;
+}
+
+float PointShadow(PointLight light, vec3 fragPos)
+{
+    int slot = int(light.attenuation.w);
+    if (slot < 0)
+        return 1.0;
+
+    // Rebuild the depth the cube face stored from the distance along the face's major axis
+    vec3 toFragment = fragPos - light.positionRadius.xyz;
+    vec3 absolute = abs(toFragment);
+    float majorAxis = max(absolute.x, max(absolute.y, absolute.z));
+
+    float near = shadowParams.y;
+    float far = light.positionRadius.w;
+    float depth = ((far + near) / (far - near) - 2.0 * far * near / ((far - near) * majorAxis)) * 0.5 + 0.5;
+
+    return texture(pointShadows, vec4(toFragment, float(slot)), depth - 0.0005);
+}
+
+uint ClusterIndex()
+{
+    vec2 ndc = ClipPos.xy / ClipPos.w;
+    ivec2 tile = clamp(ivec2((ndc * 0.5 + 0.5) * vec2(clusterGrid.xy)), ivec2(0), clusterGrid.xy - 1);
+
+    // ClipPos.w is the view space depth under a perspective projection
+    int slice = clamp(int(floor(log(ClipPos.w) * clusterParams.x - clusterParams.y)), 0, clusterGrid.z - 1);
+
+    return uint(tile.x + clusterGrid.x * (tile.y + clusterGrid.y * slice));
+}
+
 void main()
 {    
+    MaterialEntry entry = materials[MaterialIndex];
+    material = Material(entry.diffuse.rgb, entry.specular.rgb, entry.specular.w, entry.baseColour.rgb);
+
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     vec3 result = vec3(0.0f);
 
     if(dirLight.isActive) {
         result = CalcDirLight(dirLight, norm, viewDir);
     }
-    for(int i = 0; i < NR_POINT_LIGHTS; i++)
-        if(pointLights[i].isActive){ 
-            result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);    
-        } 
+    uvec2 cluster = clusters[ClusterIndex()];
+    for(uint i = 0; i < cluster.y; i++)
+        result += CalcPointLight(pointLights[lightIndices[cluster.x + i]], norm, FragPos, viewDir);
 
     FragColor = vec4(result, 1.0);
 }
@@ -73,23 +169,29 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
     vec3 ambient = light.ambient * material.diffuse;
     vec3 diffuse = light.diffuse * diff * material.diffuse;
     vec3 specular = light.specular * spec * material.specular;
-    return (ambient + diffuse + specular);
+    float shadow = CascadeShadow(normal, lightDir);
+    return ambient + shadow * (diffuse + specular);
 }
 
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 {
-    vec3 lightDir = normalize(light.position - fragPos);
+    vec3 lightDir = normalize(light.positionRadius.xyz - fragPos);
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
-    vec3 ambient = light.ambient * material.diffuse;
-    vec3 diffuse = light.diffuse * diff * material.diffuse;
-    vec3 specular = light.specular * spec * material.specular;
+    float distance = length(light.positionRadius.xyz - fragPos);
+    float attenuation = 1.0 / (light.attenuation.x + light.attenuation.y * distance + light.attenuation.z * (distance * distance));
+
+    // Fade to zero at the radius lights were clustered with so tile edges never show
+    float falloff = clamp(1.0 - pow(distance / light.positionRadius.w, 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
+    vec3 ambient = light.ambient.rgb * material.diffuse;
+    vec3 diffuse = light.diffuse.rgb * diff * material.diffuse;
+    vec3 specular = light.specular.rgb * spec * material.specular;
     ambient *= attenuation;
     diffuse *= attenuation;
     specular *= attenuation;
-    return (ambient + diffuse + specular);
+    float shadow = PointShadow(light, fragPos);
+    return ambient + shadow * (diffuse + specular);
 }
 
@@ -0,0 +1,28 @@
+#version 430 core
+layout (location = 0) in vec3 aPos;
+
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 clusterParams; // x, y map log(view depth) to a slice, z near, w far
+    ivec4 clusterGrid;
+};
+
+layout (std140, binding = 1) uniform DrawData
+{
+    mat4 model;
+    mat4 normalMatrix;
+    ivec4 drawInfo;
+};
+
+// Must match the colour pass shaders exactly, the colour pass depth tests with GL_EQUAL against this output
+invariant gl_Position;
+
+void main()
+{
+    vec3 worldPos = vec3(model * vec4(aPos, 1.0));
+
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+}
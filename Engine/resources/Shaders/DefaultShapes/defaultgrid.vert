@@ -1,10 +1,22 @@
-#version 330 core
+#version 430 core
 
 layout(location = 0) in vec3 aPos;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 clusterParams; // x, y map log(view depth) to a slice, z near, w far
+    ivec4 clusterGrid;
+};
+
+layout (std140, binding = 1) uniform DrawData
+{
+    mat4 model;
+    mat4 normalMatrix;
+    ivec4 drawInfo;
+};
 
 out vec3 FragPos;
 
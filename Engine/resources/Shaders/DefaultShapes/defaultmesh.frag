@@ -1,12 +1,28 @@
-#version 330 core
+#version 430 core
 out vec4 FragColor;
 
 struct Material {
-    sampler2D diffuse;
     vec3 specular;
     float shininess;
 };
 
+struct MaterialEntry {
+    vec4 diffuse;
+    vec4 specular;
+    vec4 baseColour;
+    int diffuseTexture;
+    int specularTexture;
+    int normalTexture;
+    int heightTexture;
+};
+
+struct TextureRef {
+    int slot;
+    int layer;
+    float minLod;
+    float padding;
+};
+
 struct DirLight {
     vec3 direction;
     vec3 ambient;
@@ -16,43 +32,176 @@ struct DirLight {
 };
 
 struct PointLight {
-    vec3 position;
-    float constant;
-    float linear;
-    float quadratic;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    bool isActive;
+    vec4 positionRadius;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+    vec4 attenuation; // constant, linear, quadratic
 };
 
-#define NR_POINT_LIGHTS 32
-
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
+flat in int MaterialIndex;
+in vec4 ClipPos;
+
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 clusterParams; // x, y map log(view depth) to a slice, z near, w far
+    ivec4 clusterGrid;
+};
 
-uniform vec3 viewPos;
 uniform DirLight dirLight;
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-uniform Material material;
+
+layout (std140, binding = 2) uniform ShadowData
+{
+    mat4 cascadeViewProjection[4];
+    vec4 cascadeSplits; // view depth each cascade ends at
+    vec4 shadowParams;  // x cascade count, y point shadow near plane, z cascade texel size
+};
+
+layout (binding = 8) uniform sampler2DArrayShadow shadowCascades;
+layout (binding = 9) uniform samplerCubeArrayShadow pointShadows;
+Material material;
+
+layout (std430, binding = 2) readonly buffer MaterialTable
+{
+    MaterialEntry materials[];
+};
+
+layout (std430, binding = 4) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
+
+layout (std430, binding = 5) readonly buffer LightClusters
+{
+    uvec2 clusters[]; // offset into lightIndices, light count
+};
+
+layout (std430, binding = 6) readonly buffer LightIndices
+{
+    uint lightIndices[];
+};
+
+layout (std430, binding = 3) readonly buffer TextureTable
+{
+    TextureRef textureRefs[];
+};
+
+#define NR_TEXTURE_ARRAYS 8
+
+layout (binding = 0) uniform sampler2DArray textureArrays[NR_TEXTURE_ARRAYS];
+
+vec3 albedo;
+vec3 specularColour;
 
 vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
+vec4 SampleArray(sampler2DArray textureArray, TextureRef ref, vec2 uv)
+{
+    // Never sample below the first mip the streamer has made resident for this layer
+    float lod = max(textureQueryLod(textureArray, uv).y, ref.minLod);
+    return textureLod(textureArray, vec3(uv, float(ref.layer)), lod);
+}
+
+vec4 SampleMaterialTexture(int handle, vec2 uv, vec4 fallback)
+{
+    if (handle < 0)
+        return fallback;
+
+    TextureRef ref = textureRefs[handle];
+
+    // Sampler arrays need constant indices here, so branch on the slot
+    switch (ref.slot)
+    {
+    case 0: return SampleArray(textureArrays[0], ref, uv);
+    case 1: return SampleArray(textureArrays[1], ref, uv);
+    case 2: return SampleArray(textureArrays[2], ref, uv);
+    case 3: return SampleArray(textureArrays[3], ref, uv);
+    case 4: return SampleArray(textureArrays[4], ref, uv);
+    case 5: return SampleArray(textureArrays[5], ref, uv);
+    case 6: return SampleArray(textureArrays[6], ref, uv);
+    case 7: return SampleArray(textureArrays[7], ref, uv);
+    default: return fallback;
+    }
+}
+
+float CascadeShadow(vec3 normal, vec3 lightDir)
+{
+    // ClipPos.w is the view space depth, pick the first cascade that reaches it
+    int cascadeCount = int(shadowParams.x);
+    int cascade = 0;
+    while (cascade < cascadeCount && ClipPos.w > cascadeSplits[cascade])
+        cascade++;
+
+    if (cascade >= cascadeCount)
+        return 1.0;
+
+    vec4 lightSpace = cascadeViewProjection[cascade] * vec4(FragPos, 1.0);
+    vec3 coords = lightSpace.xyz / lightSpace.w * 0.5 + 0.5;
+    float bias = max(0.002 * (1.0 - dot(normal, lightDir)), 0.0005);
+
+    float shadow = 0.0;
+    for (int y = -1; y <= 1; y++)
+        for (int x = -1; x <= 1; x++)
+            shadow += texture(shadowCascades, vec4(coords.xy + vec2(x, y) * shadowParams.z, float(cascade), coords.z - bias));
+
+    return shadow / 9.0;
+}
+
+float PointShadow(PointLight light, vec3 fragPos)
+{
+    int slot = int(light.attenuation.w);
+    if (slot < 0)
+        return 1.0;
+
+    // Rebuild the depth the cube face stored from the distance along the face's major axis
+    vec3 toFragment = fragPos - light.positionRadius.xyz;
+    vec3 absolute = abs(toFragment);
+    float majorAxis = max(absolute.x, max(absolute.y, absolute.z));
+
+    float near = shadowParams.y;
+    float far = light.positionRadius.w;
+    float depth = ((far + near) / (far - near) - 2.0 * far * near / ((far - near) * majorAxis)) * 0.5 + 0.5;
+
+    return texture(pointShadows, vec4(toFragment, float(slot)), depth - 0.0005);
+}
+
+uint ClusterIndex()
+{
+    vec2 ndc = ClipPos.xy / ClipPos.w;
+    ivec2 tile = clamp(ivec2((ndc * 0.5 + 0.5) * vec2(clusterGrid.xy)), ivec2(0), clusterGrid.xy - 1);
+
+    // ClipPos.w is the view space depth under a perspective projection
+    int slice = clamp(int(floor(log(ClipPos.w) * clusterParams.x - clusterParams.y)), 0, clusterGrid.z - 1);
+
+    return uint(tile.x + clusterGrid.x * (tile.y + clusterGrid.y * slice));
+}
+
 void main()
 {
+    MaterialEntry entry = materials[MaterialIndex];
+    material = Material(entry.specular.rgb, entry.specular.w);
+
+    albedo = SampleMaterialTexture(entry.diffuseTexture, TexCoords, vec4(0.5)).rgb;
+    specularColour = SampleMaterialTexture(entry.specularTexture, TexCoords, vec4(material.specular, 1.0)).rgb;
+
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     
     vec3 result = vec3(0.0);
     
     if(dirLight.isActive)
         result += CalcDirLight(dirLight, norm, viewDir);
     
-    for(int i = 0; i < NR_POINT_LIGHTS; i++)
-        if(pointLights[i].isActive)
-            result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);
+    uvec2 cluster = clusters[ClusterIndex()];
+    for(uint i = 0; i < cluster.y; i++)
+        result += CalcPointLight(pointLights[lightIndices[cluster.x + i]], norm, FragPos, viewDir);
     
     FragColor = vec4(result, 1.0);
 }
@@ -66,32 +215,40 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
     
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * material.specular;
+    vec3 ambient = light.ambient * albedo;
+    vec3 diffuse = light.diffuse * diff * albedo;
+    vec3 specular = light.specular * spec * specularColour;
+    
+    float shadow = CascadeShadow(normal, lightDir);
     
-    return (ambient + diffuse + specular);
+    return ambient + shadow * (diffuse + specular);
 }
 
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 {
-    vec3 lightDir = normalize(light.position - fragPos);
+    vec3 lightDir = normalize(light.positionRadius.xyz - fragPos);
     
     float diff = max(dot(normal, lightDir), 0.0);
     
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
     
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    float distance = length(light.positionRadius.xyz - fragPos);
+    float attenuation = 1.0 / (light.attenuation.x + light.attenuation.y * distance + light.attenuation.z * (distance * distance));
+
+    // Fade to zero at the radius lights were clustered with so tile edges never show
+    float falloff = clamp(1.0 - pow(distance / light.positionRadius.w, 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
     
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * material.specular;
+    vec3 ambient = light.ambient.rgb * albedo;
+    vec3 diffuse = light.diffuse.rgb * diff * albedo;
+    vec3 specular = light.specular.rgb * spec * specularColour;
     
     ambient *= attenuation;
     diffuse *= attenuation;
     specular *= attenuation;
     
-    return (ambient + diffuse + specular);
+    float shadow = PointShadow(light, fragPos);
+    
+    return ambient + shadow * (diffuse + specular);
 }
@@ -1,21 +1,41 @@
-#version 330 core
+#version 430 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in int aMaterialIndex;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+flat out int MaterialIndex;
+out vec4 ClipPos;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 clusterParams; // x, y map log(view depth) to a slice, z near, w far
+    ivec4 clusterGrid;
+};
+
+layout (std140, binding = 1) uniform DrawData
+{
+    mat4 model;
+    mat4 normalMatrix;
+    ivec4 drawInfo;
+};
+
+// Shared with defaultdepth.vert so the depth pre-pass and colour pass produce identical depths
+invariant gl_Position;
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;  
+    Normal = mat3(normalMatrix) * aNormal;
     TexCoords = aTexCoords;
+    MaterialIndex = aMaterialIndex;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
+    ClipPos = gl_Position;
 }
@@ -0,0 +1,32 @@
+#version 430 core
+in vec2 Texcoord;
+
+out vec4 outColor;
+
+// Scene colour at the internal resolution, bilinear filtered up to the output size
+layout(binding = 0) uniform sampler2D sceneColor;
+
+// 0 is the mildest sharpening, 1 the strongest
+uniform float sharpness;
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(sceneColor, 0));
+
+    vec3 centre = texture(sceneColor, Texcoord).rgb;
+    vec3 north = texture(sceneColor, Texcoord + vec2(0.0, texel.y)).rgb;
+    vec3 south = texture(sceneColor, Texcoord - vec2(0.0, texel.y)).rgb;
+    vec3 east = texture(sceneColor, Texcoord + vec2(texel.x, 0.0)).rgb;
+    vec3 west = texture(sceneColor, Texcoord - vec2(texel.x, 0.0)).rgb;
+
+    vec3 minimum = min(centre, min(min(north, south), min(east, west)));
+    vec3 maximum = max(centre, max(max(north, south), max(east, west)));
+
+    // Contrast adaptive, edges that already have contrast get less sharpening so they don't ring
+    vec3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(0.0001)), 0.0, 1.0));
+    vec3 weight = amount * (-1.0 / mix(8.0, 5.0, clamp(sharpness, 0.0, 1.0)));
+
+    vec3 colour = (centre + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+
+    outColor = vec4(clamp(colour, 0.0, 1.0), 1.0);
+}
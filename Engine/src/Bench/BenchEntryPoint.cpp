@@ -0,0 +1,187 @@
+#include "Bench/Include/BenchReport.h"
+#include "Bench/Include/BenchScene.h"
+#include "Core/Events/Include/EventRecorder.h"
+#include "Core/Include/Application.h"
+#include "Core/Include/FramePacer.h"
+#include "Core/Include/FrameStats.h"
+#include "Core/Include/JobSystem.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
+#include "Core/Include/Time.h"
+#include "Rendering/Include/GPUProfiler.h"
+#include "Rendering/Include/MaterialRegistry.h"
+#include "Rendering/Include/RenderTargetManager.h"
+#include "Rendering/Include/TextureStreamer.h"
+#include <cstring>
+#include <iostream>
+
+static void PrintUsage()
+{
+    std::cout << "usage: MoonstoneBench [options]\n"
+                 "  --name <name>             label written into the report\n"
+                 "  --output <path>           report path, defaults to bench.json\n"
+                 "  --frames <n>              measured frames, defaults to 600\n"
+                 "  --warmup <n>              unmeasured frames first, defaults to 60\n"
+                 "  --width <n> --height <n>  scene target size, defaults to 1280x720\n"
+                 "  --cubes <n>               cube count\n"
+                 "  --models <n>              model instance count\n"
+                 "  --lights <n>              point light count\n"
+                 "  --sun                     add a directional light\n"
+                 "  --no-grid                 hide the editor grid\n"
+                 "  --camera <path>           static, orbit or flythrough, defaults to orbit\n"
+                 "  --depth-prepass           enable the depth pre-pass\n"
+                 "  --no-occlusion            disable occlusion culling\n"
+                 "  --dynamic-resolution      enable dynamic resolution\n"
+                 "  --help, -h                show this message\n";
+}
+
+static bool IsHelpRequested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static bool ParseArguments(int argc, char **argv, Moonstone::Bench::BenchConfig &config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        auto number = [&]() { return std::strtoull(argv[++i], nullptr, 10); };
+
+        if (arg == "--name" && hasValue)
+            config.name = argv[++i];
+        else if (arg == "--output" && hasValue)
+            config.outputPath = argv[++i];
+        else if (arg == "--frames" && hasValue)
+            config.frameCount = number();
+        else if (arg == "--warmup" && hasValue)
+            config.warmupFrames = number();
+        else if (arg == "--width" && hasValue)
+            config.width = static_cast<unsigned>(number());
+        else if (arg == "--height" && hasValue)
+            config.height = static_cast<unsigned>(number());
+        else if (arg == "--cubes" && hasValue)
+            config.cubeCount = static_cast<unsigned>(number());
+        else if (arg == "--models" && hasValue)
+            config.modelCount = static_cast<unsigned>(number());
+        else if (arg == "--lights" && hasValue)
+            config.pointLightCount = static_cast<unsigned>(number());
+        else if (arg == "--sun")
+            config.directionalLight = true;
+        else if (arg == "--no-grid")
+            config.gridEnabled = false;
+        else if (arg == "--camera" && hasValue)
+        {
+            if (!Moonstone::Bench::BenchScene::ParseCameraPath(argv[++i], config.cameraPath))
+            {
+                std::cerr << "unknown camera path: " << argv[i] << "\n";
+                return false;
+            }
+        }
+        else if (arg == "--depth-prepass")
+            config.depthPrepass = true;
+        else if (arg == "--no-occlusion")
+            config.occlusionCulling = false;
+        else if (arg == "--dynamic-resolution")
+            config.dynamicResolution = true;
+        else
+        {
+            std::cerr << "unknown or incomplete argument: " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (config.frameCount == 0 || config.width == 0 || config.height == 0)
+    {
+        std::cerr << "frames, width and height must be above zero\n";
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (IsHelpRequested(argc, argv))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    Moonstone::Bench::BenchConfig config;
+    if (!ParseArguments(argc, argv, config))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    Moonstone::Core::Logger::Init();
+    Moonstone::Core::Profiler::Init();
+    Moonstone::Core::MemoryTracker::Init();
+    Moonstone::Core::FrameStats::Init();
+    Moonstone::Core::FramePacer::Init();
+    Moonstone::Core::EventDispatcher::Init();
+    Moonstone::Core::EventQueue::Init();
+    Moonstone::Core::EventRecorder::Init();
+    Moonstone::Core::JobSystem::Init();
+    Moonstone::Rendering::TextureStreamer::Init();
+    Moonstone::Rendering::MaterialRegistry::Init();
+    Moonstone::Rendering::RenderTargetManager::Init();
+    Moonstone::Rendering::GPUProfiler::Init();
+
+    auto app = Moonstone::Core::CreateApplicationInstance();
+    app->InitializeHeadless(config.width, config.height);
+
+    auto scene = app->GetActiveScene();
+    Moonstone::Bench::BenchScene::Build(scene, config);
+
+    auto &gpuProfiler = Moonstone::Rendering::GPUProfiler::GetGPUProfilerInstance();
+
+    Moonstone::Bench::BenchReport report(config);
+    report.SetDevice(Moonstone::Rendering::RenderingCommand::GetDeviceDescription());
+
+    MS_INFO("bench '{0}': {1} warmup and {2} measured frames at {3}x{4}", config.name, config.warmupFrames,
+            config.frameCount, config.width, config.height);
+
+    uint64_t totalFrames = config.warmupFrames + config.frameCount;
+    uint64_t collectedGPUFrames = 0;
+
+    for (uint64_t frame = 0; frame < totalFrames; ++frame)
+    {
+        bool measured = frame >= config.warmupFrames;
+        uint64_t pathFrame = measured ? frame - config.warmupFrames : 0;
+
+        Moonstone::Bench::BenchScene::UpdateCamera(*scene->activeCamera, config, pathFrame);
+
+        uint64_t start = Moonstone::Core::Time::Now();
+        app->RunFrame();
+        uint64_t end = Moonstone::Core::Time::Now();
+
+        // GPU timings are read back a few frames late, so the first samples are from the end of the warmup
+        bool newGPUFrame = gpuProfiler->GetCollectedFrames() != collectedGPUFrames;
+        collectedGPUFrames = gpuProfiler->GetCollectedFrames();
+
+        if (!measured)
+            continue;
+
+        report.AddCPUFrame(static_cast<double>(end - start) / 1000000.0);
+        report.AddRenderStats(Moonstone::Rendering::RenderingCommand::GetStats());
+
+        if (newGPUFrame)
+            report.AddGPUFrame(gpuProfiler->GetFrameTiming().lastMilliseconds);
+    }
+
+    report.SetGPUPasses(gpuProfiler->GetPasses());
+    bool written = report.Write(config.outputPath);
+
+    app->Shutdown();
+
+    return written ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#include "Include/BenchReport.h"
+#include <iomanip>
+#include <thread>
+
+#ifndef MS_GIT_COMMIT
+    #define MS_GIT_COMMIT "unknown"
+#endif
+
+#ifndef MS_BUILD_TYPE
+    #define MS_BUILD_TYPE "unknown"
+#endif
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+BenchReport::BenchReport(const BenchConfig &config) : m_Config(config)
+{
+    m_CPUFrames.reserve(config.frameCount);
+    m_GPUFrames.reserve(config.frameCount);
+}
+
+void BenchReport::AddCPUFrame(double milliseconds)
+{
+    m_CPUFrames.push_back(milliseconds);
+}
+
+void BenchReport::AddGPUFrame(double milliseconds)
+{
+    m_GPUFrames.push_back(milliseconds);
+}
+
+void BenchReport::AddRenderStats(const Rendering::RenderingCommand::Stats &stats)
+{
+    auto add = [](auto &total, auto &max, auto value) {
+        total += value;
+        max = std::max(max, value);
+    };
+
+    add(m_StatsTotal.drawCalls, m_StatsMax.drawCalls, stats.drawCalls);
+    add(m_StatsTotal.indirectDraws, m_StatsMax.indirectDraws, stats.indirectDraws);
+    add(m_StatsTotal.triangles, m_StatsMax.triangles, stats.triangles);
+    add(m_StatsTotal.computeDispatches, m_StatsMax.computeDispatches, stats.computeDispatches);
+    add(m_StatsTotal.programSwitches, m_StatsMax.programSwitches, stats.programSwitches);
+    add(m_StatsTotal.stateChanges, m_StatsMax.stateChanges, stats.stateChanges);
+    add(m_StatsTotal.uniformUploads, m_StatsMax.uniformUploads, stats.uniformUploads);
+    add(m_StatsTotal.bufferUploads, m_StatsMax.bufferUploads, stats.bufferUploads);
+    add(m_StatsTotal.uploadedBytes, m_StatsMax.uploadedBytes, stats.uploadedBytes);
+    add(m_StatsTotal.textureUploads, m_StatsMax.textureUploads, stats.textureUploads);
+    add(m_StatsTotal.bufferBinds, m_StatsMax.bufferBinds, stats.bufferBinds);
+    add(m_StatsTotal.vertexArrayBinds, m_StatsMax.vertexArrayBinds, stats.vertexArrayBinds);
+    add(m_StatsTotal.textureBinds, m_StatsMax.textureBinds, stats.textureBinds);
+    add(m_StatsTotal.framebufferBinds, m_StatsMax.framebufferBinds, stats.framebufferBinds);
+
+    ++m_StatsFrames;
+}
+
+BenchReport::Distribution BenchReport::Summarize(std::vector<double> samples)
+{
+    Distribution distribution;
+    distribution.sampleCount = samples.size();
+
+    if (samples.empty())
+        return distribution;
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank, the same as the frame stats panel
+    auto percentile = [&samples](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+
+    double average = sum / samples.size();
+
+    double variance = 0.0;
+    for (double sample : samples)
+    {
+        variance += (sample - average) * (sample - average);
+    }
+
+    distribution.minMilliseconds = samples.front();
+    distribution.averageMilliseconds = average;
+    distribution.p50Milliseconds = percentile(50.0);
+    distribution.p95Milliseconds = percentile(95.0);
+    distribution.p99Milliseconds = percentile(99.0);
+    distribution.maxMilliseconds = samples.back();
+    distribution.stdDevMilliseconds = std::sqrt(variance / samples.size());
+
+    return distribution;
+}
+
+void BenchReport::WriteDistribution(std::ofstream &file, const Distribution &distribution)
+{
+    file << "{\"samples\": " << distribution.sampleCount << ", \"min\": " << distribution.minMilliseconds
+         << ", \"avg\": " << distribution.averageMilliseconds << ", \"p50\": " << distribution.p50Milliseconds
+         << ", \"p95\": " << distribution.p95Milliseconds << ", \"p99\": " << distribution.p99Milliseconds
+         << ", \"max\": " << distribution.maxMilliseconds << ", \"stddev\": " << distribution.stdDevMilliseconds
+         << "}";
+}
+
+bool BenchReport::Write(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} for the bench report", path);
+        return false;
+    }
+
+    const BenchConfig &config = m_Config;
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"name\": \"" << config.name << "\",\n";
+    file << "  \"commit\": \"" << MS_GIT_COMMIT << "\",\n";
+    file << "  \"buildType\": \"" << MS_BUILD_TYPE << "\",\n";
+    file << "  \"device\": \"" << m_Device << "\",\n";
+    file << "  \"cpuThreads\": " << std::thread::hardware_concurrency() << ",\n";
+
+    file << "  \"config\": {\"width\": " << config.width << ", \"height\": " << config.height
+         << ", \"warmupFrames\": " << config.warmupFrames << ", \"frames\": " << config.frameCount
+         << ", \"cubes\": " << config.cubeCount << ", \"models\": " << config.modelCount
+         << ", \"pointLights\": " << config.pointLightCount
+         << ", \"directionalLight\": " << (config.directionalLight ? "true" : "false")
+         << ", \"grid\": " << (config.gridEnabled ? "true" : "false")
+         << ", \"depthPrepass\": " << (config.depthPrepass ? "true" : "false")
+         << ", \"occlusionCulling\": " << (config.occlusionCulling ? "true" : "false")
+         << ", \"dynamicResolution\": " << (config.dynamicResolution ? "true" : "false") << ", \"camera\": \""
+         << BenchScene::GetCameraPathName(config.cameraPath) << "\"},\n";
+
+    file << "  \"cpuFrameMs\": ";
+    WriteDistribution(file, Summarize(m_CPUFrames));
+    file << ",\n  \"gpuFrameMs\": ";
+    WriteDistribution(file, Summarize(m_GPUFrames));
+
+    file << ",\n  \"gpuPasses\": [";
+    for (size_t i = 0; i < m_GPUPasses.size(); ++i)
+    {
+        const auto &pass = m_GPUPasses[i];
+
+        file << (i == 0 ? "\n    " : ",\n    ");
+        file << "{\"name\": \"" << pass.name << "\", \"depth\": " << pass.depth
+             << ", \"avgMs\": " << pass.averageMilliseconds << ", \"minMs\": " << pass.minMilliseconds
+             << ", \"maxMs\": " << pass.maxMilliseconds << "}";
+    }
+    file << "\n  ],\n";
+
+    // Per frame averages, with the worst frame alongside
+    double frames = static_cast<double>(std::max<uint64_t>(m_StatsFrames, 1));
+    bool first = true;
+
+    file << "  \"renderStats\": {";
+    auto writeStat = [&](const char *name, double total, double max) {
+        file << (first ? "\n    " : ",\n    ");
+        file << "\"" << name << "\": {\"avg\": " << total / frames << ", \"max\": " << max << "}";
+        first = false;
+    };
+
+    writeStat("drawCalls", m_StatsTotal.drawCalls, m_StatsMax.drawCalls);
+    writeStat("indirectDraws", m_StatsTotal.indirectDraws, m_StatsMax.indirectDraws);
+    writeStat("triangles", static_cast<double>(m_StatsTotal.triangles), static_cast<double>(m_StatsMax.triangles));
+    writeStat("computeDispatches", m_StatsTotal.computeDispatches, m_StatsMax.computeDispatches);
+    writeStat("programSwitches", m_StatsTotal.programSwitches, m_StatsMax.programSwitches);
+    writeStat("stateChanges", m_StatsTotal.stateChanges, m_StatsMax.stateChanges);
+    writeStat("uniformUploads", m_StatsTotal.uniformUploads, m_StatsMax.uniformUploads);
+    writeStat("bufferUploads", m_StatsTotal.bufferUploads, m_StatsMax.bufferUploads);
+    writeStat("uploadedBytes", static_cast<double>(m_StatsTotal.uploadedBytes),
+              static_cast<double>(m_StatsMax.uploadedBytes));
+    writeStat("textureUploads", m_StatsTotal.textureUploads, m_StatsMax.textureUploads);
+    writeStat("bufferBinds", m_StatsTotal.bufferBinds, m_StatsMax.bufferBinds);
+    writeStat("vertexArrayBinds", m_StatsTotal.vertexArrayBinds, m_StatsMax.vertexArrayBinds);
+    writeStat("textureBinds", m_StatsTotal.textureBinds, m_StatsMax.textureBinds);
+    writeStat("framebufferBinds", m_StatsTotal.framebufferBinds, m_StatsMax.framebufferBinds);
+
+    file << "\n  }\n}\n";
+
+    MS_INFO("bench report written to {0}", path);
+    return true;
+}
+
+} // namespace Bench
+
+} // namespace Moonstone
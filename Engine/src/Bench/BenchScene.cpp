@@ -0,0 +1,192 @@
+#include "Include/BenchScene.h"
+#include "Rendering/Include/SceneManager.h"
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+void BenchScene::Build(std::shared_ptr<Rendering::Scene> scene, const BenchConfig &config)
+{
+    scene->isGridEnabled = config.gridEnabled;
+    scene->isDepthPrepassEnabled = config.depthPrepass;
+    scene->isOcclusionCullingEnabled = config.occlusionCulling;
+    scene->isDynamicResolutionEnabled = config.dynamicResolution;
+
+    AddCubes(scene, config.cubeCount);
+    AddModels(scene, config.modelCount);
+    AddPointLights(scene, config.pointLightCount);
+
+    if (config.directionalLight)
+    {
+        Rendering::SceneManager sceneManager;
+
+        auto dirLight = Rendering::Lighting::Light("DirLight_0", {0.5f, -1.0f, 0.5f}, {0.1f, 0.1f, 0.1f},
+                                                   {0.5f, 0.5f, 0.5f}, {0.2f, 0.2f, 0.2f}, true);
+        sceneManager.AddLightToScene(scene, dirLight);
+    }
+
+    MS_INFO("bench scene: {0} cubes, {1} models, {2} point lights", config.cubeCount, config.modelCount,
+            config.pointLightCount);
+}
+
+void BenchScene::AddCubes(std::shared_ptr<Rendering::Scene> scene, unsigned count)
+{
+    if (count == 0)
+        return;
+
+    // Every cube shares the first one's buffers, shader and material rather than building its own
+    Rendering::SceneManager sceneManager;
+    sceneManager.AddObjectToScene(scene);
+
+    Rendering::SceneObject cube = scene->objects.back();
+    scene->objects.pop_back();
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    scene->objects.reserve(scene->objects.size() + count);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        int x = static_cast<int>(i) % side;
+        int z = static_cast<int>(i) / side;
+
+        cube.name = "bench_cube_" + std::to_string(i);
+        cube.position = {(x - side / 2) * s_ObjectSpacing, 0.5f, (z - side / 2) * s_ObjectSpacing};
+        cube.rotation = {0.0f, static_cast<float>((i * 37) % 360), 0.0f};
+
+        scene->objects.push_back(cube);
+    }
+}
+
+void BenchScene::AddModels(std::shared_ptr<Rendering::Scene> scene, unsigned count)
+{
+    if (count == 0)
+        return;
+
+    // Loaded once, the instances only differ in transform
+    Rendering::SceneManager sceneManager;
+    sceneManager.AddModelToScene(scene);
+
+    Rendering::Model model = scene->models.back();
+    scene->models.pop_back();
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    float spacing = s_ObjectSpacing * 2.0f;
+    scene->models.reserve(scene->models.size() + count);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        int x = static_cast<int>(i) % side;
+        int z = static_cast<int>(i) / side;
+
+        model.id = "bench_model_" + std::to_string(i);
+        model.position = {(x - side / 2) * spacing, 3.0f, (z - side / 2) * spacing};
+
+        scene->models.push_back(model);
+    }
+}
+
+void BenchScene::AddPointLights(std::shared_ptr<Rendering::Scene> scene, unsigned count)
+{
+    if (count == 0)
+        return;
+
+    Rendering::SceneManager sceneManager;
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        int x = static_cast<int>(i) % side;
+        int z = static_cast<int>(i) / side;
+
+        glm::vec3 position((x - side / 2) * s_ObjectSpacing * 1.5f, 1.5f, (z - side / 2) * s_ObjectSpacing * 1.5f);
+        glm::vec3 colour(static_cast<float>(x) / side, 0.5f, static_cast<float>(z) / side);
+
+        auto ptLight = Rendering::Lighting::Light("PointLight_" + std::to_string(i), position, colour * 0.05f, colour,
+                                                  colour * 0.5f, true, 1.0f, 0.7f, 1.8f);
+
+        sceneManager.AddLightToScene(scene, ptLight);
+    }
+}
+
+void BenchScene::UpdateCamera(Rendering::Camera &camera, const BenchConfig &config, uint64_t frame)
+{
+    float extent = GetExtent(config);
+    float t = config.frameCount > 0 ? static_cast<float>(frame) / static_cast<float>(config.frameCount) : 0.0f;
+
+    glm::vec3 position;
+    glm::vec3 target;
+
+    switch (config.cameraPath)
+    {
+        case CameraPath::Static:
+            position = {0.0f, extent * 0.5f + 5.0f, extent + 10.0f};
+            target = {0.0f, 0.0f, 0.0f};
+            break;
+        case CameraPath::Orbit:
+        {
+            float angle = glm::radians(360.0f * t);
+            float radius = std::min(extent + 10.0f, 80.0f);
+
+            position = {std::sin(angle) * radius, extent * 0.4f + 5.0f, std::cos(angle) * radius};
+            target = {0.0f, 0.0f, 0.0f};
+            break;
+        }
+        case CameraPath::Flythrough:
+        {
+            // Low pass straight through the middle of the scene with a slow sway
+            float z = extent + 10.0f - t * 2.0f * (extent + 10.0f);
+            float sway = std::sin(glm::radians(720.0f * t)) * extent * 0.25f;
+
+            position = {sway, 2.0f, z};
+            target = {sway * 0.5f, 1.5f, z - 10.0f};
+            break;
+        }
+    }
+
+    camera.SetPosition(position);
+    camera.SetFront(glm::normalize(target - position));
+}
+
+float BenchScene::GetExtent(const BenchConfig &config)
+{
+    unsigned largest = std::max({config.cubeCount, config.modelCount * 4, config.pointLightCount * 2, 1u});
+    float side = std::ceil(std::sqrt(static_cast<float>(largest)));
+
+    return side * s_ObjectSpacing * 0.5f;
+}
+
+const char *BenchScene::GetCameraPathName(CameraPath path)
+{
+    switch (path)
+    {
+        case CameraPath::Static:
+            return "static";
+        case CameraPath::Orbit:
+            return "orbit";
+        case CameraPath::Flythrough:
+            return "flythrough";
+    }
+
+    return "unknown";
+}
+
+bool BenchScene::ParseCameraPath(const std::string &name, CameraPath &path)
+{
+    for (CameraPath candidate : {CameraPath::Static, CameraPath::Orbit, CameraPath::Flythrough})
+    {
+        if (name == GetCameraPathName(candidate))
+        {
+            path = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace Bench
+
+} // namespace Moonstone
@@ -0,0 +1,75 @@
+#ifndef BENCHREPORT_H
+#define BENCHREPORT_H
+
+#include "Bench/Include/BenchScene.h"
+#include "Core/Include/Core.h"
+#include "Rendering/Include/GPUProfiler.h"
+#include "Rendering/Include/RenderingCommand.h"
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+// Collects the measured frames of a run and writes them out as one JSON document, along with everything needed to
+// tell whether two runs are comparable: the commit, build type, device and scene config.
+class BenchReport
+{
+  public:
+    struct Distribution
+    {
+        size_t sampleCount = 0;
+
+        double minMilliseconds = 0.0;
+        double averageMilliseconds = 0.0;
+        double p50Milliseconds = 0.0;
+        double p95Milliseconds = 0.0;
+        double p99Milliseconds = 0.0;
+        double maxMilliseconds = 0.0;
+        double stdDevMilliseconds = 0.0;
+    };
+
+    explicit BenchReport(const BenchConfig &config);
+
+    void AddCPUFrame(double milliseconds);
+    void AddGPUFrame(double milliseconds);
+    void AddRenderStats(const Rendering::RenderingCommand::Stats &stats);
+
+    inline void SetDevice(const std::string &device)
+    {
+        m_Device = device;
+    }
+
+    // Rolling averages over the end of the run
+    inline void SetGPUPasses(const std::vector<Rendering::GPUProfiler::PassTiming> &passes)
+    {
+        m_GPUPasses = passes;
+    }
+
+    static Distribution Summarize(std::vector<double> samples);
+
+    bool Write(const std::string &path) const;
+
+  private:
+    static void WriteDistribution(std::ofstream &file, const Distribution &distribution);
+
+  private:
+    BenchConfig m_Config;
+    std::string m_Device;
+
+    std::vector<double> m_CPUFrames;
+    std::vector<double> m_GPUFrames;
+    std::vector<Rendering::GPUProfiler::PassTiming> m_GPUPasses;
+
+    // Summed over every measured frame, and the worst single frame
+    Rendering::RenderingCommand::Stats m_StatsTotal;
+    Rendering::RenderingCommand::Stats m_StatsMax;
+    uint64_t m_StatsFrames = 0;
+};
+
+} // namespace Bench
+
+} // namespace Moonstone
+
+#endif // BENCHREPORT_H
@@ -0,0 +1,72 @@
+#ifndef BENCHSCENE_H
+#define BENCHSCENE_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/Camera.h"
+#include "Rendering/Include/Scene.h"
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+enum class CameraPath
+{
+    Static,
+    Orbit,
+    Flythrough
+};
+
+struct BenchConfig
+{
+    std::string name = "default";
+    std::string outputPath = "bench.json";
+
+    unsigned width = 1280, height = 720;
+    uint64_t warmupFrames = 60;
+    uint64_t frameCount = 600;
+
+    unsigned cubeCount = 0;
+    unsigned modelCount = 0;
+    unsigned pointLightCount = 0;
+    bool directionalLight = false;
+    bool gridEnabled = true;
+
+    bool depthPrepass = false;
+    bool occlusionCulling = true;
+    bool dynamicResolution = false;
+
+    CameraPath cameraPath = CameraPath::Orbit;
+};
+
+// Synthetic scenes laid out on fixed grids, and camera paths driven by frame index rather than elapsed time, so
+// the same config renders the same frames on every machine and commit.
+class BenchScene
+{
+  public:
+    static void Build(std::shared_ptr<Rendering::Scene> scene, const BenchConfig &config);
+
+    // frame counts from the first measured frame, warmup frames hold the path's starting point
+    static void UpdateCamera(Rendering::Camera &camera, const BenchConfig &config, uint64_t frame);
+
+    static const char *GetCameraPathName(CameraPath path);
+    static bool ParseCameraPath(const std::string &name, CameraPath &path);
+
+  private:
+    static void AddCubes(std::shared_ptr<Rendering::Scene> scene, unsigned count);
+    static void AddModels(std::shared_ptr<Rendering::Scene> scene, unsigned count);
+    static void AddPointLights(std::shared_ptr<Rendering::Scene> scene, unsigned count);
+
+    // Half the width of the square every grid is spread over
+    static float GetExtent(const BenchConfig &config);
+
+  private:
+    static constexpr float s_ObjectSpacing = 2.5f;
+};
+
+} // namespace Bench
+
+} // namespace Moonstone
+
+#endif // BENCHSCENE_H
@@ -0,0 +1,133 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include "Core/Include/Core.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Time.h"
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+// Tiny harness for timing single engine routines. Each fixture does its setup and then hands the operation to
+// State::Run, which keeps doubling the batch size until a batch takes long enough to time reliably and reports the
+// last batch. Allocations come from MemoryTracker's counters, so they need MS_ENABLE_MEMORY_TRACKING.
+class MicroBench
+{
+  public:
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations = 0;
+
+        double nanosecondsPerOp = 0.0;
+        double allocationsPerOp = 0.0;
+        double allocatedBytesPerOp = 0.0;
+        double opsPerSecond = 0.0;
+
+        // Ops times items per op, only when the fixture says how many items an op handles
+        double itemsPerSecond = 0.0;
+        uint64_t itemsPerOp = 0;
+    };
+
+    class State
+    {
+      public:
+        explicit State(double minSeconds) : m_MinSeconds(minSeconds)
+        {
+        }
+
+        inline void SetItemsPerOp(uint64_t items)
+        {
+            m_Result.itemsPerOp = items;
+        }
+
+        template <typename Op> void Run(Op &&op)
+        {
+            uint64_t iterations = 1;
+
+            while (true)
+            {
+                uint64_t allocations = Core::MemoryTracker::GetAllocationCount();
+                uint64_t bytes = Core::MemoryTracker::GetAllocatedBytes();
+                uint64_t start = Core::Time::Now();
+
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    op();
+                }
+
+                uint64_t elapsed = Core::Time::Now() - start;
+                double seconds = static_cast<double>(elapsed) / 1000000000.0;
+
+                if (seconds >= m_MinSeconds || iterations >= s_MaxIterations)
+                {
+                    Record(iterations, elapsed, Core::MemoryTracker::GetAllocationCount() - allocations,
+                           Core::MemoryTracker::GetAllocatedBytes() - bytes);
+                    return;
+                }
+
+                // Aim a little past the minimum so the final batch rarely needs another round
+                double scale = seconds > 0.0 ? m_MinSeconds * 1.4 / seconds : 10.0;
+                iterations = std::min(s_MaxIterations,
+                                      std::max(iterations * 2, static_cast<uint64_t>(iterations * scale)));
+            }
+        }
+
+        inline const Result &GetResult() const
+        {
+            return m_Result;
+        }
+
+      private:
+        void Record(uint64_t iterations, uint64_t nanoseconds, uint64_t allocations, uint64_t bytes);
+
+      private:
+        static constexpr uint64_t s_MaxIterations = 1ull << 30;
+
+        double m_MinSeconds;
+        Result m_Result;
+
+        friend class MicroBench;
+    };
+
+    using Fixture = std::function<void(State &)>;
+
+    static void Register(const std::string &name, Fixture fixture);
+
+    // Runs every fixture whose name contains filter, prints a table and optionally writes JSON
+    static int RunAll(const std::string &filter, double minSeconds, const std::string &jsonPath);
+
+    // Keeps the compiler from throwing away work whose result is never used
+    template <typename T> static void DoNotOptimize(const T &value)
+    {
+#ifdef _MSC_VER
+        s_Sink = &value;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+
+  private:
+    static bool WriteJSON(const std::string &path, const std::vector<Result> &results);
+
+  private:
+    struct RegisteredFixture
+    {
+        std::string name;
+        Fixture fixture;
+    };
+
+    static std::vector<RegisteredFixture> &GetFixtures();
+
+    static const volatile void *s_Sink;
+};
+
+} // namespace Bench
+
+} // namespace Moonstone
+
+#endif // MICROBENCH_H
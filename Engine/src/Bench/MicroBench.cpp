@@ -0,0 +1,105 @@
+#include "Include/MicroBench.h"
+#include <iomanip>
+#include <iostream>
+
+namespace Moonstone
+{
+
+namespace Bench
+{
+
+const volatile void *MicroBench::s_Sink = nullptr;
+
+void MicroBench::State::Record(uint64_t iterations, uint64_t nanoseconds, uint64_t allocations, uint64_t bytes)
+{
+    double ops = static_cast<double>(iterations);
+
+    m_Result.iterations = iterations;
+    m_Result.nanosecondsPerOp = static_cast<double>(nanoseconds) / ops;
+    m_Result.allocationsPerOp = static_cast<double>(allocations) / ops;
+    m_Result.allocatedBytesPerOp = static_cast<double>(bytes) / ops;
+    m_Result.opsPerSecond = nanoseconds > 0 ? ops * 1000000000.0 / static_cast<double>(nanoseconds) : 0.0;
+    m_Result.itemsPerSecond = m_Result.opsPerSecond * static_cast<double>(m_Result.itemsPerOp);
+}
+
+std::vector<MicroBench::RegisteredFixture> &MicroBench::GetFixtures()
+{
+    static std::vector<RegisteredFixture> fixtures;
+    return fixtures;
+}
+
+void MicroBench::Register(const std::string &name, Fixture fixture)
+{
+    GetFixtures().push_back({name, std::move(fixture)});
+}
+
+int MicroBench::RunAll(const std::string &filter, double minSeconds, const std::string &jsonPath)
+{
+    std::vector<Result> results;
+
+    if (!Core::MemoryTracker::IsTrackingAllocations())
+        std::cout << "heap tracking is compiled out, allocation columns read zero\n";
+
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "ns/op"
+              << std::setw(12) << "allocs/op" << std::setw(14) << "bytes/op" << std::setw(16) << "items/s" << "\n";
+
+    for (auto &registered : GetFixtures())
+    {
+        if (!filter.empty() && registered.name.find(filter) == std::string::npos)
+            continue;
+
+        State state(minSeconds);
+        registered.fixture(state);
+
+        Result result = state.GetResult();
+        result.name = registered.name;
+        results.push_back(result);
+
+        std::cout << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << result.nanosecondsPerOp << std::setw(12) << result.allocationsPerOp
+                  << std::setw(14) << result.allocatedBytesPerOp << std::setw(16) << std::setprecision(0)
+                  << result.itemsPerSecond << "\n";
+    }
+
+    if (results.empty())
+    {
+        std::cerr << "no benchmarks match '" << filter << "'\n";
+        return 1;
+    }
+
+    if (!jsonPath.empty() && !WriteJSON(jsonPath, results))
+        return 1;
+
+    return 0;
+}
+
+bool MicroBench::WriteJSON(const std::string &path, const std::vector<Result> &results)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "failed to open " << path << " for the micro benchmark results\n";
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &result = results[i];
+
+        file << (i == 0 ? "\n  " : ",\n  ");
+        file << "{\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+             << ", \"nsPerOp\": " << result.nanosecondsPerOp << ", \"allocsPerOp\": " << result.allocationsPerOp
+             << ", \"bytesPerOp\": " << result.allocatedBytesPerOp << ", \"opsPerSecond\": " << result.opsPerSecond
+             << ", \"itemsPerOp\": " << result.itemsPerOp << ", \"itemsPerSecond\": " << result.itemsPerSecond << "}";
+    }
+
+    file << "\n]}\n";
+    return true;
+}
+
+} // namespace Bench
+
+} // namespace Moonstone
@@ -0,0 +1,344 @@
+#include "Bench/Include/MicroBench.h"
+#include "Core/Events/Include/EventQueue.h"
+#include "Core/Events/Include/InputEvents.h"
+#include "Core/Include/LayerStack.h"
+#include "Rendering/Include/MaterialRegistry.h"
+#include "Rendering/Include/Model.h"
+#include "Rendering/Include/Renderer.h"
+#include <iostream>
+
+using Moonstone::Bench::MicroBench;
+
+static std::vector<Moonstone::Rendering::SceneObject> MakeObjects(size_t count)
+{
+    std::vector<Moonstone::Rendering::SceneObject> objects(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        float f = static_cast<float>(i);
+        objects[i].position = {f * 0.5f, std::fmod(f, 7.0f), -f * 0.25f};
+        objects[i].rotation = {std::fmod(f * 13.0f, 360.0f), std::fmod(f * 37.0f, 360.0f), std::fmod(f * 7.0f, 360.0f)};
+        objects[i].scale = {1.0f + std::fmod(f, 3.0f), 1.0f, 1.0f + std::fmod(f, 2.0f)};
+    }
+
+    return objects;
+}
+
+// The model matrix each visible object builds every frame in Renderer::RenderVisibleObjects
+static void TransformModelMatrix(MicroBench::State &state)
+{
+    auto objects = MakeObjects(1024);
+    state.SetItemsPerOp(objects.size());
+
+    state.Run([&]() {
+        for (const auto &object : objects)
+        {
+            glm::mat4 model = Moonstone::Rendering::Renderer::GetTransformationMatrix(object);
+            MicroBench::DoNotOptimize(model);
+        }
+    });
+}
+
+// The model matrix plus the normal matrix Renderer::PushDrawData derives from it
+static void TransformModelAndNormalMatrix(MicroBench::State &state)
+{
+    auto objects = MakeObjects(1024);
+    state.SetItemsPerOp(objects.size());
+
+    state.Run([&]() {
+        for (const auto &object : objects)
+        {
+            glm::mat4 model = Moonstone::Rendering::Renderer::GetTransformationMatrix(object);
+            glm::mat4 normalMatrix = glm::transpose(glm::inverse(model));
+            MicroBench::DoNotOptimize(model);
+            MicroBench::DoNotOptimize(normalMatrix);
+        }
+    });
+}
+
+// Takes the same arguments as RenderingCommand's setters, so names are converted exactly as they are when drawing and
+// only the GL call is left out
+struct NullUniforms
+{
+    static void SetUniformVec3(const unsigned &ID, const std::string &name, glm::vec3 value)
+    {
+        MicroBench::DoNotOptimize(ID);
+        MicroBench::DoNotOptimize(name);
+        MicroBench::DoNotOptimize(value);
+    }
+
+    static void SetUniformBool(const unsigned &ID, const std::string &name, bool value)
+    {
+        MicroBench::DoNotOptimize(ID);
+        MicroBench::DoNotOptimize(name);
+        MicroBench::DoNotOptimize(value);
+    }
+};
+
+// Renderer::SetLightUniforms over a scene's worth of lights, reported per uniform set. Point lights are walked past
+// as they are when drawing but set nothing, they come from the cluster buffers
+static void LightingUniformNames(MicroBench::State &state)
+{
+    using Light = Moonstone::Rendering::Lighting::Light;
+    using Moonstone::Rendering::Renderer;
+
+    std::vector<Light> lights;
+    lights.emplace_back("DirLight_0", glm::vec3(0.5f, -1.0f, 0.5f), glm::vec3(0.1f), glm::vec3(0.5f), glm::vec3(0.2f),
+                        true);
+
+    for (int i = 0; i < 31; ++i)
+    {
+        lights.emplace_back("PointLight_" + std::to_string(i), glm::vec3(static_cast<float>(i), 0.5f, 0.0f),
+                            glm::vec3(0.05f), glm::vec3(1.0f), glm::vec3(0.5f), true, 1.0f, 0.7f, 1.8f);
+    }
+
+    unsigned shaderID = 1;
+    state.SetItemsPerOp(Renderer::SetLightUniforms<NullUniforms>(shaderID, lights));
+
+    state.Run([&]() {
+        unsigned uniformCount = Renderer::SetLightUniforms<NullUniforms>(shaderID, lights);
+        MicroBench::DoNotOptimize(uniformCount);
+    });
+}
+
+static void EventsDispatch(MicroBench::State &state)
+{
+    Moonstone::Core::EventDispatcher dispatcher;
+
+    int handled = 0;
+    dispatcher.Subscribe<Moonstone::Core::KeyPressEvent>(
+        [&handled](const Moonstone::Core::Event &) { ++handled; });
+
+    Moonstone::Core::KeyPressEvent event(87, 1, 0);
+    state.SetItemsPerOp(1);
+
+    state.Run([&]() { dispatcher.Dispatch(event); });
+
+    MicroBench::DoNotOptimize(handled);
+}
+
+// A burst of key events through the queue, enqueued by value the way Window's GLFW callbacks do it
+static void EventsQueueProcess(MicroBench::State &state)
+{
+    auto &dispatcher = Moonstone::Core::EventDispatcher::GetEventDispatcherInstance();
+
+    int handled = 0;
+    auto subscription = dispatcher->Subscribe<Moonstone::Core::KeyPressEvent>(
+        [&handled](const Moonstone::Core::Event &) { ++handled; });
+
+    Moonstone::Core::EventQueue queue;
+
+    constexpr int eventsPerOp = 256;
+    state.SetItemsPerOp(eventsPerOp);
+
+    state.Run([&]() {
+        for (int i = 0; i < eventsPerOp; ++i)
+        {
+            queue.Enqueue(Moonstone::Core::KeyPressEvent(87, 1, 0));
+        }
+
+        queue.Process();
+    });
+
+    dispatcher->Unsubscribe(subscription);
+    MicroBench::DoNotOptimize(handled);
+}
+
+// A frame of mouse moves from a high polling rate mouse, coalesced down to one dispatch and one batch
+static void EventsQueueCoalesce(MicroBench::State &state)
+{
+    auto &dispatcher = Moonstone::Core::EventDispatcher::GetEventDispatcherInstance();
+
+    int handled = 0;
+    size_t batched = 0;
+    auto subscription = dispatcher->Subscribe<Moonstone::Core::MouseMoveEvent>(
+        [&handled](const Moonstone::Core::Event &) { ++handled; });
+    auto batchSubscription = dispatcher->SubscribeBatch<Moonstone::Core::MouseMoveEvent>(
+        [&batched](const Moonstone::Core::EventBatch &batch) { batched += batch.Size(); });
+
+    Moonstone::Core::EventQueue queue;
+    queue.SetCoalescing<Moonstone::Core::MouseMoveEvent, Moonstone::Core::CoalescePolicy::KeepLatest>();
+
+    constexpr int eventsPerOp = 256;
+    state.SetItemsPerOp(eventsPerOp);
+
+    state.Run([&]() {
+        for (int i = 0; i < eventsPerOp; ++i)
+        {
+            queue.Enqueue(Moonstone::Core::MouseMoveEvent(i, i));
+        }
+
+        queue.Process();
+    });
+
+    dispatcher->Unsubscribe(subscription);
+    dispatcher->Unsubscribe(batchSubscription);
+    MicroBench::DoNotOptimize(handled);
+    MicroBench::DoNotOptimize(batched);
+}
+
+// A 64x64 quad grid with every attribute Model::ProcessMesh reads, and one material without textures
+static void ModelProcessMesh(MicroBench::State &state)
+{
+    constexpr unsigned quads = 64;
+    constexpr unsigned side = quads + 1;
+
+    auto *mesh = new aiMesh();
+    mesh->mNumVertices = side * side;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    mesh->mTangents = new aiVector3D[mesh->mNumVertices];
+    mesh->mBitangents = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+
+    for (unsigned z = 0; z < side; ++z)
+    {
+        for (unsigned x = 0; x < side; ++x)
+        {
+            unsigned i = z * side + x;
+            mesh->mVertices[i] = aiVector3D(static_cast<float>(x), 0.0f, static_cast<float>(z));
+            mesh->mNormals[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+            mesh->mTangents[i] = aiVector3D(1.0f, 0.0f, 0.0f);
+            mesh->mBitangents[i] = aiVector3D(0.0f, 0.0f, 1.0f);
+            mesh->mTextureCoords[0][i] = aiVector3D(static_cast<float>(x) / quads, static_cast<float>(z) / quads, 0.0f);
+        }
+    }
+
+    mesh->mNumFaces = quads * quads * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+
+    for (unsigned z = 0; z < quads; ++z)
+    {
+        for (unsigned x = 0; x < quads; ++x)
+        {
+            unsigned corner = z * side + x;
+            unsigned corners[2][3] = {{corner, corner + side, corner + 1}, {corner + 1, corner + side, corner + side + 1}};
+
+            for (unsigned t = 0; t < 2; ++t)
+            {
+                aiFace &face = mesh->mFaces[(z * quads + x) * 2 + t];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned[3]{corners[t][0], corners[t][1], corners[t][2]};
+            }
+        }
+    }
+
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh *[1] {mesh};
+    scene.mNumMaterials = 1;
+    scene.mMaterials = new aiMaterial *[1] {new aiMaterial()};
+
+    // The material registers on the first call and is looked up after that, as for every mesh after a model's first
+    Moonstone::Rendering::Model model;
+    state.SetItemsPerOp(mesh->mNumVertices);
+
+    state.Run([&]() {
+        auto processed = model.ProcessMesh(mesh, &scene);
+        MicroBench::DoNotOptimize(processed);
+    });
+}
+
+class EmptyLayer : public Moonstone::Core::Layer
+{
+  public:
+    void OnUpdate() override
+    {
+        ++m_Updates;
+    }
+
+  private:
+    uint64_t m_Updates = 0;
+};
+
+// By value, the way EditorUI::Render walks the stack, which copies every shared_ptr
+static void LayerStackIterateByValue(MicroBench::State &state)
+{
+    Moonstone::Core::LayerStack layerStack;
+    for (int i = 0; i < 16; ++i)
+    {
+        layerStack.PushLayer(std::make_shared<EmptyLayer>());
+    }
+
+    state.SetItemsPerOp(16);
+
+    state.Run([&]() {
+        for (auto layer : layerStack)
+        {
+            layer->OnUpdate();
+        }
+    });
+}
+
+static void LayerStackIterateByReference(MicroBench::State &state)
+{
+    Moonstone::Core::LayerStack layerStack;
+    for (int i = 0; i < 16; ++i)
+    {
+        layerStack.PushLayer(std::make_shared<EmptyLayer>());
+    }
+
+    state.SetItemsPerOp(16);
+
+    state.Run([&]() {
+        for (auto &layer : layerStack)
+        {
+            layer->OnUpdate();
+        }
+    });
+}
+
+static void PrintUsage()
+{
+    std::cout << "usage: MoonstoneMicroBench [options]\n"
+                 "  --filter <text>      only run benchmarks whose name contains text\n"
+                 "  --min-time <ms>      shortest timed batch per benchmark, defaults to 250\n"
+                 "  --json <path>        also write the results as JSON\n"
+                 "  --help, -h           show this message\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::string filter, jsonPath;
+    double minMilliseconds = 250.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            minMilliseconds = std::strtod(argv[++i], nullptr);
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Moonstone::Core::Logger::Init();
+    Moonstone::Core::MemoryTracker::Init();
+    Moonstone::Core::EventDispatcher::Init();
+    Moonstone::Rendering::MaterialRegistry::Init();
+
+    MicroBench::Register("Transform/ModelMatrix", TransformModelMatrix);
+    MicroBench::Register("Transform/ModelAndNormalMatrix", TransformModelAndNormalMatrix);
+    MicroBench::Register("Lighting/UniformNames", LightingUniformNames);
+    MicroBench::Register("Events/Dispatch", EventsDispatch);
+    MicroBench::Register("Events/QueueProcess", EventsQueueProcess);
+    MicroBench::Register("Events/QueueCoalesce", EventsQueueCoalesce);
+    MicroBench::Register("Model/ProcessMesh", ModelProcessMesh);
+    MicroBench::Register("LayerStack/IterateByValue", LayerStackIterateByValue);
+    MicroBench::Register("LayerStack/IterateByReference", LayerStackIterateByReference);
+
+    return MicroBench::RunAll(filter, minMilliseconds / 1000.0, jsonPath);
+}
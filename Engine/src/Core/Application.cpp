@@ -1,4 +1,11 @@
 #include "Include/Application.h"
+#include "Core/Events/Include/EventRecorder.h"
+#include "Core/Include/FramePacer.h"
+#include "Core/Include/FrameStats.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
+#include "Rendering/Include/GPUProfiler.h"
+#include "Rendering/Include/RenderTargetManager.h"
 #include "mspch.h"
 #include <exception>
 #include <memory>
@@ -31,6 +38,7 @@ void Application::InitializeEditor()
     Rendering::SceneManager sceneManager;
     m_SceneManager = sceneManager;
     auto currentScene = m_SceneManager.LoadDefaultScene();
+    m_ActiveScene = currentScene;
     m_SceneRenderer = sceneManager.InitializeSceneRenderer(currentScene);
     m_SceneRenderer->SetWindow(m_Window);
     m_SceneRenderer->InitializeActiveCamera();
@@ -42,28 +50,137 @@ void Application::InitializeEditor()
     m_EditorUI->Init();
 }
 
+void Application::InitializeHeadless(unsigned width, unsigned height)
+{
+    m_Window = std::shared_ptr<Window>(Window::CreateWindow(WindowProperties("Moonstone", width, height, true)));
+
+    // Scenes
+    Rendering::SceneManager sceneManager;
+    m_SceneManager = sceneManager;
+    auto currentScene = m_SceneManager.LoadDefaultScene();
+    m_ActiveScene = currentScene;
+    m_SceneRenderer = sceneManager.InitializeSceneRenderer(currentScene);
+    m_SceneRenderer->SetWindow(m_Window);
+    m_SceneRenderer->InitializeActiveCamera();
+    m_SceneRenderer->InitializeFramebuffer();
+}
+
 void Application::Run()
 {
     m_Running = true;
 
+    while (RunFrame())
+    {
+    }
+
+    Shutdown();
+}
+
+bool Application::RunFrame()
+{
+    MS_PROFILE_FRAME();
+    MS_PROFILE_SCOPE("Application::Run");
+
+    auto &recorder = EventRecorder::GetEventRecorderInstance();
+    auto &pacer = FramePacer::GetFramePacerInstance();
     Time &time = Time::GetInstance();
 
-    while (m_Running)
+    // Replays always pace as active so recorded focus changes don't slow them down
+    FramePacer::State paceState = FramePacer::State::Active;
+
+    if (!m_Window->IsHeadless() && !recorder->IsReplaying())
+    {
+        if (m_Window->IsVSync() != pacer->GetVSync())
+            m_Window->SetVSync(pacer->GetVSync());
+
+        if (m_Window->IsMinimized() && pacer->IsIdleThrottling())
+        {
+            // Nothing to see, so nothing is rendered until the window comes back or is closed
+            Window::WaitForEvents(m_Window, pacer->GetMinimizedWaitSeconds());
+
+            // The first frame back gets a normal delta rather than the whole time spent minimized
+            time.ResetFrameStart();
+
+            if (glfwWindowShouldClose(m_Window->m_Window))
+                m_Running = false;
+
+            return m_Running;
+        }
+
+        if (!m_Window->IsFocused())
+            paceState = FramePacer::State::Unfocused;
+    }
+
+    pacer->WaitForNextFrame(paceState);
+
+    Rendering::RenderingCommand::ResetStats();
+
+    time.Update();
+
+    // The first delta covers all of startup rather than a frame
+    if (!m_FirstFrame)
+    {
+        FrameStats::GetFrameStatsInstance()->AddFrame(time.GetDeltaTime() * 1000.0f);
+    }
+    m_FirstFrame = false;
+
+    // Replays step by a fixed amount so recorded input moves things exactly as far every run
+    if (recorder->IsReplaying())
+        time.SetDeltaTime(recorder->GetFixedDeltaTime());
+
+    // Simulation runs in fixed steps however fast frames are rendered, the camera is drawn between the last two
+    unsigned fixedSteps = time.AccumulateFixedSteps();
+    for (unsigned i = 0; i < fixedSteps; ++i)
     {
-        float currentFrame = glfwGetTime();
-        time.Update(currentFrame);
+        m_Window->FixedUpdate(time.GetFixedDeltaTime());
+    }
 
-        m_SceneRenderer->RenderScene();
+    if (auto camera = m_Window->GetCamera())
+        camera->SetInterpolation(time.GetInterpolationAlpha());
 
+    auto &gpuProfiler = Rendering::GPUProfiler::GetGPUProfilerInstance();
+    gpuProfiler->BeginFrame();
+
+    m_SceneRenderer->RenderScene();
+
+    if (m_EditorUI)
         m_EditorUI->Render();
 
-        Window::UpdateWindow(m_Window);
+    gpuProfiler->EndFrame();
+
+    Window::UpdateWindow(m_Window);
+
+    MemoryTracker::GetMemoryTrackerInstance()->EndFrame();
+
+    ++m_FrameCount;
+
+    if (glfwWindowShouldClose(m_Window->m_Window) || (m_FrameLimit != 0 && m_FrameCount >= m_FrameLimit))
+        m_Running = false;
 
-        if (glfwWindowShouldClose(m_Window->m_Window))
-            m_Running = false;
+    if (recorder->IsReplayFinished())
+    {
+        auto summary = FrameStats::GetFrameStatsInstance()->EndRun();
+        MS_INFO("replay finished after {0} frames: avg {1:.2f}ms, p50 {2:.2f}ms, p95 {3:.2f}ms, p99 {4:.2f}ms",
+                recorder->GetFrame(), summary.averageMilliseconds, summary.p50Milliseconds, summary.p95Milliseconds,
+                summary.p99Milliseconds);
+        m_Running = false;
     }
 
+    return m_Running;
+}
+
+void Application::Shutdown()
+{
+    EventRecorder::GetEventRecorderInstance()->Stop();
     m_SceneRenderer->CleanupScene();
+
+    // GPU resources go before the window terminates GLFW, static destructors run without a context
+    m_SceneRenderer.reset();
+    Rendering::RenderTargetManager::Shutdown();
+    Rendering::GPUProfiler::Shutdown();
+
+    // Anything still tracked now outlives the context, the tracker is certain to be alive to say so here
+    MemoryTracker::GetMemoryTrackerInstance()->ReportLiveGPUResources();
 }
 
 std::unique_ptr<Application> CreateApplicationInstance()
@@ -1,6 +1,9 @@
 #include "Include/EditorUI.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
 #include "Include/Logger.h"
 #include "Layers/Include/BaseLayers.h"
+#include "Rendering/Include/GPUProfiler.h"
 #include "Rendering/Include/Lighting.h"
 #include "Rendering/Include/Renderer.h"
 #include "Rendering/Include/SceneManager.h"
@@ -27,8 +30,8 @@ void EditorUI::Init()
 
     auto sceneLayer = std::make_shared<SceneLayer>();
     sceneLayer->SetWindow(m_Window->m_Window);
-    sceneLayer->SetTexMap(m_FBOTextureMap);
-    sceneLayer->SetFBParams(m_FBShaderID, m_ScreenQuadVAO, m_FBOTextureMap);
+    sceneLayer->SetSceneTarget(m_SceneTarget);
+    sceneLayer->SetFBParams(m_FBShaderID, m_ScreenQuadVAO);
     PushLayer(sceneLayer);
 
     auto menuLayer = std::make_shared<MenuLayer>();
@@ -37,6 +40,9 @@ void EditorUI::Init()
     auto debugLayer = std::make_shared<DebugLayer>();
     PushLayer(debugLayer);
 
+    auto profilerLayer = std::make_shared<ProfilerLayer>();
+    PushLayer(profilerLayer);
+
     auto transformLayer = std::make_shared<TransformLayer>();
     auto entityLayer = std::make_shared<EntityLayer>();
     entityLayer->SetWindow(m_Window->m_Window);
@@ -116,6 +122,21 @@ void EditorUI::Init()
             entityLayer->SetObjectVector(m_ActiveScene->objects);
         });
 
+    transformLayer->SetSliderCallbackObj(
+        TransformLayer::SliderID::ObjectMaterialGroup, [this, entityLayer](Rendering::SceneObject &object) {
+            auto it = std::find_if(m_ActiveScene->objects.begin(), m_ActiveScene->objects.end(),
+                                   [&object](Rendering::SceneObject &obj) { return obj.name == object.name; });
+
+            if (it != m_ActiveScene->objects.end())
+            {
+                it->material = object.material;
+                Rendering::MaterialRegistry::GetMaterialRegistryInstance()->UpdateMaterial(it->materialIndex,
+                                                                                           it->material);
+            }
+
+            entityLayer->SetObjectVector(m_ActiveScene->objects);
+        });
+
     transformLayer->SetSliderCallbackLight(
         TransformLayer::SliderID::LightTransformGroup, [this, entityLayer](Rendering::Lighting::Light &light) {
             auto it = std::find_if(m_ActiveScene->lights.begin(), m_ActiveScene->lights.end(),
@@ -177,6 +198,24 @@ void EditorUI::Init()
         m_Window->SetCameraSens(controlsLayer->GetCamSensitivity());
     });
 
+    controlsLayer->SetBtnCallback(ControlsLayer::ButtonID::ToggleDepthPrepass, [this]() {
+        m_ActiveScene->isDepthPrepassEnabled = !m_ActiveScene->isDepthPrepassEnabled;
+
+        MS_DEBUG("depth pre-pass toggled: {0}", m_ActiveScene->isDepthPrepassEnabled);
+    });
+
+    controlsLayer->SetBtnCallback(ControlsLayer::ButtonID::ToggleOcclusionCulling, [this]() {
+        m_ActiveScene->isOcclusionCullingEnabled = !m_ActiveScene->isOcclusionCullingEnabled;
+
+        MS_DEBUG("occlusion culling toggled: {0}", m_ActiveScene->isOcclusionCullingEnabled);
+    });
+
+    controlsLayer->SetBtnCallback(ControlsLayer::ButtonID::ToggleDynamicResolution, [this]() {
+        m_ActiveScene->isDynamicResolutionEnabled = !m_ActiveScene->isDynamicResolutionEnabled;
+
+        MS_DEBUG("dynamic resolution toggled: {0}", m_ActiveScene->isDynamicResolutionEnabled);
+    });
+
     controlsLayer->SetBtnCallback(ControlsLayer::ButtonID::ToggleGrid, [this]() {
         {
             m_ActiveScene->isGridEnabled = !m_ActiveScene->isGridEnabled;
@@ -294,6 +333,32 @@ void EditorUI::Init()
         transformLayer->SetSelectedLight(m_ActiveScene->lights.back());
     });
 
+    // Stress case for clustered lighting, a 32x32 grid of small coloured lights over the ground plane
+    controlsLayer->SetBtnCallback(ControlsLayer::ButtonID::AddPointLightGrid, [this, entityLayer]() {
+        Rendering::SceneManager sceneManager;
+
+        constexpr int gridSize = 32;
+        constexpr float spacing = 1.5f;
+
+        for (int z = 0; z < gridSize; ++z)
+        {
+            for (int x = 0; x < gridSize; ++x)
+            {
+                std::stringstream ss;
+                ss << "PointLight_" << m_ActiveScene->lights.size();
+
+                glm::vec3 position((x - gridSize / 2) * spacing, 0.5f, (z - gridSize / 2) * spacing);
+                glm::vec3 colour(static_cast<float>(x) / gridSize, 0.5f, static_cast<float>(z) / gridSize);
+
+                auto ptLight = Rendering::Lighting::Light(ss.str(), position, colour * 0.05f, colour, colour * 0.5f,
+                                                          true, 1.0f, 0.7f, 1.8f);
+
+                sceneManager.AddLightToScene(m_ActiveScene, ptLight);
+                entityLayer->AddLight(m_ActiveScene->lights.back());
+            }
+        }
+    });
+
     m_Layers.push_back(*controlsLayer);
     PushLayer(controlsLayer);
 }
@@ -305,11 +370,16 @@ void EditorUI::Shutdown()
 
 void EditorUI::Render()
 {
+    MS_PROFILE_FUNCTION();
+    MS_MEMORY_TAG(UI);
+
     for (auto layer : m_LayerStack)
     {
         layer->OnUpdate();
     }
 
+    Rendering::GPUProfiler::Scope gpuScope("ImGui");
+
     m_ImGuiLayer->Start();
     for (auto layer : m_LayerStack)
     {
@@ -1,14 +1,88 @@
+#include "Core/Events/Include/EventRecorder.h"
 #include "Core/Include/Application.h"
+#include "Core/Include/FramePacer.h"
+#include "Core/Include/FrameStats.h"
+#include "Core/Include/JobSystem.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
+#include "Rendering/Include/GPUProfiler.h"
+#include "Rendering/Include/MaterialRegistry.h"
+#include "Rendering/Include/RenderTargetManager.h"
+#include "Rendering/Include/TextureStreamer.h"
+#include <cstring>
 
-int main()
+int main(int argc, char **argv)
 {
+    // --headless renders offscreen without the editor, --frames stops after that many frames
+    // --record saves the session's input, --replay plays a saved session back at a fixed timestep and then exits
+    // --fps caps the frame rate, --no-vsync presents as soon as a frame is ready
+    bool headless = false;
+    bool vsync = true;
+    uint64_t frameLimit = 0;
+    float targetFPS = 0.0f;
+    std::string recordPath, replayPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frameLimit = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            targetFPS = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--no-vsync") == 0)
+            vsync = false;
+    }
+
     Moonstone::Core::Logger::Init();
+    Moonstone::Core::Profiler::Init();
+    Moonstone::Core::MemoryTracker::Init();
+    Moonstone::Core::FrameStats::Init();
+    Moonstone::Core::FramePacer::Init();
+    Moonstone::Core::FramePacer::GetFramePacerInstance()->SetTargetFPS(targetFPS);
+    Moonstone::Core::FramePacer::GetFramePacerInstance()->SetVSync(vsync);
     Moonstone::Core::EventDispatcher::Init();
     Moonstone::Core::EventQueue::Init();
+    Moonstone::Core::EventRecorder::Init();
+    Moonstone::Core::JobSystem::Init();
+    Moonstone::Rendering::TextureStreamer::Init();
+    Moonstone::Rendering::MaterialRegistry::Init();
+    Moonstone::Rendering::RenderTargetManager::Init();
+    Moonstone::Rendering::GPUProfiler::Init();
 
     MS_INFO("application initialised successfully");
 
     auto app = Moonstone::Core::CreateApplicationInstance();
-    app->InitializeEditor();
+
+    if (headless)
+    {
+        // Nothing can close a headless window, so it always stops on its own
+        app->InitializeHeadless();
+        app->SetFrameLimit(frameLimit != 0 ? frameLimit : 1000);
+    }
+    else
+    {
+        app->InitializeEditor();
+        app->SetFrameLimit(frameLimit);
+    }
+
+    auto &recorder = Moonstone::Core::EventRecorder::GetEventRecorderInstance();
+    if (!replayPath.empty())
+    {
+        if (!recorder->StartReplay(replayPath))
+            return 1;
+
+        // The replay's summary covers every frame, not just the stats window
+        Moonstone::Core::FrameStats::GetFrameStatsInstance()->BeginRun(recorder->GetFrameCount());
+    }
+    else if (!recordPath.empty())
+    {
+        recorder->StartRecording(recordPath);
+    }
+
     app->Run();
 }
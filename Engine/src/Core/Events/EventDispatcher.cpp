@@ -7,11 +7,136 @@ namespace Core
 
 std::shared_ptr<EventDispatcher> EventDispatcher::s_EventDispatcher;
 
+namespace
+{
+
+template <typename Table, typename Pending>
+void AddSubscriber(Table &table, Pending &pending, bool deferred, EventType eventType,
+                   const typename Table::value_type::value_type &subscriber)
+{
+    if (deferred)
+    {
+        pending.push_back({eventType, subscriber});
+    }
+    else
+    {
+        table[static_cast<size_t>(eventType)].push_back(subscriber);
+    }
+}
+
+// Either drops the subscriber or, mid dispatch, marks it for the next compaction. False if it isn't in the list
+template <typename List>
+bool RemoveSubscriber(List &subscribers, uint32_t id, bool deferred)
+{
+    auto it = std::find_if(subscribers.begin(), subscribers.end(),
+                           [id](const auto &subscriber) { return subscriber.id == id; });
+
+    if (it == subscribers.end())
+        return false;
+
+    if (deferred)
+    {
+        it->id = 0;
+    }
+    else
+    {
+        subscribers.erase(it);
+    }
+
+    return true;
+}
+
+template <typename Pending>
+bool RemovePending(Pending &pending, uint32_t id)
+{
+    auto it = std::find_if(pending.begin(), pending.end(),
+                           [id](const auto &entry) { return entry.subscriber.id == id; });
+
+    if (it == pending.end())
+        return false;
+
+    pending.erase(it);
+    return true;
+}
+
+template <typename Table, typename Pending>
+void ApplyChanges(Table &table, Pending &pending)
+{
+    for (auto &subscribers : table)
+    {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                         [](const auto &subscriber) { return subscriber.id == 0; }),
+                          subscribers.end());
+    }
+
+    for (const auto &entry : pending)
+    {
+        table[static_cast<size_t>(entry.type)].push_back(entry.subscriber);
+    }
+
+    pending.clear();
+}
+
+} // namespace
+
 void EventDispatcher::Init()
 {
     s_EventDispatcher = std::make_shared<EventDispatcher>();
     MS_INFO("event dispatcher initialised");
 }
 
+SubscriptionHandle EventDispatcher::Subscribe(EventType eventType, Callback callback)
+{
+    MS_LOUD_DEBUG("subscribing {0}", GetEventTypeName(eventType));
+
+    uint32_t id = m_NextSubscriptionId++;
+    AddSubscriber(m_Subscribers, m_PendingSubscribers, m_DispatchDepth > 0, eventType, {id, callback});
+    m_HasDeferredChanges |= m_DispatchDepth > 0;
+
+    return SubscriptionHandle(eventType, id);
+}
+
+SubscriptionHandle EventDispatcher::SubscribeBatch(EventType eventType, BatchCallback callback)
+{
+    MS_LOUD_DEBUG("subscribing {0} in batches", GetEventTypeName(eventType));
+
+    uint32_t id = m_NextSubscriptionId++;
+    AddSubscriber(m_BatchSubscribers, m_PendingBatchSubscribers, m_DispatchDepth > 0, eventType, {id, callback});
+    m_HasDeferredChanges |= m_DispatchDepth > 0;
+
+    return SubscriptionHandle(eventType, id);
+}
+
+void EventDispatcher::Unsubscribe(SubscriptionHandle &handle)
+{
+    if (!handle.IsValid())
+        return;
+
+    MS_LOUD_DEBUG("unsubscribing {0}", GetEventTypeName(handle.m_Type));
+
+    size_t index = static_cast<size_t>(handle.m_Type);
+    bool deferred = m_DispatchDepth > 0;
+
+    bool removed = RemoveSubscriber(m_Subscribers[index], handle.m_Id, deferred)
+                   || RemoveSubscriber(m_BatchSubscribers[index], handle.m_Id, deferred)
+                   || RemovePending(m_PendingSubscribers, handle.m_Id)
+                   || RemovePending(m_PendingBatchSubscribers, handle.m_Id);
+
+    if (!removed)
+        MS_WARN("unsubscribing {0} subscription {1} that is not subscribed", GetEventTypeName(handle.m_Type),
+                handle.m_Id);
+
+    m_HasDeferredChanges |= deferred;
+    handle = SubscriptionHandle();
+}
+
+void EventDispatcher::ApplyDeferredChanges()
+{
+    ApplyChanges(m_Subscribers, m_PendingSubscribers);
+    ApplyChanges(m_BatchSubscribers, m_PendingBatchSubscribers);
+
+    m_HasDeferredChanges = false;
+}
+
 } // namespace Core
 } // namespace Moonstone
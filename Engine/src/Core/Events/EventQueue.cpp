@@ -1,4 +1,5 @@
 #include "Core/Events/Include/EventQueue.h"
+#include "Core/Events/Include/EventRecorder.h"
 
 namespace Moonstone
 {
@@ -14,6 +15,139 @@ void EventQueue::Init()
     MS_INFO("event queue initialised");
 }
 
+EventQueue::EventQueue()
+    : m_Ring(s_InitialCapacity)
+{
+    m_Dispatcher = EventDispatcher::GetEventDispatcherInstance();
+    m_Replayed.reserve(s_InitialCapacity);
+}
+
+bool EventQueue::ShouldEnqueue(const Event &event)
+{
+    return m_Recorder->OnEnqueue(event);
+}
+
+EventRecord &EventQueue::PushSlot()
+{
+    if (m_Count == m_Ring.size())
+        Grow();
+
+    // Capacity is always a power of two
+    EventRecord &slot = m_Ring[(m_Head + m_Count) & (m_Ring.size() - 1)];
+    ++m_Count;
+
+    return slot;
+}
+
+void EventQueue::Grow()
+{
+    std::vector<EventRecord> ring(m_Ring.size() * 2);
+
+    for (size_t i = 0; i < m_Count; ++i)
+    {
+        ring[i] = m_Ring[(m_Head + i) & (m_Ring.size() - 1)];
+    }
+
+    m_Ring.swap(ring);
+    m_Head = 0;
+
+    MS_WARN("event queue grew to {0} events", m_Ring.size());
+}
+
+void EventQueue::DrainPosted()
+{
+    m_PostedLastFrame = 0;
+
+    EventRecord record;
+    while (m_Posted.TryPop(record))
+    {
+        ++m_PostedLastFrame;
+
+        if (m_Recorder && !ShouldEnqueue(record.Get()))
+            continue;
+
+        PushSlot() = record;
+    }
+
+    // Logged here rather than where it happened so a flood of posts can't also flood the log from every thread
+    uint64_t dropped = m_Posted.TakeDroppedCount();
+    if (dropped > 0)
+    {
+        m_DroppedPosts += dropped;
+        MS_WARN("{0} events posted from other threads were dropped, the posted queue was full", dropped);
+    }
+}
+
+void EventQueue::Process()
+{
+    MS_PROFILE_FUNCTION();
+
+    DrainPosted();
+
+    if (m_Recorder)
+    {
+        m_Recorder->OnProcess(m_Replayed);
+
+        for (const auto &record : m_Replayed)
+        {
+            PushSlot() = record;
+        }
+
+        m_Replayed.clear();
+    }
+
+    // Each event is copied out before dispatch, handlers can then queue more events, even enough to grow the ring,
+    // without invalidating the one they were handed
+    EventRecord current;
+
+    while (m_Count > 0)
+    {
+        PopFront(current);
+        EventType type  = current.Get().GetEventType();
+        size_t    index = static_cast<size_t>(type);
+
+        if (CoalesceFunction coalesce = m_Coalescing[index])
+        {
+            while (m_Count > 0 && m_Ring[m_Head].Get().GetEventType() == type)
+            {
+                coalesce(current.Get(), m_Ring[m_Head].Get());
+                DropFront();
+            }
+        }
+
+        m_Dispatcher->Dispatch(current.Get());
+
+        if (m_Dispatcher->HasBatchSubscribers(type))
+        {
+            m_Batches[index].push_back(current);
+        }
+    }
+
+    for (size_t index = 0; index < m_Batches.size(); ++index)
+    {
+        std::vector<EventRecord> &batch = m_Batches[index];
+        if (batch.empty())
+            continue;
+
+        m_Dispatcher->DispatchBatch(static_cast<EventType>(index), EventBatch(batch.data(), batch.size()));
+        batch.clear();
+    }
+}
+
+void EventQueue::PopFront(EventRecord &record)
+{
+    record = m_Ring[m_Head];
+    DropFront();
+}
+
+void EventQueue::DropFront()
+{
+    m_Ring[m_Head].Reset();
+
+    m_Head = (m_Head + 1) & (m_Ring.size() - 1);
+    --m_Count;
+}
+
 } // namespace Core
 
 } // namespace Moonstone
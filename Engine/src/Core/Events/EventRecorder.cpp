@@ -0,0 +1,347 @@
+#include "Core/Events/Include/EventRecorder.h"
+#include "Core/Events/Include/EventQueue.h"
+#include "Core/Events/Include/InputEvents.h"
+#include "Core/Events/Include/WindowEvents.h"
+#include "Core/Include/Time.h"
+#include <cstring>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<EventRecorder> EventRecorder::s_EventRecorder;
+
+void EventRecorder::Init()
+{
+    s_EventRecorder = std::make_shared<EventRecorder>();
+    EventQueue::GetEventQueueInstance()->SetRecorder(s_EventRecorder);
+
+    MS_INFO("event recorder initialised");
+}
+
+bool EventRecorder::StartRecording(const std::string &path)
+{
+    if (m_Mode != Mode::Idle)
+    {
+        MS_WARN("event recorder is already busy, not recording to {0}", path);
+        return false;
+    }
+
+    m_Mode = Mode::Recording;
+    m_Path = path;
+    m_Frame = 0;
+    m_Events.clear();
+    m_StartNanoseconds = Time::Now();
+
+    MS_INFO("recording input to {0}", path);
+    return true;
+}
+
+bool EventRecorder::StartReplay(const std::string &path, float fixedDeltaTime)
+{
+    if (m_Mode != Mode::Idle)
+    {
+        MS_WARN("event recorder is already busy, not replaying {0}", path);
+        return false;
+    }
+
+    if (!ReadFile(path))
+        return false;
+
+    if (fixedDeltaTime > 0.0f)
+        m_FixedDeltaTime = fixedDeltaTime;
+
+    m_Mode = Mode::Replaying;
+    m_Path = path;
+    m_Frame = 0;
+    m_NextEvent = 0;
+
+    MS_INFO("replaying {0}: {1} events over {2} frames at {3:.3f}ms a frame", path, m_Events.size(), m_FrameCount,
+            m_FixedDeltaTime * 1000.0f);
+    return true;
+}
+
+void EventRecorder::Stop()
+{
+    if (m_Mode == Mode::Recording)
+    {
+        m_FrameCount = m_Frame;
+
+        // Replays step at the average rate the session was recorded at
+        double seconds = static_cast<double>(Time::Now() - m_StartNanoseconds) / 1000000000.0;
+        m_FixedDeltaTime = m_FrameCount > 0 ? static_cast<float>(seconds / m_FrameCount) : 0.0f;
+
+        WriteFile();
+    }
+    else if (m_Mode == Mode::Replaying)
+    {
+        MS_INFO("replay of {0} stopped on frame {1} of {2}", m_Path, m_Frame, m_FrameCount);
+    }
+
+    m_Mode = Mode::Idle;
+}
+
+bool EventRecorder::OnEnqueue(const Event &event)
+{
+    if (m_Mode == Mode::Idle)
+        return true;
+
+    RecordedEvent recorded;
+    bool recordable = Encode(event, recorded);
+
+    // Anything that would be recorded is exactly what a replay stands in for
+    if (m_Mode == Mode::Replaying)
+        return !recordable;
+
+    if (recordable)
+    {
+        recorded.frame = static_cast<uint32_t>(m_Frame);
+        m_Events.push_back(recorded);
+    }
+
+    return true;
+}
+
+void EventRecorder::OnProcess(std::vector<EventRecord> &replayed)
+{
+    if (m_Mode == Mode::Replaying)
+    {
+        while (m_NextEvent < m_Events.size() && m_Events[m_NextEvent].frame <= m_Frame)
+        {
+            Decode(m_Events[m_NextEvent], replayed.emplace_back());
+            ++m_NextEvent;
+        }
+    }
+
+    if (m_Mode != Mode::Idle)
+        ++m_Frame;
+}
+
+bool EventRecorder::Encode(const Event &event, RecordedEvent &recorded)
+{
+    recorded = {};
+
+    switch (event.GetEventType())
+    {
+        case EventType::KeyPress:
+        {
+            auto &keyEvent = static_cast<const KeyPressEvent &>(event);
+            recorded.type = RecordedType::KeyPress;
+            recorded.values[0] = keyEvent.GetKeyCode();
+            recorded.values[1] = keyEvent.GetAction();
+            recorded.values[2] = keyEvent.GetMods();
+            return true;
+        }
+        case EventType::MouseButtonPress:
+        {
+            auto &buttonEvent = static_cast<const MouseButtonPressEvent &>(event);
+            recorded.type = RecordedType::MouseButtonPress;
+            recorded.values[0] = buttonEvent.GetButton();
+            recorded.values[1] = buttonEvent.GetAction();
+            recorded.values[2] = buttonEvent.GetMods();
+            return true;
+        }
+        case EventType::MouseScroll:
+        {
+            auto &scrollEvent = static_cast<const MouseScrollEvent &>(event);
+            recorded.type = RecordedType::MouseScroll;
+            recorded.values[0] = scrollEvent.GetXOffset();
+            recorded.values[1] = scrollEvent.GetYOffset();
+            return true;
+        }
+        case EventType::MouseMove:
+        {
+            auto &moveEvent = static_cast<const MouseMoveEvent &>(event);
+            recorded.type = RecordedType::MouseMove;
+            recorded.positions[0] = moveEvent.GetXPosition();
+            recorded.positions[1] = moveEvent.GetYPosition();
+            return true;
+        }
+        case EventType::WindowResize:
+        {
+            auto &resizeEvent = static_cast<const WindowResizeEvent &>(event);
+            recorded.type = RecordedType::WindowResize;
+            recorded.values[0] = resizeEvent.GetWidth();
+            recorded.values[1] = resizeEvent.GetHeight();
+            return true;
+        }
+        case EventType::WindowMinimize:
+            recorded.type = RecordedType::WindowMinimize;
+            recorded.values[0] = static_cast<const WindowMinimizeEvent &>(event).IsMinimized();
+            return true;
+        case EventType::WindowFocus:
+            recorded.type = RecordedType::WindowFocus;
+            recorded.values[0] = static_cast<const WindowFocusEvent &>(event).IsFocused();
+            return true;
+        default:
+            // Closing the window always ends the session rather than being part of it, and anything posted from
+            // another thread depends on timing a replay can't reproduce
+            return false;
+    }
+}
+
+void EventRecorder::Decode(const RecordedEvent &recorded, EventRecord &record)
+{
+    const int32_t *values = recorded.values;
+
+    switch (recorded.type)
+    {
+        case RecordedType::KeyPress:
+            record.Store(KeyPressEvent(values[0], values[1], values[2]));
+            break;
+        case RecordedType::MouseButtonPress:
+            record.Store(MouseButtonPressEvent(values[0], values[1], values[2]));
+            break;
+        case RecordedType::MouseScroll:
+            record.Store(MouseScrollEvent(values[0], values[1]));
+            break;
+        case RecordedType::MouseMove:
+            record.Store(MouseMoveEvent(recorded.positions[0], recorded.positions[1]));
+            break;
+        case RecordedType::WindowResize:
+            record.Store(WindowResizeEvent(values[0], values[1]));
+            break;
+        case RecordedType::WindowMinimize:
+            record.Store(WindowMinimizeEvent(values[0]));
+            break;
+        case RecordedType::WindowFocus:
+            record.Store(WindowFocusEvent(values[0]));
+            break;
+    }
+}
+
+bool EventRecorder::WriteFile() const
+{
+    std::ofstream file(m_Path, std::ios::binary);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} to save the input recording", m_Path);
+        return false;
+    }
+
+    uint64_t eventCount = m_Events.size();
+
+    file.write(s_Magic, sizeof(s_Magic));
+    file.write(reinterpret_cast<const char *>(&s_Version), sizeof(s_Version));
+    file.write(reinterpret_cast<const char *>(&m_FixedDeltaTime), sizeof(m_FixedDeltaTime));
+    file.write(reinterpret_cast<const char *>(&m_FrameCount), sizeof(m_FrameCount));
+    file.write(reinterpret_cast<const char *>(&eventCount), sizeof(eventCount));
+
+    // Only the payload each type needs, most of a session is mouse moves so this roughly halves the file
+    for (const auto &recorded : m_Events)
+    {
+        file.write(reinterpret_cast<const char *>(&recorded.frame), sizeof(recorded.frame));
+        file.write(reinterpret_cast<const char *>(&recorded.type), sizeof(recorded.type));
+
+        switch (recorded.type)
+        {
+            case RecordedType::MouseMove:
+                file.write(reinterpret_cast<const char *>(recorded.positions), sizeof(recorded.positions));
+                break;
+            case RecordedType::KeyPress:
+            case RecordedType::MouseButtonPress:
+                file.write(reinterpret_cast<const char *>(recorded.values), sizeof(int32_t) * 3);
+                break;
+            case RecordedType::MouseScroll:
+            case RecordedType::WindowResize:
+                file.write(reinterpret_cast<const char *>(recorded.values), sizeof(int32_t) * 2);
+                break;
+            case RecordedType::WindowMinimize:
+            case RecordedType::WindowFocus:
+                file.write(reinterpret_cast<const char *>(recorded.values), sizeof(int32_t));
+                break;
+        }
+    }
+
+    MS_INFO("input recording of {0} events over {1} frames saved to {2}", eventCount, m_FrameCount, m_Path);
+    return file.good();
+}
+
+bool EventRecorder::ReadFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open input recording {0}", path);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t eventCount = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&m_FixedDeltaTime), sizeof(m_FixedDeltaTime));
+    file.read(reinterpret_cast<char *>(&m_FrameCount), sizeof(m_FrameCount));
+    file.read(reinterpret_cast<char *>(&eventCount), sizeof(eventCount));
+
+    if (!file || std::memcmp(magic, s_Magic, sizeof(magic)) != 0 || version != s_Version)
+    {
+        MS_ERROR("{0} is not a version {1} input recording", path, s_Version);
+        return false;
+    }
+
+    // The header's count is only trusted as far as the rest of the file could hold that many of the smallest records
+    std::streamoff headerEnd = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t remainingBytes = static_cast<uint64_t>(file.tellg() - headerEnd);
+    file.seekg(headerEnd);
+
+    constexpr uint64_t minimumRecordBytes = sizeof(uint32_t) + sizeof(RecordedType) + sizeof(int32_t);
+    if (eventCount > remainingBytes / minimumRecordBytes)
+    {
+        MS_ERROR("input recording {0} claims {1} events but is only {2} bytes long", path, eventCount,
+                 remainingBytes);
+        return false;
+    }
+
+    m_Events.clear();
+    m_Events.reserve(eventCount);
+
+    for (uint64_t i = 0; i < eventCount; ++i)
+    {
+        RecordedEvent recorded = {};
+
+        file.read(reinterpret_cast<char *>(&recorded.frame), sizeof(recorded.frame));
+        file.read(reinterpret_cast<char *>(&recorded.type), sizeof(recorded.type));
+
+        switch (recorded.type)
+        {
+            case RecordedType::MouseMove:
+                file.read(reinterpret_cast<char *>(recorded.positions), sizeof(recorded.positions));
+                break;
+            case RecordedType::KeyPress:
+            case RecordedType::MouseButtonPress:
+                file.read(reinterpret_cast<char *>(recorded.values), sizeof(int32_t) * 3);
+                break;
+            case RecordedType::MouseScroll:
+            case RecordedType::WindowResize:
+                file.read(reinterpret_cast<char *>(recorded.values), sizeof(int32_t) * 2);
+                break;
+            case RecordedType::WindowMinimize:
+            case RecordedType::WindowFocus:
+                file.read(reinterpret_cast<char *>(recorded.values), sizeof(int32_t));
+                break;
+            default:
+                MS_ERROR("input recording {0} has an unknown event type at event {1}", path, i);
+                return false;
+        }
+
+        if (!file)
+        {
+            MS_ERROR("input recording {0} ends after {1} of {2} events", path, i, eventCount);
+            return false;
+        }
+
+        m_Events.push_back(recorded);
+    }
+
+    return true;
+}
+
+} // namespace Core
+
+} // namespace Moonstone
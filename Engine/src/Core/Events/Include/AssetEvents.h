@@ -0,0 +1,45 @@
+#ifndef ASSETEVENTS_H
+#define ASSETEVENTS_H
+
+#include "Core/Events/Include/Event.h"
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Posted from the texture streamer's worker once a decode finishes, its mips are uploaded on a later streamer update
+class TextureLoadedEvent : public Event
+{
+    public:
+        static constexpr EventType s_Type = EventType::TextureLoaded;
+
+        TextureLoadedEvent(unsigned handle, bool success, int width, int height, int firstLevel)
+            : Event(s_Type)
+            , m_Handle(handle)
+            , m_Success(success)
+            , m_Width(width)
+            , m_Height(height)
+            , m_FirstLevel(firstLevel)
+        {
+        }
+
+        inline unsigned GetHandle() const { return m_Handle; }
+        inline bool     IsSuccess() const { return m_Success; }
+        inline int      GetWidth() const { return m_Width; }
+        inline int      GetHeight() const { return m_Height; }
+        inline int      GetFirstLevel() const { return m_FirstLevel; }
+
+    private:
+        unsigned m_Handle;
+        bool     m_Success;
+        int      m_Width, m_Height;
+        int      m_FirstLevel;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // ASSETEVENTS_H
@@ -0,0 +1,121 @@
+#ifndef CONCURRENTEVENTQUEUE_H
+#define CONCURRENTEVENTQUEUE_H
+
+#include "Core/Events/Include/EventRecord.h"
+#include <atomic>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Bounded lock free queue that any number of threads can post events to and one thread drains, after Dmitry Vyukov's
+// bounded MPMC queue. Every cell carries a sequence number saying whose turn it is, producers claim a cell with one
+// compare and swap on the tail and publish it by bumping its sequence, so a producer never waits on the consumer or
+// on another producer that is midway through writing.
+//
+// Posting fails rather than blocks when the queue is full, the caller decides whether the event can be dropped.
+class ConcurrentEventQueue
+{
+    public:
+        explicit ConcurrentEventQueue(size_t capacity)
+            : m_Cells(capacity)
+            , m_Mask(capacity - 1)
+        {
+            MS_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0,
+                      "concurrent event queue capacity must be a power of two");
+
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ConcurrentEventQueue(const ConcurrentEventQueue&)            = delete;
+        ConcurrentEventQueue& operator=(const ConcurrentEventQueue&) = delete;
+
+        // Safe from any thread
+        template <typename T>
+        bool TryPush(const T& event)
+        {
+            size_t position = m_Tail.load(std::memory_order_relaxed);
+            Cell*  cell;
+
+            while (true)
+            {
+                cell              = &m_Cells[position & m_Mask];
+                size_t   sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t distance = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (distance == 0)
+                {
+                    if (m_Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (distance < 0)
+                {
+                    // The consumer hasn't freed this cell from the last lap yet
+                    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    position = m_Tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->record.Store(event);
+            cell->sequence.store(position + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // Only from the consuming thread
+        bool TryPop(EventRecord& record)
+        {
+            Cell&  cell     = m_Cells[m_Head & m_Mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+            // Claimed but not yet published counts as empty, it is picked up next drain
+            if (sequence != m_Head + 1)
+                return false;
+
+            record = cell.record;
+            cell.record.Reset();
+
+            // Hands the cell to the producer one lap ahead
+            cell.sequence.store(m_Head + m_Mask + 1, std::memory_order_release);
+            ++m_Head;
+
+            return true;
+        }
+
+        inline size_t GetCapacity() const { return m_Cells.size(); }
+
+        // Posts turned away because the queue was full, since the last call
+        inline uint64_t TakeDroppedCount() { return m_Dropped.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            EventRecord         record;
+        };
+
+        // Producers and the consumer each hammer their own end, keep them off each other's cache line
+        static constexpr size_t s_CacheLineSize = 64;
+
+        std::vector<Cell> m_Cells;
+        const size_t      m_Mask;
+
+        alignas(s_CacheLineSize) std::atomic<size_t>   m_Tail    = 0;
+        alignas(s_CacheLineSize) size_t                m_Head    = 0;
+        alignas(s_CacheLineSize) std::atomic<uint64_t> m_Dropped = 0;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // CONCURRENTEVENTQUEUE_H
@@ -9,14 +9,70 @@ namespace Moonstone
 namespace Core
 {
 
+// Dense ids for every event type, the dispatcher and queue index flat tables with them. A new event type gets an
+// entry here and a name in GetEventTypeName()
+enum class EventType : uint16_t
+{
+    WindowClose,
+    WindowResize,
+    WindowMinimize,
+    WindowFocus,
+    KeyPress,
+    MouseButtonPress,
+    MouseScroll,
+    MouseMove,
+    TextureLoaded,
+    Count
+};
+
+constexpr size_t s_EventTypeCount = static_cast<size_t>(EventType::Count);
+
+inline const char* GetEventTypeName(EventType type)
+{
+    switch (type)
+    {
+        case EventType::WindowClose:
+            return "WindowClose";
+        case EventType::WindowResize:
+            return "WindowResize";
+        case EventType::WindowMinimize:
+            return "WindowMinimize";
+        case EventType::WindowFocus:
+            return "WindowFocus";
+        case EventType::KeyPress:
+            return "KeyPress";
+        case EventType::MouseButtonPress:
+            return "MouseButtonPress";
+        case EventType::MouseScroll:
+            return "MouseScroll";
+        case EventType::MouseMove:
+            return "MouseMove";
+        case EventType::TextureLoaded:
+            return "TextureLoaded";
+        default:
+            return "Unknown";
+    }
+}
+
+// Every event carries its type id, so finding its subscribers is a load rather than a virtual call. Subclasses
+// declare theirs as a static s_Type and hand it to this constructor
 class Event
 {
     public:
         virtual ~Event() = default;
 
-        virtual std::type_index GetEventType() const = 0;
+        inline EventType GetEventType() const { return m_Type; }
 
         static std::size_t HashId(const std::string& name) { return std::hash<std::string>{}(name); }
+
+    protected:
+        explicit Event(EventType type)
+            : m_Type(type)
+        {
+        }
+
+    private:
+        EventType m_Type;
 };
 
 } // namespace Core
@@ -0,0 +1,58 @@
+#ifndef EVENTCALLBACK_H
+#define EVENTCALLBACK_H
+
+#include "Core/Include/Core.h"
+#include <new>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Callable wrapper for event handlers that never allocates. The handler is stored inline and called through a single
+// function pointer, there is no virtual call and nothing to free.
+//
+// Handlers must be small and trivially copyable, a lambda capturing this, a few pointers or references, or plain
+// values. Anything bigger, or owning memory like a captured std::string, is rejected at compile time - capture a
+// pointer to it instead.
+template <typename Argument>
+class EventCallback
+{
+    public:
+        static constexpr size_t s_Capacity = 4 * sizeof(void*);
+
+        EventCallback() = default;
+
+        template <typename Function,
+                  typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, EventCallback>>>
+        EventCallback(Function function)
+        {
+            static_assert(sizeof(Function) <= s_Capacity,
+                          "event callback captures too much to be stored inline, capture a pointer instead");
+            static_assert(alignof(Function) <= alignof(std::max_align_t), "event callback is over-aligned");
+            static_assert(std::is_trivially_copy_constructible_v<Function>
+                              && std::is_trivially_destructible_v<Function>,
+                          "event callbacks can only capture pointers, references and plain values");
+
+            new (m_Storage) Function(function);
+            m_Invoke = [](const void* storage, Argument argument)
+            { (*static_cast<const Function*>(storage))(argument); };
+        }
+
+        inline void operator()(Argument argument) const { m_Invoke(m_Storage, argument); }
+
+        inline explicit operator bool() const { return m_Invoke != nullptr; }
+
+    private:
+        using InvokeFunction = void (*)(const void* storage, Argument argument);
+
+        alignas(std::max_align_t) unsigned char m_Storage[s_Capacity] = {};
+        InvokeFunction                          m_Invoke              = nullptr;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // EVENTCALLBACK_H
@@ -1,7 +1,8 @@
 #ifndef EVENTDISPATCHER_H
 #define EVENTDISPATCHER_H
 
-#include "Core/Events/Include/Event.h"
+#include "Core/Events/Include/EventCallback.h"
+#include "Core/Events/Include/EventRecord.h"
 #include "Core/Include/Logger.h"
 
 namespace Moonstone
@@ -10,6 +11,59 @@ namespace Moonstone
 namespace Core
 {
 
+// A frame's worth of events of one type, in the order they were processed. Only valid during the callback
+class EventBatch
+{
+    public:
+        EventBatch(const EventRecord* records, size_t count)
+            : m_Records(records)
+            , m_Count(count)
+        {
+        }
+
+        inline size_t             Size() const { return m_Count; }
+        inline bool               IsEmpty() const { return m_Count == 0; }
+        inline const EventRecord* begin() const { return m_Records; }
+        inline const EventRecord* end() const { return m_Records + m_Count; }
+
+        template <typename T>
+        inline const T& Get(size_t index) const
+        {
+            return static_cast<const T&>(m_Records[index].Get());
+        }
+
+    private:
+        const EventRecord* m_Records;
+        size_t             m_Count;
+};
+
+// Identifies one subscription so it can be removed on its own. Default constructed handles subscribe to nothing
+class SubscriptionHandle
+{
+    public:
+        SubscriptionHandle() = default;
+
+        inline bool      IsValid() const { return m_Id != 0; }
+        inline EventType GetEventType() const { return m_Type; }
+
+    private:
+        friend class EventDispatcher;
+
+        SubscriptionHandle(EventType type, uint32_t id)
+            : m_Type(type)
+            , m_Id(id)
+        {
+        }
+
+        EventType m_Type = EventType::Count;
+        uint32_t  m_Id   = 0;
+};
+
+// Subscribers live in a flat table indexed by event type id, dispatching an event is an index, a walk over a small
+// array and one indirect call per subscriber.
+//
+// Handlers may subscribe and unsubscribe while an event is being dispatched. Those changes are held back until the
+// outermost dispatch returns, so the lists being walked never move and new subscribers don't see the event in flight.
 class EventDispatcher
 {
     public:
@@ -23,36 +77,94 @@ class EventDispatcher
             return s_EventDispatcher;
         }
 
-        using Callback = std::function<void(std::shared_ptr<Event>)>;
+        using Callback      = EventCallback<const Event&>;
+        using BatchCallback = EventCallback<const EventBatch&>;
 
-        void Subscribe(const std::type_index& eventType, Callback callback)
+        SubscriptionHandle Subscribe(EventType eventType, Callback callback);
+
+        template <typename T>
+        inline SubscriptionHandle Subscribe(Callback callback)
+        {
+            return Subscribe(T::s_Type, callback);
+        }
+
+        // Called once per processed frame with every event of the type that frame, after any per event callbacks
+        SubscriptionHandle SubscribeBatch(EventType eventType, BatchCallback callback);
+
+        template <typename T>
+        inline SubscriptionHandle SubscribeBatch(BatchCallback callback)
         {
-            MS_LOUD_DEBUG("subscribing {0}", eventType.name());
-            m_Subscribers[eventType].push_back(std::move(callback));
+            return SubscribeBatch(T::s_Type, callback);
         }
 
-        void Unsubscribe(const std::type_index& eventType)
+        // Removes just this subscription and clears the handle
+        void Unsubscribe(SubscriptionHandle& handle);
+
+        inline bool HasBatchSubscribers(EventType eventType) const
         {
-            MS_LOUD_DEBUG("unsubscribing {0}", eventType.name());
-            m_Subscribers.erase(eventType);
+            return !m_BatchSubscribers[static_cast<size_t>(eventType)].empty();
         }
 
-        void Dispatch(std::shared_ptr<Event> event) const
+        void Dispatch(const Event& event)
         {
-            auto it = m_Subscribers.find(event->GetEventType());
+            ++m_DispatchDepth;
 
-            if (it != m_Subscribers.end())
+            for (const auto& subscriber : m_Subscribers[static_cast<size_t>(event.GetEventType())])
             {
-                for (const auto& callback : it->second)
-                {
-                    callback(event);
-                }
+                if (subscriber.id != 0)
+                    subscriber.callback(event);
             }
+
+            if (--m_DispatchDepth == 0 && m_HasDeferredChanges)
+                ApplyDeferredChanges();
+        }
+
+        void DispatchBatch(EventType eventType, const EventBatch& batch)
+        {
+            ++m_DispatchDepth;
+
+            for (const auto& subscriber : m_BatchSubscribers[static_cast<size_t>(eventType)])
+            {
+                if (subscriber.id != 0)
+                    subscriber.callback(batch);
+            }
+
+            if (--m_DispatchDepth == 0 && m_HasDeferredChanges)
+                ApplyDeferredChanges();
         }
 
     private:
-        static std::shared_ptr<EventDispatcher>                    s_EventDispatcher;
-        std::unordered_map<std::type_index, std::vector<Callback>> m_Subscribers;
+        template <typename CallbackType>
+        struct Subscriber
+        {
+            // 0 once unsubscribed mid dispatch, until the list is compacted
+            uint32_t     id;
+            CallbackType callback;
+        };
+
+        template <typename CallbackType>
+        struct PendingSubscriber
+        {
+            EventType                type;
+            Subscriber<CallbackType> subscriber;
+        };
+
+        template <typename CallbackType>
+        using SubscriberTable = std::array<std::vector<Subscriber<CallbackType>>, s_EventTypeCount>;
+
+        void ApplyDeferredChanges();
+
+    private:
+        static std::shared_ptr<EventDispatcher> s_EventDispatcher;
+
+        SubscriberTable<Callback>      m_Subscribers;
+        SubscriberTable<BatchCallback> m_BatchSubscribers;
+        uint32_t                       m_NextSubscriptionId = 1;
+
+        unsigned                                      m_DispatchDepth      = 0;
+        bool                                          m_HasDeferredChanges = false;
+        std::vector<PendingSubscriber<Callback>>      m_PendingSubscribers;
+        std::vector<PendingSubscriber<BatchCallback>> m_PendingBatchSubscribers;
 };
 
 } // namespace Core
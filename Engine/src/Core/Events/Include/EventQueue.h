@@ -1,7 +1,10 @@
 #ifndef EVENTQUEUE_H
 #define EVENTQUEUE_H
 
+#include "Core/Events/Include/ConcurrentEventQueue.h"
 #include "Core/Events/Include/EventDispatcher.h"
+#include "Core/Events/Include/EventRecord.h"
+#include "Core/Include/Profiler.h"
 
 namespace Moonstone
 {
@@ -9,10 +12,28 @@ namespace Moonstone
 namespace Core
 {
 
+class EventRecorder;
+
+enum class CoalescePolicy
+{
+    // Only the newest of a run survives, for absolute state like a cursor position or a window size
+    KeepLatest,
+    // A run folds into one event through T::Accumulate, for relative deltas like scrolling
+    Sum
+};
+
+// Events are copied by value into a ring of records allocated up front, so a frame of input costs no allocations.
+// The ring only grows, doubling, if a single frame queues more than it holds, and keeps that size afterwards.
+//
+// Everything but Post() belongs to the main thread. Other threads post into a lock free queue that is drained into the
+// ring at the start of each Process(), after the window's own events for the frame.
+//
+// Coalescing is opt in per event type and only merges runs of consecutive events of that type, so an event is never
+// reordered around a different one, a click still lands between the moves either side of it.
 class EventQueue
 {
     public:
-        EventQueue() { m_Dispatcher = EventDispatcher::GetEventDispatcherInstance(); }
+        EventQueue();
         ~EventQueue() = default;
 
         static void Init();
@@ -23,22 +44,96 @@ class EventQueue
             return s_EventQueue;
         }
 
-        void Enqueue(std::shared_ptr<Event> event) { m_Queue.push(std::move(event)); }
+        // Every event passes through the recorder first, which may hold back live input during a replay
+        inline void SetRecorder(std::shared_ptr<EventRecorder> recorder) { m_Recorder = std::move(recorder); }
+
+        template <typename T>
+        void Enqueue(const T& event)
+        {
+            if (m_Recorder && !ShouldEnqueue(event))
+                return;
+
+            PushSlot().Store(event);
+        }
 
-        void Process()
+        // Safe from any thread and never blocks. False if the posted queue is full and the event was dropped
+        template <typename T>
+        bool Post(const T& event)
         {
-            while (!m_Queue.empty())
+            return m_Posted.TryPush(event);
+        }
+
+        template <typename T, CoalescePolicy Policy>
+        void SetCoalescing()
+        {
+            static_assert(std::is_base_of_v<Event, T>, "only events can be coalesced");
+
+            if constexpr (Policy == CoalescePolicy::KeepLatest)
             {
-                auto event = m_Queue.front();
-                m_Queue.pop();
-                m_Dispatcher->Dispatch(event);
+                m_Coalescing[static_cast<size_t>(T::s_Type)] = [](Event& into, const Event& next)
+                { static_cast<T&>(into) = static_cast<const T&>(next); };
+            }
+            else
+            {
+                m_Coalescing[static_cast<size_t>(T::s_Type)] = [](Event& into, const Event& next)
+                { static_cast<T&>(into).Accumulate(static_cast<const T&>(next)); };
             }
         }
 
+        inline void ClearCoalescing(EventType eventType) { m_Coalescing[static_cast<size_t>(eventType)] = nullptr; }
+
+        // Called once a frame. Batch subscribers are handed the frame's events once everything has been dispatched,
+        // anything they queue is processed next frame
+        void Process();
+
+        inline size_t GetCapacity() const { return m_Ring.size(); }
+        inline size_t GetSize() const { return m_Count; }
+
+        inline size_t   GetPostedCapacity() const { return m_Posted.GetCapacity(); }
+        inline unsigned GetPostedLastFrame() const { return m_PostedLastFrame; }
+        inline uint64_t GetDroppedPosts() const { return m_DroppedPosts; }
+
+    private:
+        using CoalesceFunction = void (*)(Event& into, const Event& next);
+
+        bool ShouldEnqueue(const Event& event);
+
+        // Moves everything other threads have posted onto the back of the ring
+        void DrainPosted();
+
+        // Moves the front of the ring into record
+        void PopFront(EventRecord& record);
+        void DropFront();
+
+        // The next free record at the back of the ring, growing it if it is full
+        EventRecord& PushSlot();
+        void         Grow();
+
     private:
         static std::shared_ptr<EventQueue> s_EventQueue;
-        std::queue<std::shared_ptr<Event>> m_Queue;
-        std::shared_ptr<EventDispatcher>   m_Dispatcher;
+
+        // Comfortably more than a high polling rate mouse produces in a frame
+        static constexpr size_t s_InitialCapacity = 1024;
+        static_assert((s_InitialCapacity & (s_InitialCapacity - 1)) == 0, "event queue capacity must be a power of two");
+
+        // Background work reports back a handful of times a frame at most, this is room for a long stall
+        static constexpr size_t s_PostedCapacity = 512;
+
+        std::vector<EventRecord>         m_Ring;
+        size_t                           m_Head  = 0;
+        size_t                           m_Count = 0;
+        std::shared_ptr<EventDispatcher> m_Dispatcher;
+        std::shared_ptr<EventRecorder>   m_Recorder;
+        std::vector<EventRecord>         m_Replayed;
+
+        ConcurrentEventQueue m_Posted{s_PostedCapacity};
+        unsigned             m_PostedLastFrame = 0;
+        uint64_t             m_DroppedPosts    = 0;
+
+        std::array<CoalesceFunction, s_EventTypeCount> m_Coalescing = {};
+
+        // Per event type, kept between frames so their storage is reused
+        std::array<std::vector<EventRecord>, s_EventTypeCount> m_Batches;
 };
 
 } // namespace Core
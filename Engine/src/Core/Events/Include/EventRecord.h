@@ -0,0 +1,94 @@
+#ifndef EVENTRECORD_H
+#define EVENTRECORD_H
+
+#include "Core/Events/Include/Event.h"
+#include <new>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// One event held by value in fixed inline storage, so queueing an event never touches the heap. Any Event subclass
+// small enough to fit can be stored, the record remembers how to copy it so records can be moved between buffers.
+//
+// Events are expected to be small, self contained values. Anything that owns heap memory defeats the point of the
+// record, and is rejected at compile time if it is too big to fit.
+class EventRecord
+{
+    public:
+        static constexpr size_t s_Capacity  = 48;
+        static constexpr size_t s_Alignment = alignof(std::max_align_t);
+
+        EventRecord() = default;
+        ~EventRecord() { Reset(); }
+
+        EventRecord(const EventRecord& other) { CopyFrom(other); }
+
+        EventRecord& operator=(const EventRecord& other)
+        {
+            if (this != &other)
+            {
+                Reset();
+                CopyFrom(other);
+            }
+
+            return *this;
+        }
+
+        template <typename T>
+        void Store(const T& event)
+        {
+            static_assert(std::is_base_of_v<Event, T>, "only events can be stored in an event record");
+            static_assert(sizeof(T) <= s_Capacity, "event is too large to be stored inline, keep events small");
+            static_assert(alignof(T) <= s_Alignment, "event is over-aligned for an event record");
+
+            Reset();
+            new (m_Storage) T(event);
+            m_Copy = &CopyEvent<T>;
+        }
+
+        void Reset()
+        {
+            if (m_Copy)
+            {
+                Get().~Event();
+                m_Copy = nullptr;
+            }
+        }
+
+        inline bool IsEmpty() const { return m_Copy == nullptr; }
+
+        inline const Event& Get() const { return *std::launder(reinterpret_cast<const Event*>(m_Storage)); }
+        inline Event&       Get() { return *std::launder(reinterpret_cast<Event*>(m_Storage)); }
+
+    private:
+        using CopyFunction = void (*)(void* destination, const void* source);
+
+        template <typename T>
+        static void CopyEvent(void* destination, const void* source)
+        {
+            new (destination) T(*static_cast<const T*>(source));
+        }
+
+        void CopyFrom(const EventRecord& other)
+        {
+            if (other.m_Copy)
+            {
+                other.m_Copy(m_Storage, other.m_Storage);
+            }
+
+            m_Copy = other.m_Copy;
+        }
+
+    private:
+        alignas(s_Alignment) unsigned char m_Storage[s_Capacity];
+        CopyFunction                       m_Copy = nullptr;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // EVENTRECORD_H
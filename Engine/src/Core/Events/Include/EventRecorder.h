@@ -0,0 +1,108 @@
+#ifndef EVENTRECORDER_H
+#define EVENTRECORDER_H
+
+#include "Core/Events/Include/EventRecord.h"
+#include "Core/Include/Core.h"
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Records everything that goes through the EventQueue, stamped with the frame it was processed on, and plays it back
+// on exactly the same frames. The queue is processed once a frame, so its process count is the frame index.
+//
+// Replays run at a fixed timestep, the recording's average frame time unless overridden, and drop live input so a
+// captured session renders the same frames every time it is played back.
+//
+// File layout, in native byte order:
+//   header  "MSIR", uint32 version, float fixed delta seconds, uint64 frame count, uint64 event count
+//   events  uint32 frame, uint8 type, then the type's payload
+class EventRecorder
+{
+    public:
+        enum class Mode
+        {
+            Idle,
+            Recording,
+            Replaying
+        };
+
+        static void Init();
+
+        inline static std::shared_ptr<EventRecorder>& GetEventRecorderInstance()
+        {
+            MS_ASSERT(s_EventRecorder, "event recorder failed to initialise");
+            return s_EventRecorder;
+        }
+
+        bool StartRecording(const std::string& path);
+        bool StartReplay(const std::string& path, float fixedDeltaTime = 0.0f);
+
+        // Writes the recording out, or ends a replay early
+        void Stop();
+
+        // Called by the queue for every live event, false means the event should be dropped
+        bool OnEnqueue(const Event& event);
+
+        // Called by the queue at the start of each process, hands back this frame's replayed events
+        void OnProcess(std::vector<EventRecord>& replayed);
+
+        inline Mode GetMode() const { return m_Mode; }
+        inline bool IsReplaying() const { return m_Mode == Mode::Replaying; }
+        inline bool IsReplayFinished() const { return m_Mode == Mode::Replaying && m_Frame >= m_FrameCount; }
+        inline float GetFixedDeltaTime() const { return m_FixedDeltaTime; }
+        inline uint64_t GetFrame() const { return m_Frame; }
+        inline uint64_t GetFrameCount() const { return m_FrameCount; }
+
+    private:
+        enum class RecordedType : uint8_t
+        {
+            KeyPress,
+            MouseButtonPress,
+            MouseScroll,
+            MouseMove,
+            WindowResize,
+            WindowMinimize,
+            WindowFocus
+        };
+
+        struct RecordedEvent
+        {
+            uint32_t      frame;
+            RecordedType  type;
+            int32_t       values[3];
+            double        positions[2];
+        };
+
+        static bool Encode(const Event& event, RecordedEvent& recorded);
+        static void Decode(const RecordedEvent& recorded, EventRecord& record);
+
+        bool WriteFile() const;
+        bool ReadFile(const std::string& path);
+
+    private:
+        static std::shared_ptr<EventRecorder> s_EventRecorder;
+        static constexpr char     s_Magic[4] = {'M', 'S', 'I', 'R'};
+        static constexpr uint32_t s_Version  = 1;
+
+        Mode        m_Mode = Mode::Idle;
+        std::string m_Path;
+
+        uint64_t m_Frame      = 0;
+        uint64_t m_FrameCount = 0;
+        float    m_FixedDeltaTime = 0.0f;
+
+        // Only for the recording's average frame time
+        uint64_t m_StartNanoseconds = 0;
+
+        std::vector<RecordedEvent> m_Events;
+        size_t                     m_NextEvent = 0;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // EVENTRECORDER_H
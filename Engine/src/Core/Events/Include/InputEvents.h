@@ -12,17 +12,19 @@ namespace Core
 class KeyPressEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::KeyPress;
+
         KeyPressEvent(int keycode, int action, int mods)
-            : m_Keycode(keycode)
+            : Event(s_Type)
+            , m_Keycode(keycode)
             , m_Action(action)
             , m_Mods(mods)
         {
         }
 
-        inline int             GetKeyCode() const { return m_Keycode; }
-        inline int             GetAction() const { return m_Action; }
-        inline int             GetMods() const { return m_Mods; }
-        inline std::type_index GetEventType() const override { return typeid(KeyPressEvent); }
+        inline int GetKeyCode() const { return m_Keycode; }
+        inline int GetAction() const { return m_Action; }
+        inline int GetMods() const { return m_Mods; }
 
     private:
         int m_Keycode;
@@ -33,17 +35,19 @@ class KeyPressEvent : public Event
 class MouseButtonPressEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::MouseButtonPress;
+
         MouseButtonPressEvent(int button, int action, int mods)
-            : m_Button(button)
+            : Event(s_Type)
+            , m_Button(button)
             , m_Action(action)
             , m_Mods(mods)
         {
         }
 
-        inline int             GetButton() const { return m_Button; }
-        inline int             GetAction() const { return m_Action; }
-        inline int             GetMods() const { return m_Mods; }
-        inline std::type_index GetEventType() const override { return typeid(MouseButtonPressEvent); }
+        inline int GetButton() const { return m_Button; }
+        inline int GetAction() const { return m_Action; }
+        inline int GetMods() const { return m_Mods; }
 
     private:
         int m_Button;
@@ -54,15 +58,24 @@ class MouseButtonPressEvent : public Event
 class MouseScrollEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::MouseScroll;
+
         MouseScrollEvent(int xoffset, int yoffset)
-            : m_XOffset(xoffset)
+            : Event(s_Type)
+            , m_XOffset(xoffset)
             , m_YOffset(yoffset)
         {
         }
 
-        inline int             GetXOffset() const { return m_XOffset; }
-        inline int             GetYOffset() const { return m_YOffset; }
-        inline std::type_index GetEventType() const override { return typeid(MouseScrollEvent); }
+        inline int GetXOffset() const { return m_XOffset; }
+        inline int GetYOffset() const { return m_YOffset; }
+
+        // Lets consecutive scrolls be coalesced into one
+        inline void Accumulate(const MouseScrollEvent& other)
+        {
+            m_XOffset += other.m_XOffset;
+            m_YOffset += other.m_YOffset;
+        }
 
     private:
         int m_XOffset, m_YOffset;
@@ -71,15 +84,17 @@ class MouseScrollEvent : public Event
 class MouseMoveEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::MouseMove;
+
         MouseMoveEvent(double xPosition, double yPosition)
-            : m_XPosition(xPosition)
+            : Event(s_Type)
+            , m_XPosition(xPosition)
             , m_YPosition(yPosition)
         {
         }
 
-        inline double          GetXPosition() const { return m_XPosition; }
-        inline double          GetYPosition() const { return m_YPosition; }
-        inline std::type_index GetEventType() const override { return typeid(MouseMoveEvent); }
+        inline double GetXPosition() const { return m_XPosition; }
+        inline double GetYPosition() const { return m_YPosition; }
 
     private:
         double m_XPosition, m_YPosition;
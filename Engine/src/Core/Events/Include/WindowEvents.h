@@ -12,23 +12,28 @@ namespace Core
 class WindowCloseEvent : public Event
 {
     public:
-        WindowCloseEvent() {}
+        static constexpr EventType s_Type = EventType::WindowClose;
 
-        inline std::type_index GetEventType() const override { return typeid(WindowCloseEvent); }
+        WindowCloseEvent()
+            : Event(s_Type)
+        {
+        }
 };
 
 class WindowResizeEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::WindowResize;
+
         WindowResizeEvent(int width, int height)
-            : m_Width(width)
+            : Event(s_Type)
+            , m_Width(width)
             , m_Height(height)
         {
         }
 
-        inline int      GetWidth() const { return m_Width; }
-        inline int      GetHeight() const { return m_Height; }
-        inline std::type_index GetEventType() const override { return typeid(WindowResizeEvent); }
+        inline int GetWidth() const { return m_Width; }
+        inline int GetHeight() const { return m_Height; }
 
     private:
         int m_Width, m_Height;
@@ -37,13 +42,15 @@ class WindowResizeEvent : public Event
 class WindowMinimizeEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::WindowMinimize;
+
         WindowMinimizeEvent(int minimized)
-            : m_Minimized(minimized)
+            : Event(s_Type)
+            , m_Minimized(minimized)
         {
         }
 
-        inline int             IsMinimized() const { return m_Minimized; }
-        inline std::type_index GetEventType() const override { return typeid(WindowMinimizeEvent); }
+        inline int IsMinimized() const { return m_Minimized; }
 
     private:
         int m_Minimized;
@@ -52,13 +59,15 @@ class WindowMinimizeEvent : public Event
 class WindowFocusEvent : public Event
 {
     public:
+        static constexpr EventType s_Type = EventType::WindowFocus;
+
         WindowFocusEvent(int focused)
-            : m_Focused(focused)
+            : Event(s_Type)
+            , m_Focused(focused)
         {
         }
 
-        inline int             IsFocused() const { return m_Focused; }
-        inline std::type_index GetEventType() const override { return typeid(WindowFocusEvent); }
+        inline int IsFocused() const { return m_Focused; }
 
     private:
         int m_Focused;
@@ -0,0 +1,111 @@
+#include "Include/FramePacer.h"
+#include "Core/Include/Profiler.h"
+#include "Core/Include/Time.h"
+#include <chrono>
+#include <thread>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<FramePacer> FramePacer::s_FramePacer;
+
+void FramePacer::Init()
+{
+    s_FramePacer = std::make_shared<FramePacer>();
+    MS_INFO("frame pacer initialised");
+}
+
+float FramePacer::GetPacedFPS(State state) const
+{
+    if (m_IdleThrottling && state != State::Active)
+    {
+        return m_TargetFPS > 0.0f ? std::min(m_TargetFPS, m_UnfocusedFPS) : m_UnfocusedFPS;
+    }
+
+    return m_TargetFPS;
+}
+
+void FramePacer::WaitForNextFrame(State state)
+{
+    MS_PROFILE_FUNCTION();
+
+    m_State = state;
+
+    float fps = GetPacedFPS(state);
+    uint64_t start = Time::Now();
+
+    if (fps <= 0.0f)
+    {
+        m_NextFrameNanoseconds = 0;
+        m_LastWaitNanoseconds = 0;
+        return;
+    }
+
+    uint64_t period = static_cast<uint64_t>(1000000000.0 / fps);
+
+    if (m_NextFrameNanoseconds == 0 || start > m_NextFrameNanoseconds + period)
+    {
+        m_NextFrameNanoseconds = start;
+    }
+
+    SleepUntil(m_NextFrameNanoseconds);
+
+    m_NextFrameNanoseconds += period;
+    m_LastWaitNanoseconds = Time::Now() - start;
+}
+
+void FramePacer::SleepUntil(uint64_t deadline)
+{
+    while (true)
+    {
+        uint64_t now = Time::Now();
+        if (now >= deadline)
+        {
+            return;
+        }
+
+        if (static_cast<double>(deadline - now) <= m_SleepEstimateNanoseconds)
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        UpdateSleepEstimate(Time::Now() - now);
+    }
+
+    while (Time::Now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::UpdateSleepEstimate(uint64_t sleptNanoseconds)
+{
+    if (m_SleepSamples >= s_MaxSleepSamples)
+    {
+        m_SleepSamples = 0;
+        m_SleepMean = 0.0;
+        m_SleepM2 = 0.0;
+    }
+
+    // Welford's running mean and variance
+    double sample = static_cast<double>(sleptNanoseconds);
+    ++m_SleepSamples;
+
+    double delta = sample - m_SleepMean;
+    m_SleepMean += delta / static_cast<double>(m_SleepSamples);
+    m_SleepM2 += delta * (sample - m_SleepMean);
+
+    if (m_SleepSamples > 1)
+    {
+        double deviation = std::sqrt(m_SleepM2 / static_cast<double>(m_SleepSamples - 1));
+        m_SleepEstimateNanoseconds = m_SleepMean + deviation;
+    }
+}
+
+} // namespace Core
+
+} // namespace Moonstone
@@ -0,0 +1,145 @@
+#include "Include/FrameStats.h"
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<FrameStats> FrameStats::s_FrameStats;
+
+void FrameStats::Init()
+{
+    s_FrameStats = std::make_shared<FrameStats>();
+    MS_INFO("frame stats initialised");
+}
+
+void FrameStats::AddFrame(float milliseconds)
+{
+    m_History[m_Next] = milliseconds;
+    m_Next = (m_Next + 1) % s_HistorySize;
+    m_Count = std::min(m_Count + 1, s_HistorySize);
+
+    if (milliseconds > m_TargetMilliseconds)
+    {
+        ++m_TotalHitchCount;
+    }
+
+    if (m_RunActive)
+    {
+        m_RunFrames.push_back(milliseconds);
+    }
+}
+
+void FrameStats::Reset()
+{
+    m_Count = 0;
+    m_Next = 0;
+    m_TotalHitchCount = 0;
+}
+
+FrameStats::Summary FrameStats::GetSummary() const
+{
+    Summary summary;
+    summary.totalHitchCount = m_TotalHitchCount;
+
+    std::copy(m_History.begin(), m_History.begin() + m_Count, m_Sorted.begin());
+    Summarise(m_Sorted.data(), m_Count, m_TargetMilliseconds, summary);
+
+    return summary;
+}
+
+void FrameStats::BeginRun(size_t expectedFrames)
+{
+    m_RunFrames.clear();
+    m_RunFrames.reserve(expectedFrames);
+    m_RunHitchCount = m_TotalHitchCount;
+    m_RunActive = true;
+}
+
+FrameStats::Summary FrameStats::EndRun()
+{
+    Summary summary;
+    summary.totalHitchCount = m_TotalHitchCount - m_RunHitchCount;
+
+    Summarise(m_RunFrames.data(), m_RunFrames.size(), m_TargetMilliseconds, summary);
+
+    m_RunFrames.clear();
+    m_RunActive = false;
+
+    return summary;
+}
+
+void FrameStats::Summarise(float *samples, size_t count, float targetMilliseconds, Summary &summary)
+{
+    summary.frameCount = count;
+
+    if (count == 0)
+        return;
+
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += samples[i];
+
+        if (samples[i] > targetMilliseconds)
+        {
+            ++summary.hitchCount;
+        }
+    }
+
+    std::sort(samples, samples + count);
+
+    summary.minMilliseconds = samples[0];
+    summary.maxMilliseconds = samples[count - 1];
+    summary.averageMilliseconds = sum / static_cast<float>(count);
+    summary.p50Milliseconds = Percentile(samples, count, 0.50f);
+    summary.p95Milliseconds = Percentile(samples, count, 0.95f);
+    summary.p99Milliseconds = Percentile(samples, count, 0.99f);
+}
+
+float FrameStats::Percentile(const float *sorted, size_t count, float percentile)
+{
+    // Nearest rank, so every reported percentile is a frame that actually happened
+    size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<float>(count)));
+    return sorted[std::clamp<size_t>(rank, 1, count) - 1];
+}
+
+bool FrameStats::ExportCSV(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} for frame stats", path);
+        return false;
+    }
+
+    Summary summary = GetSummary();
+
+    file << "statistic,value\n";
+    file << "frames," << summary.frameCount << "\n";
+    file << "target_ms," << m_TargetMilliseconds << "\n";
+    file << "min_ms," << summary.minMilliseconds << "\n";
+    file << "avg_ms," << summary.averageMilliseconds << "\n";
+    file << "p50_ms," << summary.p50Milliseconds << "\n";
+    file << "p95_ms," << summary.p95Milliseconds << "\n";
+    file << "p99_ms," << summary.p99Milliseconds << "\n";
+    file << "max_ms," << summary.maxMilliseconds << "\n";
+    file << "hitches," << summary.hitchCount << "\n";
+    file << "total_hitches," << summary.totalHitchCount << "\n";
+
+    file << "\nframe,frame_ms\n";
+
+    size_t offset = GetHistoryOffset();
+    for (size_t i = 0; i < m_Count; ++i)
+    {
+        file << i << "," << m_History[(offset + i) % s_HistorySize] << "\n";
+    }
+
+    MS_INFO("frame stats for {0} frames written to {1}", m_Count, path);
+    return true;
+}
+
+} // namespace Core
+
+} // namespace Moonstone
@@ -31,6 +31,26 @@ class Application
 
     void Run();
 
+    // One frame of the main loop, returns false once the application should stop
+    bool RunFrame();
+    void Shutdown();
+
+    // Stops Run() after this many frames, 0 runs until the window closes
+    inline void SetFrameLimit(uint64_t frameLimit)
+    {
+        m_FrameLimit = frameLimit;
+    }
+
+    inline std::shared_ptr<Rendering::Renderer> GetRenderer()
+    {
+        return m_SceneRenderer;
+    }
+
+    inline std::shared_ptr<Rendering::Scene> GetActiveScene()
+    {
+        return m_ActiveScene;
+    }
+
     inline static std::unique_ptr<Application> &GetApplicationInstance()
     {
         return s_ApplicationInstance;
@@ -39,6 +59,9 @@ class Application
 
     void InitializeEditor();
 
+    // Renders the default scene into an offscreen target with no editor UI, for benchmarks and display-less machines
+    void InitializeHeadless(unsigned width = 1280, unsigned height = 720);
+
   private:
     void UpdateModels(Rendering::Shader &meshShader, Rendering::Model &model);
 
@@ -51,10 +74,14 @@ class Application
 
     std::shared_ptr<Rendering::Renderer> m_SceneRenderer;
     Rendering::SceneManager m_SceneManager;
+    std::shared_ptr<Rendering::Scene> m_ActiveScene;
 
     std::shared_ptr<EditorUI> m_EditorUI;
 
-    bool m_Running;
+    bool m_Running = true;
+    bool m_FirstFrame = true;
+    uint64_t m_FrameCount = 0;
+    uint64_t m_FrameLimit = 0;
 
     std::shared_ptr<Rendering::Camera> m_ActiveCamera;
     std::shared_ptr<Window> m_Window;
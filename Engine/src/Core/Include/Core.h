@@ -14,6 +14,8 @@
 //#define MS_VULKAN
 
 #define MS_ENABLE_ASSERTS
+#define MS_ENABLE_PROFILING
+#define MS_ENABLE_MEMORY_TRACKING
 
 #ifdef MS_ENABLE_ASSERTS
     #ifdef MS_PLATFORM_WINDOWS
@@ -30,9 +30,9 @@ class EditorUI
         m_Window = window;
     }
 
-    inline void SetFramebufferParams(unsigned &FBOTexMap, unsigned &FBShaderID, unsigned &screenQuadVAO)
+    inline void SetFramebufferParams(unsigned sceneTarget, unsigned &FBShaderID, unsigned &screenQuadVAO)
     {
-        m_FBOTextureMap = FBOTexMap;
+        m_SceneTarget = sceneTarget;
         m_FBShaderID = FBShaderID;
         m_ScreenQuadVAO = screenQuadVAO;
     }
@@ -62,7 +62,7 @@ class EditorUI
     std::shared_ptr<Tools::ImGuiLayer> m_ImGuiLayer;
     std::shared_ptr<Rendering::Scene> m_ActiveScene;
 
-    unsigned m_FBOTextureMap, m_FBShaderID, m_ScreenQuadVAO;
+    unsigned m_SceneTarget, m_FBShaderID, m_ScreenQuadVAO;
 };
 
 } // namespace Core
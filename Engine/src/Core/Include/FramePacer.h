@@ -0,0 +1,139 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "Core/Include/Core.h"
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Holds the main loop to a target frame rate and backs off when nobody is looking at the window.
+//
+// Waits sleep in 1ms steps while more time is left than a sleep has been seen to overshoot by, then spin out the rest,
+// so frames land on time without burning a core for the whole wait. The overshoot estimate is the running mean plus
+// one deviation of measured sleeps, which adapts to the scheduler's actual timer resolution.
+//
+// Deadlines advance by exactly one period, so a late frame is made up on the next one, but a frame more than a whole
+// period late resets the schedule instead of rushing several frames out to catch up.
+class FramePacer
+{
+  public:
+    enum class State
+    {
+        Active,
+        Unfocused,
+        Minimized
+    };
+
+    static void Init();
+
+    inline static std::shared_ptr<FramePacer> &GetFramePacerInstance()
+    {
+        MS_ASSERT(s_FramePacer, "frame pacer failed to initialise");
+        return s_FramePacer;
+    }
+
+    // Blocks until the next frame is due at the rate for state, minimized windows are the caller's to wait out
+    void WaitForNextFrame(State state);
+
+    // 0 leaves the rate to vsync, or runs uncapped without it
+    inline void SetTargetFPS(float fps)
+    {
+        m_TargetFPS = std::max(fps, 0.0f);
+    }
+
+    inline float GetTargetFPS() const
+    {
+        return m_TargetFPS;
+    }
+
+    inline void SetUnfocusedFPS(float fps)
+    {
+        m_UnfocusedFPS = std::max(fps, 1.0f);
+    }
+
+    inline float GetUnfocusedFPS() const
+    {
+        return m_UnfocusedFPS;
+    }
+
+    // Unfocused windows drop to the unfocused rate and minimized ones stop rendering until an event or a timeout
+    inline void SetIdleThrottling(bool enabled)
+    {
+        m_IdleThrottling = enabled;
+    }
+
+    inline bool IsIdleThrottling() const
+    {
+        return m_IdleThrottling;
+    }
+
+    // Policy only, the application applies it to the window at the start of the next frame
+    inline void SetVSync(bool enabled)
+    {
+        m_VSync = enabled;
+    }
+
+    inline bool GetVSync() const
+    {
+        return m_VSync;
+    }
+
+    inline double GetMinimizedWaitSeconds() const
+    {
+        return s_MinimizedWaitSeconds;
+    }
+
+    inline State GetState() const
+    {
+        return m_State;
+    }
+
+    inline float GetLastWaitMilliseconds() const
+    {
+        return m_LastWaitNanoseconds / 1000000.0f;
+    }
+
+    inline float GetSleepEstimateMilliseconds() const
+    {
+        return m_SleepEstimateNanoseconds / 1000000.0f;
+    }
+
+  private:
+    float GetPacedFPS(State state) const;
+
+    void SleepUntil(uint64_t deadline);
+    void UpdateSleepEstimate(uint64_t sleptNanoseconds);
+
+  private:
+    static std::shared_ptr<FramePacer> s_FramePacer;
+
+    // Long enough that a minimized editor is idle, short enough that closing it from the taskbar feels immediate
+    static constexpr double s_MinimizedWaitSeconds = 0.25;
+
+    // The estimate keeps adapting rather than settling on startup's scheduler behaviour
+    static constexpr uint64_t s_MaxSleepSamples = 1000;
+
+    float m_TargetFPS = 0.0f;
+    float m_UnfocusedFPS = 10.0f;
+    bool m_IdleThrottling = true;
+    bool m_VSync = true;
+
+    State m_State = State::Active;
+    uint64_t m_NextFrameNanoseconds = 0;
+    uint64_t m_LastWaitNanoseconds = 0;
+
+    // Starts pessimistic, a coarse timer only costs some spinning until the first samples come in
+    double m_SleepEstimateNanoseconds = 5000000.0;
+    double m_SleepMean = 0.0;
+    double m_SleepM2 = 0.0;
+    uint64_t m_SleepSamples = 0;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // FRAMEPACER_H
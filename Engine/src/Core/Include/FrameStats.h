@@ -0,0 +1,115 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include "Core/Include/Core.h"
+#include <array>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Rolling frame time history in a fixed ring, so recording a frame never allocates. Percentiles come from a sorted
+// copy of the window and are only worked out when asked for.
+class FrameStats
+{
+  public:
+    static constexpr size_t s_HistorySize = 512;
+
+    struct Summary
+    {
+        size_t frameCount = 0;
+
+        float minMilliseconds = 0.0f;
+        float averageMilliseconds = 0.0f;
+        float p50Milliseconds = 0.0f;
+        float p95Milliseconds = 0.0f;
+        float p99Milliseconds = 0.0f;
+        float maxMilliseconds = 0.0f;
+
+        // Frames over the target, within the window and since the last reset
+        unsigned hitchCount = 0;
+        uint64_t totalHitchCount = 0;
+    };
+
+    static void Init();
+
+    inline static std::shared_ptr<FrameStats> &GetFrameStatsInstance()
+    {
+        MS_ASSERT(s_FrameStats, "frame stats failed to initialise");
+        return s_FrameStats;
+    }
+
+    void AddFrame(float milliseconds);
+    void Reset();
+
+    // Summary of the rolling window only, at most s_HistorySize frames
+    Summary GetSummary() const;
+
+    // Keeps every frame from here to EndRun() alongside the window, for summaries of a whole run such as a replay.
+    // Room for expectedFrames is reserved up front, so frames within that never allocate
+    void BeginRun(size_t expectedFrames);
+    Summary EndRun();
+
+    inline bool IsRunActive() const
+    {
+        return m_RunActive;
+    }
+
+    bool ExportCSV(const std::string &path) const;
+
+    inline void SetTargetMilliseconds(float milliseconds)
+    {
+        m_TargetMilliseconds = milliseconds;
+    }
+
+    inline float GetTargetMilliseconds() const
+    {
+        return m_TargetMilliseconds;
+    }
+
+    // Ring storage for plotting, samples start at GetHistoryOffset() and wrap
+    inline const std::array<float, s_HistorySize> &GetHistory() const
+    {
+        return m_History;
+    }
+
+    inline size_t GetHistoryCount() const
+    {
+        return m_Count;
+    }
+
+    inline size_t GetHistoryOffset() const
+    {
+        return m_Count < s_HistorySize ? 0 : m_Next;
+    }
+
+  private:
+    // Sorts samples in place
+    static void Summarise(float *samples, size_t count, float targetMilliseconds, Summary &summary);
+    static float Percentile(const float *sorted, size_t count, float percentile);
+
+  private:
+    static std::shared_ptr<FrameStats> s_FrameStats;
+
+    std::array<float, s_HistorySize> m_History = {};
+    size_t m_Count = 0;
+    size_t m_Next = 0;
+
+    float m_TargetMilliseconds = 1000.0f / 60.0f;
+    uint64_t m_TotalHitchCount = 0;
+
+    // Scratch for percentiles, kept around so summaries don't allocate either
+    mutable std::array<float, s_HistorySize> m_Sorted = {};
+
+    std::vector<float> m_RunFrames;
+    uint64_t m_RunHitchCount = 0;
+    bool m_RunActive = false;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // FRAMESTATS_H
@@ -0,0 +1,62 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "Core/Include/Core.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Fixed pool of worker threads for splitting per-frame CPU work. ParallelFor blocks until every batch has run and
+// the calling thread takes batches too, so it is safe to call from the main loop without any extra synchronisation.
+class JobSystem
+{
+  public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    explicit JobSystem(unsigned workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    static void Init();
+
+    inline static std::shared_ptr<JobSystem> &GetJobSystemInstance()
+    {
+        MS_ASSERT(s_JobSystem, "job system failed to initialise");
+        return s_JobSystem;
+    }
+
+    // Calls function over [0, count) in batches of at most batchSize
+    void ParallelFor(size_t count, size_t batchSize, const RangeFunction &function);
+
+    inline unsigned GetWorkerCount() const
+    {
+        return static_cast<unsigned>(m_Workers.size());
+    }
+
+  private:
+    void WorkerLoop();
+
+  private:
+    static std::shared_ptr<JobSystem> s_JobSystem;
+
+    std::vector<std::thread> m_Workers;
+    std::mutex m_JobMutex;
+    std::condition_variable m_JobCondition;
+    std::deque<std::function<void()>> m_Jobs;
+    bool m_StopWorkers = false;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // JOBSYSTEM_H
@@ -0,0 +1,190 @@
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include "Core/Include/Core.h"
+#include <array>
+#include <atomic>
+#include <unordered_map>
+
+#define MS_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define MS_MEMORY_TAG_CONCAT(a, b) MS_MEMORY_TAG_CONCAT_INNER(a, b)
+
+// Tags every allocation, and every GPU resource, made on this thread until the end of the enclosing scope
+#define MS_MEMORY_TAG(tag)                                                                                             \
+    ::Moonstone::Core::MemoryTagScope MS_MEMORY_TAG_CONCAT(memoryTagScope, __LINE__)(::Moonstone::Core::MemoryTag::tag)
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+enum class MemoryTag : uint8_t
+{
+    General,
+    Meshes,
+    Textures,
+    RenderTargets,
+    UI,
+    Events,
+    Count
+};
+
+// Per tag CPU heap and GPU resource accounting.
+//
+// With MS_ENABLE_MEMORY_TRACKING the global operator new is replaced and every allocation carries a small header with
+// its size and the tag that was current on the allocating thread, so frees land on the tag they were made under no
+// matter which thread releases them. Counters are relaxed atomics that live outside the instance, allocations made
+// during static initialisation are counted too.
+//
+// GPU resources are reported by the rendering API implementation as they are created and deleted. That bookkeeping is
+// only touched from the thread that owns the context.
+class MemoryTracker
+{
+  public:
+    enum class GPUResourceType
+    {
+        Buffer,
+        Texture,
+        Count
+    };
+
+    struct TagStats
+    {
+        size_t liveBytes = 0;
+        size_t peakBytes = 0;
+        uint64_t liveAllocations = 0;
+        uint64_t totalAllocations = 0;
+        uint64_t allocationsLastFrame = 0;
+
+        size_t gpuBytes = 0;
+        unsigned gpuResources = 0;
+    };
+
+    struct GPUResource
+    {
+        GPUResourceType type;
+        unsigned id;
+        MemoryTag tag;
+        size_t bytes;
+    };
+
+    // Point in time copy of every tag and every live GPU resource, for diffing against a later one
+    struct Snapshot
+    {
+        uint64_t frame = 0;
+        std::array<TagStats, static_cast<size_t>(MemoryTag::Count)> tags = {};
+        std::vector<GPUResource> gpuResources;
+    };
+
+    static void Init();
+
+    inline static std::shared_ptr<MemoryTracker> &GetMemoryTrackerInstance()
+    {
+        MS_ASSERT(s_MemoryTracker, "memory tracker failed to initialise");
+        return s_MemoryTracker;
+    }
+
+    static constexpr bool IsTrackingAllocations()
+    {
+#ifdef MS_ENABLE_MEMORY_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char *GetTagName(MemoryTag tag);
+    static const char *GetGPUResourceTypeName(GPUResourceType type);
+
+    // Returns the tag that was current so scopes can put it back
+    static MemoryTag SetCurrentTag(MemoryTag tag);
+    static MemoryTag GetCurrentTag();
+
+    // Called by the replaced operator new and delete
+    static void RecordAllocation(MemoryTag tag, size_t size);
+    static void RecordFree(MemoryTag tag, size_t size);
+
+    // Every allocation since startup, across all tags
+    static uint64_t GetAllocationCount();
+    static uint64_t GetAllocatedBytes();
+
+    // Called once per frame from the main thread, closes the frame's allocation counts
+    void EndFrame();
+
+    TagStats GetTagStats(MemoryTag tag) const;
+
+    inline uint64_t GetAllocationsLastFrame() const
+    {
+        return m_AllocationsLastFrame;
+    }
+
+    // Tracking the same resource again replaces its size, its tag stays the one it was created under
+    void TrackGPUResource(GPUResourceType type, unsigned id, size_t bytes);
+    void ReleaseGPUResource(GPUResourceType type, unsigned id);
+
+    inline size_t GetGPUBytes(GPUResourceType type) const
+    {
+        return m_GPUTypeBytes[static_cast<size_t>(type)];
+    }
+
+    // Logs every tag still holding GPU resources, call at shutdown once the engine has released its own.
+    // Returns the bytes still live
+    size_t ReportLiveGPUResources() const;
+
+    Snapshot TakeSnapshot() const;
+
+    // Per tag deltas, then every GPU resource created or resized since before, biggest first
+    bool WriteSnapshotDiff(const Snapshot &before, const std::string &path) const;
+
+  private:
+    struct TagCounters
+    {
+        std::atomic<uint64_t> liveBytes = 0;
+        std::atomic<uint64_t> peakBytes = 0;
+        std::atomic<uint64_t> liveAllocations = 0;
+        std::atomic<uint64_t> totalAllocations = 0;
+        std::atomic<uint64_t> totalBytes = 0;
+    };
+
+    static uint64_t GPUResourceKey(GPUResourceType type, unsigned id);
+
+  private:
+    static std::shared_ptr<MemoryTracker> s_MemoryTracker;
+    static std::array<TagCounters, static_cast<size_t>(MemoryTag::Count)> s_Counters;
+
+    uint64_t m_Frame = 0;
+    std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> m_FrameStartAllocations = {};
+    std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> m_LastFrameAllocations = {};
+    uint64_t m_AllocationsLastFrame = 0;
+
+    std::unordered_map<uint64_t, GPUResource> m_GPUResources;
+    std::array<size_t, static_cast<size_t>(MemoryTag::Count)> m_GPUTagBytes = {};
+    std::array<unsigned, static_cast<size_t>(MemoryTag::Count)> m_GPUTagResources = {};
+    std::array<size_t, static_cast<size_t>(GPUResourceType::Count)> m_GPUTypeBytes = {};
+};
+
+class MemoryTagScope
+{
+  public:
+    explicit MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::SetCurrentTag(tag))
+    {
+    }
+
+    ~MemoryTagScope()
+    {
+        MemoryTracker::SetCurrentTag(m_Previous);
+    }
+
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+  private:
+    MemoryTag m_Previous;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // MEMORYTRACKER_H
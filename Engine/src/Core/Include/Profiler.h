@@ -0,0 +1,141 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "Core/Include/Core.h"
+#include "Core/Include/Time.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#ifdef MS_ENABLE_PROFILING
+    #define MS_PROFILE_CONCAT_INNER(a, b) a##b
+    #define MS_PROFILE_CONCAT(a, b) MS_PROFILE_CONCAT_INNER(a, b)
+
+    #define MS_PROFILE_SCOPE(name) ::Moonstone::Core::ProfileScope MS_PROFILE_CONCAT(profileScope, __LINE__)(name)
+    #define MS_PROFILE_FUNCTION() MS_PROFILE_SCOPE(__FUNCTION__)
+    #define MS_PROFILE_THREAD(name) ::Moonstone::Core::Profiler::SetThreadName(name)
+    #define MS_PROFILE_FRAME() ::Moonstone::Core::Profiler::GetProfilerInstance()->MarkFrame()
+#else
+    #define MS_PROFILE_SCOPE(name)
+    #define MS_PROFILE_FUNCTION()
+    #define MS_PROFILE_THREAD(name)
+    #define MS_PROFILE_FRAME()
+#endif
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+// Hierarchical CPU profiler. Every thread records finished scopes into its own fixed-size ring that only that thread
+// writes, publishing each event with a release store of the write index, so recording never takes a lock. Readers
+// copy the tail of each ring and throw away anything the writer may have lapped while it was being copied.
+//
+// The main loop marks frame boundaries, which the flame view and trace export use to pick out events.
+class Profiler
+{
+  public:
+    // Times are nanoseconds since the profiler started
+    struct ProfileEvent
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+        uint32_t depth;
+    };
+
+    struct ThreadEvents
+    {
+        std::string threadName;
+        unsigned threadIndex;
+        std::vector<ProfileEvent> events;
+    };
+
+    struct FrameRange
+    {
+        uint64_t frame;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    static void Init();
+
+    inline static std::shared_ptr<Profiler> &GetProfilerInstance()
+    {
+        MS_ASSERT(s_Profiler, "profiler failed to initialise");
+        return s_Profiler;
+    }
+
+    static void SetThreadName(const std::string &name);
+
+    // Called once per frame from the main thread, before any of the frame's work
+    void MarkFrame();
+
+    // The last count frames that have finished, oldest first
+    std::vector<FrameRange> GetRecentFrames(size_t count) const;
+
+    // Every thread's events that overlap [start, end)
+    std::vector<ThreadEvents> CollectEvents(uint64_t start, uint64_t end) const;
+
+    bool ExportChromeTrace(const std::string &path, size_t frameCount) const;
+
+    // Used by ProfileScope, names must outlive the profiler so string literals are expected
+    static uint32_t BeginScope();
+    static void EndScope(const char *name, uint64_t start, uint32_t depth);
+
+  private:
+    static constexpr size_t s_ThreadBufferSize = 1 << 15;
+    static constexpr size_t s_FrameHistory = 256;
+
+    struct ThreadBuffer
+    {
+        std::array<ProfileEvent, s_ThreadBufferSize> events;
+        std::atomic<uint64_t> writeIndex = 0;
+        uint32_t depth = 0;
+
+        // Guarded by the profiler's thread mutex
+        std::string name;
+        unsigned index = 0;
+    };
+
+    static ThreadBuffer *GetThreadBuffer();
+
+  private:
+    static std::shared_ptr<Profiler> s_Profiler;
+
+    // Only taken when a thread registers, renames itself or a reader walks the thread list
+    mutable std::mutex m_ThreadMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+
+    std::array<uint64_t, s_FrameHistory> m_FrameStarts = {};
+    uint64_t m_FrameCount = 0;
+};
+
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(const char *name)
+        : m_Name(name), m_Depth(Profiler::BeginScope()), m_Start(Time::Now())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        Profiler::EndScope(m_Name, m_Start, m_Depth);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    const char *m_Name;
+    uint32_t m_Depth;
+    uint64_t m_Start;
+};
+
+} // namespace Core
+
+} // namespace Moonstone
+
+#endif // PROFILER_H
@@ -1,12 +1,19 @@
 #ifndef TIME_H
 #define TIME_H
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
 namespace Moonstone
 {
 
 namespace Core
 {
 
+// Frame timing on a steady nanosecond clock, plus the accumulator that turns variable frame deltas into fixed
+// simulation steps. Everything is kept as integer nanoseconds so neither precision nor the step count drifts with
+// uptime, and a given sequence of deltas always produces the same steps.
 class Time
 {
     public:
@@ -16,25 +23,91 @@ class Time
             return instance;
         }
 
-        inline float GetDeltaTime() const { return m_DeltaTime; }
-        inline float GetLastFrame() const { return m_LastFrame; }
+        // Nanoseconds since the first call, every timestamp in the engine comes from here so they can be compared
+        static uint64_t Now()
+        {
+            static const auto epoch = std::chrono::steady_clock::now();
+
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+        }
+
+        inline float    GetDeltaTime() const { return static_cast<float>(m_DeltaNanoseconds / 1000000000.0); }
+        inline uint64_t GetDeltaNanoseconds() const { return m_DeltaNanoseconds; }
+        inline uint64_t GetFrameStartNanoseconds() const { return m_FrameStartNanoseconds; }
+
+        inline float    GetFixedDeltaTime() const { return static_cast<float>(m_FixedStepNanoseconds / 1000000000.0); }
+        inline uint64_t GetFixedStepNanoseconds() const { return m_FixedStepNanoseconds; }
+        inline uint64_t GetFixedStepCount() const { return m_FixedStepCount; }
+        inline unsigned GetFixedStepsLastFrame() const { return m_FixedStepsLastFrame; }
 
-        void Update(float currentTime)
+        // How far the frame is between the last fixed step and the next one, for interpolating what gets drawn
+        inline float GetInterpolationAlpha() const
         {
-            m_DeltaTime = currentTime - m_LastFrame;
-            m_LastFrame = currentTime;
+            return static_cast<float>(static_cast<double>(m_Accumulator) / m_FixedStepNanoseconds);
         }
 
-        void SetDeltaTime(float deltaTime) { m_DeltaTime = deltaTime; }
-        void SetLastFrame(float lastFrame) { m_LastFrame = lastFrame; }
+        // Starts a frame, its delta is the time since the last one started
+        void Update()
+        {
+            uint64_t now = Now();
+
+            m_DeltaNanoseconds      = now - m_FrameStartNanoseconds;
+            m_FrameStartNanoseconds = now;
+        }
+
+        // Replays stand a fixed delta in for the measured one
+        void SetDeltaTime(float deltaTime)
+        {
+            m_DeltaNanoseconds = static_cast<uint64_t>(static_cast<double>(deltaTime) * 1000000000.0);
+        }
+
+        // Restarts frame timing from now, so time spent not running frames doesn't show up as one long delta
+        void ResetFrameStart() { m_FrameStartNanoseconds = Now(); }
+
+        void SetFixedStepRate(unsigned stepsPerSecond)
+        {
+            m_FixedStepNanoseconds = 1000000000ull / std::max(stepsPerSecond, 1u);
+            m_Accumulator          = 0;
+        }
+
+        // Adds the frame's delta and returns how many fixed steps are due. A frame that falls too far behind runs
+        // the most it is allowed and drops the rest of the backlog, rather than falling further behind every frame
+        unsigned AccumulateFixedSteps()
+        {
+            m_Accumulator += m_DeltaNanoseconds;
+
+            uint64_t steps = m_Accumulator / m_FixedStepNanoseconds;
+            if (steps > s_MaxFixedStepsPerFrame)
+            {
+                steps         = s_MaxFixedStepsPerFrame;
+                m_Accumulator %= m_FixedStepNanoseconds;
+            }
+            else
+            {
+                m_Accumulator -= steps * m_FixedStepNanoseconds;
+            }
+
+            m_FixedStepCount      += steps;
+            m_FixedStepsLastFrame  = static_cast<unsigned>(steps);
+            return m_FixedStepsLastFrame;
+        }
 
     private:
         Time()                       = default;
         Time(const Time&)            = delete;
         Time& operator=(const Time&) = delete;
 
-        float m_DeltaTime = 0.0f;
-        float m_LastFrame = 0.0f;
+        static constexpr unsigned s_DefaultFixedStepRate   = 60;
+        static constexpr uint64_t s_MaxFixedStepsPerFrame = 8;
+
+        uint64_t m_DeltaNanoseconds      = 0;
+        uint64_t m_FrameStartNanoseconds = 0;
+
+        uint64_t m_FixedStepNanoseconds = 1000000000ull / s_DefaultFixedStepRate;
+        uint64_t m_Accumulator          = 0;
+        uint64_t m_FixedStepCount       = 0;
+        unsigned m_FixedStepsLastFrame  = 0;
 };
 
 } // namespace Core
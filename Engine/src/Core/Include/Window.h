@@ -33,13 +33,21 @@ struct WindowProperties
     std::string Title;
     unsigned Width, Height;
 
-    WindowProperties(const std::string Title = "Moonstone", unsigned Width = 1280, unsigned Height = 720);
+    // Headless windows are never shown and take no input, the scene only renders into its offscreen target
+    bool Headless;
+
+    WindowProperties(const std::string Title = "Moonstone", unsigned Width = 1280, unsigned Height = 720,
+                     bool Headless = false);
 };
 
 struct WindowData
 {
     WindowProperties windowProperties;
     bool VSync;
+
+    // Kept up to date from the window's own events
+    bool Minimized = false;
+    bool Focused = true;
 };
 
 class Window
@@ -52,6 +60,29 @@ class Window
     void TerminateWindow();
     static void UpdateWindow(std::shared_ptr<Window> window);
 
+    // Sleeps until an event arrives or the timeout passes and handles whatever came in, without presenting a frame
+    static void WaitForEvents(std::shared_ptr<Window> window, double timeoutSeconds);
+
+    void SetVSync(bool vSyncEnabled);
+
+    // One fixed simulation step, moves the camera for whichever movement keys are held
+    void FixedUpdate(float deltaTime);
+
+    inline bool IsVSync() const
+    {
+        return m_WindowData.VSync;
+    }
+
+    inline bool IsMinimized() const
+    {
+        return m_WindowData.Minimized;
+    }
+
+    inline bool IsFocused() const
+    {
+        return m_WindowData.Focused;
+    }
+
     inline void SetCamera(std::shared_ptr<Rendering::CameraController> camera)
     {
         m_CameraController = camera;
@@ -76,24 +107,30 @@ class Window
         return WindowProperties().Height;
     }
 
+    inline bool IsHeadless() const
+    {
+        return m_WindowData.windowProperties.Headless;
+    }
+
   public:
     glm::vec4 m_WindowColor;
-    Rendering::RenderingAPI::PolygonDataType m_PolygonMode;
+    Rendering::RenderingAPI::PolygonDataType m_PolygonMode = Rendering::RenderingAPI::PolygonDataType::PolygonFill;
     GLFWwindow *m_Window;
 
   private:
     static void ReportGLFWError(int error, const char *description);
 
     bool InitializeWindow(const WindowProperties &windowProperties);
+    bool InitializeHeadlessContext();
 
     void SetupWindowCallbacks(GLFWwindow *window);
     void SetupInputCallbacks(GLFWwindow *window);
     void SetupInitEvents();
-    void SetVSync(bool vSyncEnabled);
+    void SetMovementKey(int key, bool held);
 
   private:
     WindowData m_WindowData;
-    std::vector<std::type_index> m_SubscribedWindowEvents;
+    std::vector<SubscriptionHandle> m_WindowSubscriptions;
     std::unique_ptr<Rendering::GraphicsContext> m_GraphicsContext;
     std::shared_ptr<Rendering::CameraController> m_CameraController = nullptr;
     float m_LastX = m_WindowData.windowProperties.Width;
@@ -101,6 +138,14 @@ class Window
     bool m_FirstMouse = true;
     float m_CamSensitivity = 0.2f;
 
+    struct MovementKeys
+    {
+        bool forward = false;
+        bool backward = false;
+        bool left = false;
+        bool right = false;
+    } m_MovementKeys;
+
     std::shared_ptr<EventDispatcher> m_EventDispatcher;
     std::shared_ptr<EventQueue> m_EventQueue;
     std::shared_ptr<spdlog::logger> m_Logger;
@@ -0,0 +1,142 @@
+#include "Core/Include/JobSystem.h"
+#include "Core/Include/Profiler.h"
+#include <atomic>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<JobSystem> JobSystem::s_JobSystem;
+
+void JobSystem::Init()
+{
+    // Leave a core for the main thread, which also works through batches while it waits
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    unsigned workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+
+    s_JobSystem = std::make_shared<JobSystem>(workerCount);
+
+    MS_INFO("job system initialised with {0} workers", workerCount);
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    m_Workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        m_StopWorkers = true;
+    }
+
+    m_JobCondition.notify_all();
+
+    for (auto &worker : m_Workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const RangeFunction &function)
+{
+    MS_PROFILE_FUNCTION();
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    batchSize = std::max<size_t>(batchSize, 1);
+    size_t batchCount = (count + batchSize - 1) / batchSize;
+
+    if (batchCount == 1 || m_Workers.empty())
+    {
+        function(0, count);
+        return;
+    }
+
+    // Shared with the helper jobs, which can outlive this call by the time it takes them to notice there is
+    // nothing left to take
+    struct Batches
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    auto batches = std::make_shared<Batches>();
+    batches->remaining = batchCount;
+
+    const RangeFunction *target = &function;
+    auto runBatches = [batches, target, count, batchSize, batchCount]() {
+        for (size_t batch = batches->next++; batch < batchCount; batch = batches->next++)
+        {
+            size_t begin = batch * batchSize;
+            (*target)(begin, std::min(begin + batchSize, count));
+
+            if (--batches->remaining == 0)
+            {
+                std::lock_guard<std::mutex> lock(batches->mutex);
+                batches->done.notify_all();
+            }
+        }
+    };
+
+    size_t helperCount = std::min<size_t>(m_Workers.size(), batchCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        for (size_t i = 0; i < helperCount; ++i)
+        {
+            m_Jobs.emplace_back(runBatches);
+        }
+    }
+
+    m_JobCondition.notify_all();
+
+    runBatches();
+
+    std::unique_lock<std::mutex> lock(batches->mutex);
+    batches->done.wait(lock, [&batches]() { return batches->remaining == 0; });
+}
+
+void JobSystem::WorkerLoop()
+{
+    MS_PROFILE_THREAD("Job Worker");
+
+    while (true)
+    {
+        std::function<void()> job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_JobMutex);
+            m_JobCondition.wait(lock, [this]() { return m_StopWorkers || !m_Jobs.empty(); });
+
+            if (m_StopWorkers)
+            {
+                return;
+            }
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+
+        MS_PROFILE_SCOPE("Job");
+        job();
+    }
+}
+
+} // namespace Core
+
+} // namespace Moonstone
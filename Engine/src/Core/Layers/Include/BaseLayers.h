@@ -1,17 +1,25 @@
 #ifndef BASELAYERS_H
 #define BASELAYERS_H
 
+#include "Core/Events/Include/EventQueue.h"
+#include "Core/Include/FramePacer.h"
+#include "Core/Include/FrameStats.h"
 #include "Core/Include/Layer.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
 #include "Core/Include/Time.h"
 // #include "Rendering/Include/SceneManager.h"
+#include "Rendering/Include/GPUProfiler.h"
 #include "Rendering/Include/Lighting.h"
 #include "Rendering/Include/Model.h"
+#include "Rendering/Include/RenderTargetManager.h"
 #include "Rendering/Include/Scene.h"
 #include "imgui.h"
 #include <GLFW/glfw3.h>
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <string_view>
 
 namespace Moonstone
 {
@@ -33,15 +41,14 @@ class SceneLayer : public Layer
     {
         m_Window = window;
     }
-    void SetTexMap(unsigned &texMap)
+    void SetSceneTarget(unsigned sceneTarget)
     {
-        m_TexMap = texMap;
+        m_SceneTarget = sceneTarget;
     }
-    void SetFBParams(unsigned &FBShaderID, unsigned &screenQuadVAO, unsigned &FBOTexMap)
+    void SetFBParams(unsigned &FBShaderID, unsigned &screenQuadVAO)
     {
         m_FBShaderID = FBShaderID;
         m_ScreenQuadVAO = screenQuadVAO;
-        m_FBOTexMap = FBOTexMap;
     }
 
     virtual void OnImGuiRender() override
@@ -69,22 +76,24 @@ class SceneLayer : public Layer
         float xOffset = (winWidth - targetWidth) * 0.5f;
         float yOffset = (winHeight - targetHeight) * 0.5f;
 
-        Rendering::RenderingCommand::RescaleFramebuffer(m_TexMap, targetWidth, targetHeight);
-        Rendering::RenderingCommand::SetViewport(targetWidth, targetHeight);
+        // Only recorded here, the renderer reallocates the target at the start of its next frame if the size changed
+        auto &renderTargets = Rendering::RenderTargetManager::GetRenderTargetManagerInstance();
+        renderTargets->Resize(m_SceneTarget, targetWidth, targetHeight);
+        unsigned texMap = renderTargets->GetTarget(m_SceneTarget).colorTexture;
 
         ImVec2 pos = ImGui::GetCursorScreenPos();
         ImVec2 p0(pos.x + xOffset, pos.y + yOffset);
         ImVec2 p1(p0.x + targetWidth, p0.y + targetHeight);
 
-        ImGui::GetWindowDrawList()->AddImage(reinterpret_cast<void *>(m_TexMap), p0, p1, ImVec2(0, 1), ImVec2(1, 0));
+        ImGui::GetWindowDrawList()->AddImage(reinterpret_cast<void *>(texMap), p0, p1, ImVec2(0, 1), ImVec2(1, 0));
 
         ImGui::End();
     }
 
   private:
     GLFWwindow *m_Window;
-    unsigned m_TexMap;
-    unsigned m_FBShaderID, m_ScreenQuadVAO, m_FBOTexMap;
+    unsigned m_SceneTarget;
+    unsigned m_FBShaderID, m_ScreenQuadVAO;
 };
 
 class MenuLayer : public Layer
@@ -212,6 +221,7 @@ class TransformLayer : public Layer
     enum class SliderID
     {
         ObjectTransformGroup,
+        ObjectMaterialGroup,
         LightTransformGroup,
         ModelTransformGroup
     };
@@ -461,6 +471,21 @@ class TransformLayer : public Layer
 
                 m_SliderCallbacksObj[SliderID::ObjectTransformGroup](m_SelectedObject);
             }
+
+            ImGui::Text("Material");
+            ImGui::PushItemWidth(180);
+
+            // Only edits are pushed, the material table re-uploads just the changed entry
+            bool materialChanged = false;
+            materialChanged |= ImGui::ColorEdit3("Diffuse", &m_SelectedObject.material.diffuse.x);
+            materialChanged |= ImGui::ColorEdit3("Specular", &m_SelectedObject.material.specular.x);
+            materialChanged |=
+                ImGui::DragFloat("Shininess", &m_SelectedObject.material.shininess, 1.0f, 1.0f, 256.0f, "%.1f");
+
+            if (materialChanged && m_SliderCallbacksObj[SliderID::ObjectMaterialGroup])
+            {
+                m_SliderCallbacksObj[SliderID::ObjectMaterialGroup](m_SelectedObject);
+            }
         }
 
         if (!m_SelectedLight.id.empty())
@@ -883,11 +908,15 @@ class ControlsLayer : public Layer
         Exit,
         ApplyBGColor,
         ToggleWireframe,
+        ToggleDepthPrepass,
+        ToggleOcclusionCulling,
+        ToggleDynamicResolution,
         ApplyCameraSens,
         ToggleGrid,
         AddObject,
         AddDirectionalLight,
         AddPointLight,
+        AddPointLightGrid,
         AddModel
     };
 
@@ -1017,6 +1046,21 @@ class ControlsLayer : public Layer
             m_BtnCallbacks[ButtonID::ToggleWireframe]();
         }
 
+        if (ImGui::Button("Toggle Depth Pre-pass", btnSize) && m_BtnCallbacks[ButtonID::ToggleDepthPrepass])
+        {
+            m_BtnCallbacks[ButtonID::ToggleDepthPrepass]();
+        }
+
+        if (ImGui::Button("Toggle Occlusion Culling", btnSize) && m_BtnCallbacks[ButtonID::ToggleOcclusionCulling])
+        {
+            m_BtnCallbacks[ButtonID::ToggleOcclusionCulling]();
+        }
+
+        if (ImGui::Button("Toggle Dynamic Resolution", btnSize) && m_BtnCallbacks[ButtonID::ToggleDynamicResolution])
+        {
+            m_BtnCallbacks[ButtonID::ToggleDynamicResolution]();
+        }
+
         ImGui::Text("Lighting");
 
         if (ImGui::Button("Add Directional Light", btnSize) && m_BtnCallbacks[ButtonID::AddDirectionalLight])
@@ -1038,6 +1082,11 @@ class ControlsLayer : public Layer
             m_BtnCallbacks[ButtonID::AddPointLight]();
         }
 
+        if (ImGui::Button("Add Point Light Grid", btnSize) && m_BtnCallbacks[ButtonID::AddPointLightGrid])
+        {
+            m_BtnCallbacks[ButtonID::AddPointLightGrid]();
+        }
+
         ImGui::Text("Objects");
 
         if (ImGui::Button("Add Object", btnSize) && m_BtnCallbacks[ButtonID::AddObject])
@@ -1090,13 +1139,297 @@ class DebugLayer : public Layer
         ImGui::SetNextWindowSize({300, 100}, ImGuiCond_FirstUseEver);
 
         ImGui::Begin("Debug");
-        float fps = 1.0f / time.GetDeltaTime();
+
+        auto &frameStats = FrameStats::GetFrameStatsInstance();
+        const auto summary = frameStats->GetSummary();
+
+        // Averaged over the history window, the instantaneous rate jitters too much to read
+        float fps = summary.averageMilliseconds > 0.0f ? 1000.0f / summary.averageMilliseconds : 0.0f;
 
         ImGui::Text("FPS: %.2f", fps);
         ImGui::Text("Delta Time: %.4f seconds", time.GetDeltaTime());
+        ImGui::Text("Fixed Step: %.2f ms, %u this frame, alpha %.2f", time.GetFixedDeltaTime() * 1000.0f,
+                    time.GetFixedStepsLastFrame(), time.GetInterpolationAlpha());
+
+        ImGui::Separator();
+        ImGui::Text("Frame Times (last %zu)", summary.frameCount);
+        ImGui::Text("min %.2f  avg %.2f  max %.2f ms", summary.minMilliseconds, summary.averageMilliseconds,
+                    summary.maxMilliseconds);
+        ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f ms", summary.p50Milliseconds, summary.p95Milliseconds,
+                    summary.p99Milliseconds);
+        ImGui::Text("Hitches: %u in window, %llu total", summary.hitchCount,
+                    static_cast<unsigned long long>(summary.totalHitchCount));
+
+        float targetMilliseconds = frameStats->GetTargetMilliseconds();
+        if (ImGui::SliderFloat("Target (ms)", &targetMilliseconds, 4.0f, 50.0f))
+        {
+            frameStats->SetTargetMilliseconds(targetMilliseconds);
+        }
+
+        const auto &history = frameStats->GetHistory();
+        float plotMax = std::max(summary.maxMilliseconds, targetMilliseconds * 2.0f);
+        ImGui::PlotLines("##FrameTimes", history.data(), static_cast<int>(frameStats->GetHistoryCount()),
+                         static_cast<int>(frameStats->GetHistoryOffset()), nullptr, 0.0f, plotMax, ImVec2(0, 80));
+
+        if (ImGui::Button("Export Frame Stats", btnSize))
+        {
+            frameStats->ExportCSV("frame_stats.csv");
+        }
+
+        if (ImGui::Button("Reset Frame Stats", btnSize))
+        {
+            frameStats->Reset();
+        }
+
+        auto &pacer = FramePacer::GetFramePacerInstance();
+        static constexpr const char *paceStates[] = {"active", "unfocused", "minimized"};
+
+        ImGui::Separator();
+        ImGui::Text("Frame Pacing");
+        ImGui::Text("State: %s  Waited: %.2f ms  Sleep error: %.2f ms", paceStates[static_cast<int>(pacer->GetState())],
+                    pacer->GetLastWaitMilliseconds(), pacer->GetSleepEstimateMilliseconds());
+
+        // 0 leaves the rate to vsync
+        float targetFPS = pacer->GetTargetFPS();
+        if (ImGui::SliderFloat("Target FPS", &targetFPS, 0.0f, 240.0f, "%.0f"))
+        {
+            pacer->SetTargetFPS(targetFPS);
+        }
+
+        float unfocusedFPS = pacer->GetUnfocusedFPS();
+        if (ImGui::SliderFloat("Unfocused FPS", &unfocusedFPS, 1.0f, 60.0f, "%.0f"))
+        {
+            pacer->SetUnfocusedFPS(unfocusedFPS);
+        }
+
+        bool vsync = pacer->GetVSync();
+        if (ImGui::Checkbox("VSync", &vsync))
+        {
+            pacer->SetVSync(vsync);
+        }
+
+        ImGui::SameLine();
+
+        bool idleThrottling = pacer->IsIdleThrottling();
+        if (ImGui::Checkbox("Throttle When Idle", &idleThrottling))
+        {
+            pacer->SetIdleThrottling(idleThrottling);
+        }
+
+        auto &eventQueue = EventQueue::GetEventQueueInstance();
+
+        ImGui::Separator();
+        ImGui::Text("Events");
+        ImGui::Text("Queue capacity: %zu  Posted last frame: %u / %zu  Dropped posts: %llu", eventQueue->GetCapacity(),
+                    eventQueue->GetPostedLastFrame(), eventQueue->GetPostedCapacity(),
+                    static_cast<unsigned long long>(eventQueue->GetDroppedPosts()));
+
+        auto &streamer = Rendering::TextureStreamer::GetTextureStreamerInstance();
+        const auto &stats = streamer->GetStats();
+        constexpr float mb = 1024.0f * 1024.0f;
+
+        ImGui::Separator();
+        ImGui::Text("Texture Streaming");
+        ImGui::Text("Resident: %.1f / %.1f MB (peak %.1f MB)", stats.residentBytes / mb, stats.budgetBytes / mb,
+                    stats.peakResidentBytes / mb);
+        ImGui::Text("Textures: %u in %u arrays (%u full res)", stats.textureCount, stats.arrayCount,
+                    stats.fullyResidentCount);
+        ImGui::Text("Pending: %u  Uploaded: %.2f MB  Evicted mips: %u", stats.pendingRequests,
+                    stats.uploadedBytesLastFrame / mb, stats.evictedMips);
+
+        int budgetMB = static_cast<int>(streamer->GetBudget() / (1024 * 1024));
+        if (ImGui::SliderInt("Budget (MB)", &budgetMB, 16, 4096))
+        {
+            streamer->SetBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+        }
+
+        const auto &renderStats = Rendering::RenderingCommand::GetLastFrameStats();
+
+        ImGui::Separator();
+        ImGui::Text("Rendering");
+        ImGui::Text("Draws: %u (%u indirect)  Triangles: %llu", renderStats.drawCalls, renderStats.indirectDraws,
+                    static_cast<unsigned long long>(renderStats.triangles));
+        ImGui::Text("Programs: %u  State: %u  Uniforms: %u  Dispatches: %u", renderStats.programSwitches,
+                    renderStats.stateChanges, renderStats.uniformUploads, renderStats.computeDispatches);
+        ImGui::Text("Binds: %u buffer, %u vertex array, %u texture, %u framebuffer", renderStats.bufferBinds,
+                    renderStats.vertexArrayBinds, renderStats.textureBinds, renderStats.framebufferBinds);
+        ImGui::Text("Uploads: %u buffer (%.2f KB), %u texture", renderStats.bufferUploads,
+                    renderStats.uploadedBytes / 1024.0f, renderStats.textureUploads);
+
+        auto &memoryTracker = MemoryTracker::GetMemoryTrackerInstance();
+
+        ImGui::Separator();
+        ImGui::Text("Memory");
+        ImGui::Text("Heap allocations last frame: %llu%s",
+                    static_cast<unsigned long long>(memoryTracker->GetAllocationsLastFrame()),
+                    MemoryTracker::IsTrackingAllocations() ? "" : " (tracking compiled out)");
+        ImGui::Text("GPU: %.1f MB buffers, %.1f MB textures",
+                    memoryTracker->GetGPUBytes(MemoryTracker::GPUResourceType::Buffer) / mb,
+                    memoryTracker->GetGPUBytes(MemoryTracker::GPUResourceType::Texture) / mb);
+        ImGui::Text("%-14s %9s %9s %8s %9s", "Tag", "Live MB", "Peak MB", "Allocs", "GPU MB");
+
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+        {
+            MemoryTag tag = static_cast<MemoryTag>(i);
+            const auto tagStats = memoryTracker->GetTagStats(tag);
+
+            ImGui::Text("%-14s %9.2f %9.2f %8llu %9.2f", MemoryTracker::GetTagName(tag), tagStats.liveBytes / mb,
+                        tagStats.peakBytes / mb, static_cast<unsigned long long>(tagStats.allocationsLastFrame),
+                        tagStats.gpuBytes / mb);
+        }
+
+        if (ImGui::Button("Take Memory Snapshot", btnSize))
+        {
+            m_MemorySnapshot = memoryTracker->TakeSnapshot();
+            m_HasMemorySnapshot = true;
+        }
+
+        // Diffs against the last snapshot, so leaks and churn show up between two points the user picks
+        if (m_HasMemorySnapshot && ImGui::Button("Dump Memory Diff", btnSize))
+        {
+            memoryTracker->WriteSnapshotDiff(m_MemorySnapshot, "memory_diff.csv");
+        }
+
+        auto &gpuProfiler = Rendering::GPUProfiler::GetGPUProfilerInstance();
+        const auto &gpuFrame = gpuProfiler->GetFrameTiming();
+
+        ImGui::Separator();
+        ImGui::Text("GPU Timings");
+        ImGui::Text("GPU: %.3f ms avg (%.3f - %.3f)  CPU: %.3f ms", gpuFrame.averageMilliseconds,
+                    gpuFrame.minMilliseconds, gpuFrame.maxMilliseconds, time.GetDeltaTime() * 1000.0f);
+
+        for (const auto &pass : gpuProfiler->GetPasses())
+        {
+            ImGui::Text("%*s%-14s %.3f ms (avg %.3f)", pass.depth * 2, "", pass.name.c_str(), pass.lastMilliseconds,
+                        pass.averageMilliseconds);
+        }
+
+        if (ImGui::Button("Export GPU Timings", btnSize))
+        {
+            gpuProfiler->ExportJSON("gpu_timings.json");
+        }
 
         ImGui::End();
     };
+
+  private:
+    MemoryTracker::Snapshot m_MemorySnapshot;
+    bool m_HasMemorySnapshot = false;
+};
+
+class ProfilerLayer : public Layer
+{
+  public:
+    ProfilerLayer() : Layer("Profiler")
+    {
+    }
+
+    void OnUpdate() override
+    {
+    }
+
+    virtual void OnImGuiRender() override
+    {
+        auto &profiler = Profiler::GetProfilerInstance();
+
+        ImGui::SetNextWindowSize({600, 300}, ImGuiCond_FirstUseEver);
+        ImGui::Begin("Profiler");
+
+        ImGui::Checkbox("Pause", &m_Paused);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120);
+        ImGui::SliderInt("Frames", &m_ExportFrames, 1, 240);
+        ImGui::SameLine();
+
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            profiler->ExportChromeTrace("profile_trace.json", static_cast<size_t>(m_ExportFrames));
+        }
+
+        if (!m_Paused)
+        {
+            auto frames = profiler->GetRecentFrames(1);
+            if (!frames.empty())
+            {
+                m_Frame = frames.back();
+                m_Threads = profiler->CollectEvents(m_Frame.start, m_Frame.end);
+            }
+        }
+
+        float frameMilliseconds = (m_Frame.end - m_Frame.start) / 1000000.0f;
+        ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(m_Frame.frame), frameMilliseconds);
+
+        for (const auto &thread : m_Threads)
+        {
+            DrawThread(thread);
+        }
+
+        ImGui::End();
+    }
+
+  private:
+    // One row per nesting depth, each scope drawn to scale across the frame
+    void DrawThread(const Profiler::ThreadEvents &thread)
+    {
+        constexpr float rowHeight = 18.0f;
+
+        uint32_t maxDepth = 0;
+        for (const auto &event : thread.events)
+        {
+            maxDepth = std::max(maxDepth, event.depth);
+        }
+
+        ImGui::Text("%s", thread.threadName.c_str());
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+        float height = (maxDepth + 1) * rowHeight;
+        double frameLength = static_cast<double>(std::max<uint64_t>(m_Frame.end - m_Frame.start, 1));
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        ImVec2 mouse = ImGui::GetMousePos();
+
+        for (const auto &event : thread.events)
+        {
+            uint64_t start = std::max(event.start, m_Frame.start);
+            uint64_t end = std::min(event.end, m_Frame.end);
+
+            float x0 = origin.x + static_cast<float>((start - m_Frame.start) / frameLength) * width;
+            float x1 = origin.x + static_cast<float>((end - m_Frame.start) / frameLength) * width;
+            x1 = std::max(x1, x0 + 1.0f);
+
+            float y0 = origin.y + event.depth * rowHeight;
+            ImVec2 p0(x0, y0);
+            ImVec2 p1(x1, y0 + rowHeight - 1.0f);
+
+            // Same name, same colour, so repeated scopes are easy to follow between frames
+            size_t hash = std::hash<std::string_view>()(event.name);
+            ImU32 colour = IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120, 80 + (hash >> 16) % 120, 255);
+
+            drawList->AddRectFilled(p0, p1, colour);
+
+            if (x1 - x0 > 30.0f)
+            {
+                drawList->PushClipRect(p0, p1, true);
+                drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), event.name);
+                drawList->PopClipRect();
+            }
+
+            if (mouse.x >= p0.x && mouse.x < p1.x && mouse.y >= p0.y && mouse.y < p1.y)
+            {
+                ImGui::SetTooltip("%s: %.3f ms", event.name, (event.end - event.start) / 1000000.0f);
+            }
+        }
+
+        ImGui::Dummy(ImVec2(width, height));
+    }
+
+  private:
+    bool m_Paused = false;
+    int m_ExportFrames = 60;
+
+    Profiler::FrameRange m_Frame = {};
+    std::vector<Profiler::ThreadEvents> m_Threads;
 };
 
 } // namespace Core
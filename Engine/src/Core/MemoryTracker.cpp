@@ -0,0 +1,410 @@
+#include "Include/MemoryTracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+using Moonstone::Core::MemoryTag;
+using Moonstone::Core::MemoryTracker;
+
+thread_local MemoryTag s_CurrentTag = MemoryTag::General;
+
+#ifdef MS_ENABLE_MEMORY_TRACKING
+struct AllocationHeader
+{
+    size_t size;
+    MemoryTag tag;
+};
+
+// A whole max_align_t so the pointer handed out keeps malloc's alignment
+constexpr size_t s_HeaderSize = alignof(std::max_align_t);
+static_assert(sizeof(AllocationHeader) <= s_HeaderSize, "allocation header has outgrown its slot");
+
+void *TrackedAllocate(size_t size)
+{
+    auto *header = static_cast<AllocationHeader *>(std::malloc(s_HeaderSize + size));
+    if (!header)
+        return nullptr;
+
+    header->size = size;
+    header->tag = s_CurrentTag;
+    MemoryTracker::RecordAllocation(header->tag, size);
+
+    return reinterpret_cast<char *>(header) + s_HeaderSize;
+}
+
+void TrackedFree(void *pointer)
+{
+    if (!pointer)
+        return;
+
+    auto *header = reinterpret_cast<AllocationHeader *>(static_cast<char *>(pointer) - s_HeaderSize);
+    MemoryTracker::RecordFree(header->tag, header->size);
+
+    std::free(header);
+}
+#endif
+
+} // namespace
+
+#ifdef MS_ENABLE_MEMORY_TRACKING
+// Over-aligned new and delete are left to the standard library, they pair with each other and never reach these
+void *operator new(size_t size)
+{
+    if (void *pointer = TrackedAllocate(size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    TrackedFree(pointer);
+}
+#endif
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<MemoryTracker> MemoryTracker::s_MemoryTracker;
+std::array<MemoryTracker::TagCounters, static_cast<size_t>(MemoryTag::Count)> MemoryTracker::s_Counters;
+
+void MemoryTracker::Init()
+{
+    s_MemoryTracker = std::make_shared<MemoryTracker>();
+
+    // Startup allocations shouldn't show up as the first frame's churn
+    s_MemoryTracker->EndFrame();
+
+    MS_INFO("memory tracker initialised, heap tracking {0}", IsTrackingAllocations() ? "on" : "off");
+}
+
+const char *MemoryTracker::GetTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::General:
+        return "General";
+    case MemoryTag::Meshes:
+        return "Meshes";
+    case MemoryTag::Textures:
+        return "Textures";
+    case MemoryTag::RenderTargets:
+        return "RenderTargets";
+    case MemoryTag::UI:
+        return "UI";
+    case MemoryTag::Events:
+        return "Events";
+    default:
+        return "Unknown";
+    }
+}
+
+const char *MemoryTracker::GetGPUResourceTypeName(GPUResourceType type)
+{
+    switch (type)
+    {
+    case GPUResourceType::Buffer:
+        return "Buffer";
+    case GPUResourceType::Texture:
+        return "Texture";
+    default:
+        return "Unknown";
+    }
+}
+
+MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+{
+    MemoryTag previous = s_CurrentTag;
+    s_CurrentTag = tag;
+    return previous;
+}
+
+MemoryTag MemoryTracker::GetCurrentTag()
+{
+    return s_CurrentTag;
+}
+
+void MemoryTracker::RecordAllocation(MemoryTag tag, size_t size)
+{
+    TagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+
+    counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalBytes.fetch_add(size, std::memory_order_relaxed);
+    counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemoryTracker::RecordFree(MemoryTag tag, size_t size)
+{
+    TagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+
+    counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::GetAllocationCount()
+{
+    uint64_t count = 0;
+    for (const auto &counters : s_Counters)
+    {
+        count += counters.totalAllocations.load(std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+uint64_t MemoryTracker::GetAllocatedBytes()
+{
+    uint64_t bytes = 0;
+    for (const auto &counters : s_Counters)
+    {
+        bytes += counters.totalBytes.load(std::memory_order_relaxed);
+    }
+
+    return bytes;
+}
+
+void MemoryTracker::EndFrame()
+{
+    m_AllocationsLastFrame = 0;
+
+    for (size_t i = 0; i < s_Counters.size(); ++i)
+    {
+        uint64_t total = s_Counters[i].totalAllocations.load(std::memory_order_relaxed);
+
+        m_LastFrameAllocations[i] = total - m_FrameStartAllocations[i];
+        m_FrameStartAllocations[i] = total;
+        m_AllocationsLastFrame += m_LastFrameAllocations[i];
+    }
+
+    ++m_Frame;
+}
+
+MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag) const
+{
+    size_t index = static_cast<size_t>(tag);
+    const TagCounters &counters = s_Counters[index];
+
+    TagStats stats;
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+    stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+    stats.allocationsLastFrame = m_LastFrameAllocations[index];
+    stats.gpuBytes = m_GPUTagBytes[index];
+    stats.gpuResources = m_GPUTagResources[index];
+
+    return stats;
+}
+
+uint64_t MemoryTracker::GPUResourceKey(GPUResourceType type, unsigned id)
+{
+    return (static_cast<uint64_t>(type) << 32) | id;
+}
+
+void MemoryTracker::TrackGPUResource(GPUResourceType type, unsigned id, size_t bytes)
+{
+    if (id == 0)
+        return;
+
+    auto [it, created] = m_GPUResources.try_emplace(GPUResourceKey(type, id), GPUResource{type, id, s_CurrentTag, 0});
+    GPUResource &resource = it->second;
+
+    size_t tag = static_cast<size_t>(resource.tag);
+    size_t typeIndex = static_cast<size_t>(type);
+
+    m_GPUTagBytes[tag] = m_GPUTagBytes[tag] - resource.bytes + bytes;
+    m_GPUTypeBytes[typeIndex] = m_GPUTypeBytes[typeIndex] - resource.bytes + bytes;
+    resource.bytes = bytes;
+
+    if (created)
+        ++m_GPUTagResources[tag];
+}
+
+void MemoryTracker::ReleaseGPUResource(GPUResourceType type, unsigned id)
+{
+    auto it = m_GPUResources.find(GPUResourceKey(type, id));
+    if (it == m_GPUResources.end())
+        return;
+
+    const GPUResource &resource = it->second;
+    size_t tag = static_cast<size_t>(resource.tag);
+
+    m_GPUTagBytes[tag] -= resource.bytes;
+    m_GPUTypeBytes[static_cast<size_t>(type)] -= resource.bytes;
+    --m_GPUTagResources[tag];
+
+    m_GPUResources.erase(it);
+}
+
+size_t MemoryTracker::ReportLiveGPUResources() const
+{
+    size_t liveBytes = 0;
+
+    for (size_t i = 0; i < m_GPUTagBytes.size(); ++i)
+    {
+        if (m_GPUTagResources[i] == 0)
+            continue;
+
+        MS_WARN("{0} GPU resources under {1} not released at shutdown: {2} bytes", m_GPUTagResources[i],
+                GetTagName(static_cast<MemoryTag>(i)), m_GPUTagBytes[i]);
+        liveBytes += m_GPUTagBytes[i];
+    }
+
+    return liveBytes;
+}
+
+MemoryTracker::Snapshot MemoryTracker::TakeSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.frame = m_Frame;
+
+    for (size_t i = 0; i < snapshot.tags.size(); ++i)
+    {
+        snapshot.tags[i] = GetTagStats(static_cast<MemoryTag>(i));
+    }
+
+    snapshot.gpuResources.reserve(m_GPUResources.size());
+    for (const auto &[key, resource] : m_GPUResources)
+    {
+        snapshot.gpuResources.push_back(resource);
+    }
+
+    return snapshot;
+}
+
+bool MemoryTracker::WriteSnapshotDiff(const Snapshot &before, const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} for the memory snapshot diff", path);
+        return false;
+    }
+
+    Snapshot after = TakeSnapshot();
+
+    file << "frames," << before.frame << "," << after.frame << "\n";
+    file << "\ntag,live_bytes,live_bytes_delta,live_allocations_delta,allocations_between,peak_bytes,gpu_bytes,"
+            "gpu_bytes_delta,gpu_resources_delta\n";
+
+    for (size_t i = 0; i < after.tags.size(); ++i)
+    {
+        const TagStats &from = before.tags[i];
+        const TagStats &to = after.tags[i];
+
+        file << GetTagName(static_cast<MemoryTag>(i)) << "," << to.liveBytes << ","
+             << static_cast<int64_t>(to.liveBytes - from.liveBytes) << ","
+             << static_cast<int64_t>(to.liveAllocations - from.liveAllocations) << ","
+             << to.totalAllocations - from.totalAllocations << "," << to.peakBytes << "," << to.gpuBytes << ","
+             << static_cast<int64_t>(to.gpuBytes - from.gpuBytes) << ","
+             << static_cast<int>(to.gpuResources) - static_cast<int>(from.gpuResources) << "\n";
+    }
+
+    std::unordered_map<uint64_t, size_t> previousBytes;
+    for (const auto &resource : before.gpuResources)
+    {
+        previousBytes[GPUResourceKey(resource.type, resource.id)] = resource.bytes;
+    }
+
+    struct Change
+    {
+        const char *status;
+        GPUResource resource;
+        size_t previous;
+    };
+
+    std::vector<Change> changes;
+    for (const auto &resource : after.gpuResources)
+    {
+        auto it = previousBytes.find(GPUResourceKey(resource.type, resource.id));
+
+        if (it == previousBytes.end())
+        {
+            changes.push_back({"new", resource, 0});
+        }
+        else
+        {
+            if (it->second != resource.bytes)
+                changes.push_back({"resized", resource, it->second});
+
+            previousBytes.erase(it);
+        }
+    }
+
+    for (const auto &resource : before.gpuResources)
+    {
+        if (previousBytes.count(GPUResourceKey(resource.type, resource.id)))
+            changes.push_back({"released", {resource.type, resource.id, resource.tag, 0}, resource.bytes});
+    }
+
+    // Whatever grew the most is the most likely leak
+    std::sort(changes.begin(), changes.end(), [](const Change &a, const Change &b) {
+        return std::max(a.resource.bytes, a.previous) > std::max(b.resource.bytes, b.previous);
+    });
+
+    file << "\nstatus,type,id,tag,bytes,previous_bytes\n";
+    for (const auto &change : changes)
+    {
+        file << change.status << "," << GetGPUResourceTypeName(change.resource.type) << "," << change.resource.id << ","
+             << GetTagName(change.resource.tag) << "," << change.resource.bytes << "," << change.previous << "\n";
+    }
+
+    MS_INFO("memory diff over {0} frames written to {1}, {2} GPU resources changed", after.frame - before.frame, path,
+            changes.size());
+    return true;
+}
+
+} // namespace Core
+
+} // namespace Moonstone
@@ -0,0 +1,206 @@
+#include "Include/Profiler.h"
+#include <iomanip>
+
+namespace Moonstone
+{
+
+namespace Core
+{
+
+std::shared_ptr<Profiler> Profiler::s_Profiler;
+
+void Profiler::Init()
+{
+    s_Profiler = std::make_shared<Profiler>();
+    SetThreadName("Main");
+
+    MS_INFO("profiler initialised");
+}
+
+Profiler::ThreadBuffer *Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+
+    if (!buffer && s_Profiler)
+    {
+        std::lock_guard<std::mutex> lock(s_Profiler->m_ThreadMutex);
+
+        auto &threads = s_Profiler->m_Threads;
+        threads.push_back(std::make_unique<ThreadBuffer>());
+
+        buffer = threads.back().get();
+        buffer->index = static_cast<unsigned>(threads.size() - 1);
+        buffer->name = "Thread " + std::to_string(buffer->index);
+    }
+
+    return buffer;
+}
+
+void Profiler::SetThreadName(const std::string &name)
+{
+    ThreadBuffer *buffer = GetThreadBuffer();
+    if (!buffer)
+        return;
+
+    std::lock_guard<std::mutex> lock(s_Profiler->m_ThreadMutex);
+    buffer->name = name;
+}
+
+uint32_t Profiler::BeginScope()
+{
+    ThreadBuffer *buffer = GetThreadBuffer();
+
+    return buffer ? buffer->depth++ : 0;
+}
+
+void Profiler::EndScope(const char *name, uint64_t start, uint32_t depth)
+{
+    ThreadBuffer *buffer = GetThreadBuffer();
+    if (!buffer)
+        return;
+
+    buffer->depth = depth;
+
+    uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+    buffer->events[index % s_ThreadBufferSize] = {name, start, Time::Now(), depth};
+    buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame()
+{
+    m_FrameStarts[m_FrameCount % s_FrameHistory] = Time::Now();
+    ++m_FrameCount;
+}
+
+std::vector<Profiler::FrameRange> Profiler::GetRecentFrames(size_t count) const
+{
+    std::vector<FrameRange> frames;
+
+    // The newest frame is still running, and its start is the end of the one before
+    if (m_FrameCount < 2)
+        return frames;
+
+    uint64_t available = std::min<uint64_t>(m_FrameCount - 1, s_FrameHistory - 1);
+    uint64_t frameCount = std::min<uint64_t>(count, available);
+
+    for (uint64_t frame = m_FrameCount - 1 - frameCount; frame < m_FrameCount - 1; ++frame)
+    {
+        frames.push_back({frame, m_FrameStarts[frame % s_FrameHistory], m_FrameStarts[(frame + 1) % s_FrameHistory]});
+    }
+
+    return frames;
+}
+
+std::vector<Profiler::ThreadEvents> Profiler::CollectEvents(uint64_t start, uint64_t end) const
+{
+    std::vector<ThreadEvents> threads;
+    std::lock_guard<std::mutex> lock(m_ThreadMutex);
+
+    for (const auto &buffer : m_Threads)
+    {
+        ThreadEvents thread;
+        thread.threadName = buffer->name;
+        thread.threadIndex = buffer->index;
+
+        std::vector<uint64_t> indices;
+
+        uint64_t writeIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t oldest = writeIndex > s_ThreadBufferSize ? writeIndex - s_ThreadBufferSize : 0;
+
+        // Events are written as scopes close, so end times only grow and the walk can stop at the first one too old
+        for (uint64_t index = writeIndex; index > oldest; --index)
+        {
+            const ProfileEvent &event = buffer->events[(index - 1) % s_ThreadBufferSize];
+
+            if (event.end < start)
+                break;
+
+            if (event.start < end)
+            {
+                thread.events.push_back(event);
+                indices.push_back(index - 1);
+            }
+        }
+
+        // Anything the writer has since wrapped over may be torn
+        uint64_t newestWrite = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t firstValid = newestWrite > s_ThreadBufferSize ? newestWrite - s_ThreadBufferSize : 0;
+
+        while (!indices.empty() && indices.back() < firstValid)
+        {
+            indices.pop_back();
+            thread.events.pop_back();
+        }
+
+        if (!thread.events.empty())
+        {
+            std::reverse(thread.events.begin(), thread.events.end());
+            threads.push_back(std::move(thread));
+        }
+    }
+
+    return threads;
+}
+
+bool Profiler::ExportChromeTrace(const std::string &path, size_t frameCount) const
+{
+    auto frames = GetRecentFrames(frameCount);
+    if (frames.empty())
+    {
+        MS_WARN("no finished frames to export a trace from");
+        return false;
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} for the profiler trace", path);
+        return false;
+    }
+
+    auto threads = CollectEvents(frames.front().start, frames.back().end);
+
+    // Trace event timestamps are microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+    bool first = true;
+    auto separator = [&file, &first]() {
+        file << (first ? "  " : ",\n  ");
+        first = false;
+    };
+
+    for (const auto &thread : threads)
+    {
+        separator();
+        file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << thread.threadIndex
+             << ", \"args\": {\"name\": \"" << thread.threadName << "\"}}";
+    }
+
+    for (const auto &frame : frames)
+    {
+        separator();
+        file << "{\"name\": \"Frame " << frame.frame << "\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 0, \"tid\": 0"
+             << ", \"ts\": " << frame.start / 1000.0 << "}";
+    }
+
+    for (const auto &thread : threads)
+    {
+        for (const auto &event : thread.events)
+        {
+            separator();
+            file << "{\"name\": \"" << event.name << "\", \"cat\": \"cpu\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                 << thread.threadIndex << ", \"ts\": " << event.start / 1000.0
+                 << ", \"dur\": " << (event.end - event.start) / 1000.0 << "}";
+        }
+    }
+
+    file << "\n]}\n";
+
+    MS_INFO("profiler trace of {0} frames written to {1}", frames.size(), path);
+    return true;
+}
+
+} // namespace Core
+
+} // namespace Moonstone
@@ -1,4 +1,6 @@
 #include "Include/Window.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
 #include "mspch.h"
 
 namespace Moonstone
@@ -7,10 +9,11 @@ namespace Moonstone
 namespace Core
 {
 
-WindowProperties::WindowProperties(const std::string Title, unsigned Width, unsigned Height)
+WindowProperties::WindowProperties(const std::string Title, unsigned Width, unsigned Height, bool Headless)
     : Title(Title)
     , Width(Width)
     , Height(Height)
+    , Headless(Headless)
 {
 }
 
@@ -40,41 +43,102 @@ Window::~Window() { glfwTerminate(); }
 
 void Window::UpdateWindow(std::shared_ptr<Window> window)
 {
+    MS_PROFILE_FUNCTION();
+    MS_MEMORY_TAG(Events);
+
     glfwSwapBuffers(window->m_Window);
     glfwPollEvents();
     window->m_EventQueue->Process();
 }
 
+void Window::FixedUpdate(float deltaTime)
+{
+    if (!m_CameraController)
+        return;
+
+    m_CameraController->BeginFixedStep();
+
+    if (!m_CameraController->GetConnected())
+        return;
+
+    if (m_MovementKeys.forward)
+        m_CameraController->OnMoveForward(deltaTime);
+    if (m_MovementKeys.backward)
+        m_CameraController->OnMoveBackward(deltaTime);
+    if (m_MovementKeys.left)
+        m_CameraController->OnMoveLeft(deltaTime);
+    if (m_MovementKeys.right)
+        m_CameraController->OnMoveRight(deltaTime);
+}
+
+void Window::SetMovementKey(int key, bool held)
+{
+    switch (key)
+    {
+        case GLFW_KEY_W:
+            m_MovementKeys.forward = held;
+            break;
+        case GLFW_KEY_S:
+            m_MovementKeys.backward = held;
+            break;
+        case GLFW_KEY_A:
+            m_MovementKeys.left = held;
+            break;
+        case GLFW_KEY_D:
+            m_MovementKeys.right = held;
+            break;
+    }
+}
+
+void Window::WaitForEvents(std::shared_ptr<Window> window, double timeoutSeconds)
+{
+    MS_PROFILE_FUNCTION();
+    MS_MEMORY_TAG(Events);
+
+    glfwWaitEventsTimeout(timeoutSeconds);
+    window->m_EventQueue->Process();
+}
+
 bool Window::InitializeWindow(const WindowProperties &windowProperties)
 {
     m_WindowData.windowProperties.Title  = windowProperties.Title;
     m_WindowData.windowProperties.Width  = windowProperties.Width;
     m_WindowData.windowProperties.Height = windowProperties.Height;
+    m_WindowData.windowProperties.Headless = windowProperties.Headless;
 
     glfwSetErrorCallback(ReportGLFWError);
 
-    if (!glfwInit())
+    if (m_WindowData.windowProperties.Headless)
     {
-        MS_ERROR("glfw initialization failed");
-        return false;
+        if (!InitializeHeadlessContext())
+            return false;
     }
-
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
+    else
     {
-        MS_INFO("creating window: {0} - {1}x{2}",
-                m_WindowData.windowProperties.Title,
-                m_WindowData.windowProperties.Width,
-                m_WindowData.windowProperties.Height);
+        if (!glfwInit())
+        {
+            MS_ERROR("glfw initialization failed");
+            return false;
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        {
+            MS_INFO("creating window: {0} - {1}x{2}",
+                    m_WindowData.windowProperties.Title,
+                    m_WindowData.windowProperties.Width,
+                    m_WindowData.windowProperties.Height);
+        }
+
+        m_Window = glfwCreateWindow((int) m_WindowData.windowProperties.Width,
+                                    (int) m_WindowData.windowProperties.Height,
+                                    m_WindowData.windowProperties.Title.c_str(),
+                                    nullptr,
+                                    nullptr);
     }
 
-    m_Window = glfwCreateWindow((int) m_WindowData.windowProperties.Width,
-                                (int) m_WindowData.windowProperties.Height,
-                                m_WindowData.windowProperties.Title.c_str(),
-                                nullptr,
-                                nullptr);
     if (!m_Window)
     {
         MS_ERROR("window initialization failed");
@@ -95,14 +159,71 @@ bool Window::InitializeWindow(const WindowProperties &windowProperties)
         return false;
     }
 
-    glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
     m_GraphicsContext->Init();
-    SetVSync(true);
+
+    // Nothing is presented headless, so frames shouldn't wait on a display's refresh
+    if (m_WindowData.windowProperties.Headless)
+    {
+        SetVSync(false);
+    }
+    else
+    {
+        glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+        SetVSync(true);
+    }
 
     return true;
 }
 
+bool Window::InitializeHeadlessContext()
+{
+    int width = (int) m_WindowData.windowProperties.Width;
+    int height = (int) m_WindowData.windowProperties.Height;
+
+    MS_INFO("creating headless context: {0}x{1}", width, height);
+
+    // An invisible window still gets a normal hardware context wherever there's a display to create it on
+    if (glfwInit())
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        m_Window = glfwCreateWindow(width, height, m_WindowData.windowProperties.Title.c_str(), nullptr, nullptr);
+        if (m_Window)
+            return true;
+
+        glfwTerminate();
+    }
+
+#ifdef GLFW_PLATFORM_NULL
+    // Display-less machines fall back to GLFW's null platform with an OSMesa context, which Mesa backs with llvmpipe.
+    // llvmpipe doesn't always expose 4.6, but nothing the renderer uses needs more than 4.5
+    MS_WARN("no display for a hidden window, falling back to an OSMesa context");
+
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
+    if (!glfwInit())
+    {
+        MS_ERROR("glfw null platform initialization failed");
+        return false;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    m_Window = glfwCreateWindow(width, height, m_WindowData.windowProperties.Title.c_str(), nullptr, nullptr);
+    return m_Window != nullptr;
+#else
+    MS_ERROR("no display for a hidden window, and this glfw has no null platform to fall back to");
+    return false;
+#endif
+}
+
 void Window::SetVSync(bool vSyncEnabled)
 {
     if (vSyncEnabled)
@@ -122,33 +243,29 @@ void Window::SetupInputCallbacks(GLFWwindow *window)
     glfwSetKeyCallback(m_Window,
                        [](GLFWwindow *window, int key, int scancode, int action, int mods)
                        {
-                           auto  event      = std::make_shared<KeyPressEvent>(key, action, mods);
                            auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                           eventQueue->Enqueue(event);
+                           eventQueue->Enqueue(KeyPressEvent(key, action, mods));
                        });
 
     glfwSetMouseButtonCallback(m_Window,
                                [](GLFWwindow *window, int button, int action, int mods)
                                {
-                                   auto  event      = std::make_shared<MouseButtonPressEvent>(button, action, mods);
                                    auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                   eventQueue->Enqueue(event);
+                                   eventQueue->Enqueue(MouseButtonPressEvent(button, action, mods));
                                });
 
     glfwSetScrollCallback(m_Window,
                           [](GLFWwindow *window, double xOffset, double yOffset)
                           {
-                              auto  event      = std::make_shared<MouseScrollEvent>(xOffset, yOffset);
                               auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                              eventQueue->Enqueue(event);
+                              eventQueue->Enqueue(MouseScrollEvent(xOffset, yOffset));
                           });
 
     glfwSetCursorPosCallback(m_Window,
                              [](GLFWwindow *window, double xPosition, double yPosition)
                              {
-                                 auto  event      = std::make_shared<MouseMoveEvent>(xPosition, yPosition);
                                  auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                 eventQueue->Enqueue(event);
+                                 eventQueue->Enqueue(MouseMoveEvent(xPosition, yPosition));
                              });
 }
 
@@ -157,33 +274,29 @@ void Window::SetupWindowCallbacks(GLFWwindow *window)
     glfwSetWindowCloseCallback(m_Window,
                                [](GLFWwindow *window)
                                {
-                                   auto  event      = std::make_shared<WindowCloseEvent>();
                                    auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                   eventQueue->Enqueue(event);
+                                   eventQueue->Enqueue(WindowCloseEvent());
                                });
 
     glfwSetWindowSizeCallback(m_Window,
                               [](GLFWwindow *window, int width, int height)
                               {
-                                  auto  event      = std::make_shared<WindowResizeEvent>(width, height);
                                   auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                  eventQueue->Enqueue(event);
+                                  eventQueue->Enqueue(WindowResizeEvent(width, height));
                               });
 
     glfwSetWindowIconifyCallback(m_Window,
                                  [](GLFWwindow *window, int minimized)
                                  {
-                                     auto  event      = std::make_shared<WindowMinimizeEvent>(minimized);
                                      auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                     eventQueue->Enqueue(event);
+                                     eventQueue->Enqueue(WindowMinimizeEvent(minimized));
                                  });
 
     glfwSetWindowFocusCallback(m_Window,
                                [](GLFWwindow *window, int focused)
                                {
-                                   auto  event      = std::make_shared<WindowFocusEvent>(focused);
                                    auto *eventQueue = static_cast<EventQueue *>(glfwGetWindowUserPointer(window));
-                                   eventQueue->Enqueue(event);
+                                   eventQueue->Enqueue(WindowFocusEvent(focused));
                                });
 }
 
@@ -198,235 +311,193 @@ void Window::TerminateWindow()
 {
     glfwSetWindowShouldClose(m_Window, true);
 
-    for (auto &event : m_SubscribedWindowEvents)
+    for (auto &subscription : m_WindowSubscriptions)
     {
-        m_EventDispatcher->Unsubscribe(event);
+        m_EventDispatcher->Unsubscribe(subscription);
     }
+
+    m_WindowSubscriptions.clear();
+
+    m_EventQueue->ClearCoalescing(MouseMoveEvent::s_Type);
+    m_EventQueue->ClearCoalescing(MouseScrollEvent::s_Type);
+    m_EventQueue->ClearCoalescing(WindowResizeEvent::s_Type);
 }
 
 void Window::SetupInitEvents()
 {
-    m_EventDispatcher->Subscribe(typeid(KeyPressEvent),
-                                 [this](std::shared_ptr<Event> event)
-                                 {
-                                     auto keyEvent = std::static_pointer_cast<KeyPressEvent>(event);
-                                     int  key      = keyEvent->GetKeyCode();
-                                     int  action   = keyEvent->GetAction();
-                                     int  mods     = keyEvent->GetMods();
-
-                                     switch (action)
-                                     {
-                                         case GLFW_PRESS:
-                                             MS_LOUD_DEBUG("key press event: {0} - {1}", action, key);
-
-                                             if (m_CameraController && m_CameraController->GetConnected())
-                                             {
-                                                 if (key == GLFW_KEY_W)
-                                                 {
-                                                     m_CameraController->OnMoveForward();
-                                                 }
-                                                 else if (key == GLFW_KEY_S)
-                                                 {
-                                                     m_CameraController->OnMoveBackward();
-                                                 }
-                                                 else if (key == GLFW_KEY_A)
-                                                 {
-                                                     m_CameraController->OnMoveLeft();
-                                                 }
-                                                 else if (key == GLFW_KEY_D)
-                                                 {
-                                                     m_CameraController->OnMoveRight();
-                                                 }
-                                             }
-
-                                             if (key == GLFW_KEY_ESCAPE && m_CameraController->GetConnected())
-                                             {
-                                                 glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-                                                 m_CameraController->SetConnected(false);
-                                                 m_FirstMouse = true;
-                                             }
-                                             else if (key == GLFW_KEY_ESCAPE && !m_CameraController->GetConnected())
-                                             {
-                                                 glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-                                                 m_CameraController->SetConnected(true);
-                                             }
-
-                                             break;
-                                         case GLFW_RELEASE:
-                                             MS_LOUD_DEBUG("key release event: {0} - {1}", action, key);
-                                             break;
-                                         case GLFW_REPEAT:
-                                             MS_LOUD_DEBUG("key repeat event: {0} - {1}", action, key);
-
-                                             if (m_CameraController && m_CameraController->GetConnected())
-                                             {
-                                                 if (key == GLFW_KEY_W)
-                                                 {
-                                                     m_CameraController->OnMoveForward();
-                                                 }
-                                                 else if (key == GLFW_KEY_S)
-                                                 {
-                                                     m_CameraController->OnMoveBackward();
-                                                 }
-                                                 else if (key == GLFW_KEY_A)
-                                                 {
-                                                     m_CameraController->OnMoveLeft();
-                                                 }
-                                                 else if (key == GLFW_KEY_D)
-                                                 {
-                                                     m_CameraController->OnMoveRight();
-                                                 }
-                                             }
-
-                                             break;
-                                     }
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(KeyPressEvent));
-
-    m_EventDispatcher->Subscribe(typeid(MouseButtonPressEvent),
-                                 [this](std::shared_ptr<Event> event)
-                                 {
-                                     auto btnEvent = std::static_pointer_cast<MouseButtonPressEvent>(event);
-                                     int  btn      = btnEvent->GetButton();
-                                     int  action   = btnEvent->GetAction();
-
-                                     switch (action)
-                                     {
-                                         case GLFW_PRESS:
-                                             MS_LOUD_DEBUG("mouse button press event: {0} - {1}", action, btn);
-
-                                             if (m_CameraController && m_CameraController->GetConnected())
-                                             {
-                                                 if (btn == GLFW_MOUSE_BUTTON_MIDDLE)
-                                                 {
-                                                     m_CameraController->SetFov(65.0f);
-                                                 }
-                                             }
-
-                                             break;
-                                         case GLFW_RELEASE:
-                                             MS_LOUD_DEBUG("mouse button release event: {0} - {1}", action, btn);
-                                             break;
-                                     }
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(MouseButtonPressEvent));
-
-    m_EventDispatcher->Subscribe(typeid(MouseScrollEvent),
-                                 [this](std::shared_ptr<Event> event)
-                                 {
-                                     auto scrollEvent = std::static_pointer_cast<MouseScrollEvent>(event);
-                                     int  xOffset     = scrollEvent->GetXOffset();
-                                     int  yOffset     = scrollEvent->GetYOffset();
-
-                                     if (m_CameraController && m_CameraController->GetConnected())
-                                     {
-                                         m_CameraController->SetFov(m_CameraController->GetFov() - (float) yOffset);
-
-                                         if (m_CameraController->GetFov() < 1.0f)
-                                             m_CameraController->SetFov(1.0f);
-                                         if (m_CameraController->GetFov() > 120.0f)
-                                             m_CameraController->SetFov(120.0f);
-                                     }
-
-                                     MS_LOUD_DEBUG("mouse scroll event: x{0}, y{1}", xOffset, yOffset);
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(MouseScrollEvent));
-
-    m_EventDispatcher->Subscribe(typeid(MouseMoveEvent),
-                                 [this](std::shared_ptr<Event> event)
-                                 {
-                                     auto   moveEvent = std::static_pointer_cast<MouseMoveEvent>(event);
-                                     double xPosition = moveEvent->GetXPosition();
-                                     double yPosition = moveEvent->GetYPosition();
-
-                                     if (m_CameraController && m_CameraController->GetConnected())
-                                     {
-                                         if (m_FirstMouse)
-                                         {
-                                             m_LastX      = xPosition;
-                                             m_LastY      = yPosition;
-                                             m_FirstMouse = false;
-                                         }
-
-                                         float xoffset = xPosition - m_LastX;
-                                         float yoffset = m_LastY - yPosition;
-                                         m_LastX       = xPosition;
-                                         m_LastY       = yPosition;
-
-                                         xoffset *= m_CamSensitivity;
-                                         yoffset *= m_CamSensitivity;
-
-                                         m_CameraController->SetPitch(m_CameraController->GetPitch() + yoffset);
-                                         m_CameraController->SetYaw(m_CameraController->GetYaw() + xoffset);
-
-                                         if (m_CameraController->GetPitch() > 89.0f)
-                                             m_CameraController->SetPitch(89.0f);
-                                         if (m_CameraController->GetPitch() < -89.0f)
-                                             m_CameraController->SetPitch(-89.0f);
-
-                                         glm::vec3 direction;
-                                         direction.x = cos(glm::radians(m_CameraController->GetYaw()))
-                                                       * cos(glm::radians(m_CameraController->GetPitch()));
-                                         direction.y = sin(glm::radians(m_CameraController->GetPitch()));
-                                         direction.z = sin(glm::radians(m_CameraController->GetYaw()))
-                                                       * cos(glm::radians(m_CameraController->GetPitch()));
-
-                                         // Normalize the direction vector
-                                         m_CameraController->SetDirection(glm::normalize(direction));
-                                         m_CameraController->SetFront(m_CameraController->GetDirection());
-                                     }
-
-                                     MS_LOUD_DEBUG("mouse move event: x{0}, y{1}", xPosition, yPosition);
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(MouseMoveEvent));
-
-    m_EventDispatcher->Subscribe(typeid(WindowCloseEvent),
-                                 [this](std::shared_ptr<Event> event)
-                                 {
-                                     MS_DEBUG("window close event");
-                                     TerminateWindow();
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(WindowCloseEvent));
-
-    m_EventDispatcher->Subscribe(typeid(WindowResizeEvent),
-                                 [](std::shared_ptr<Event> event)
-                                 {
-                                     auto resizeEvent = std::static_pointer_cast<WindowResizeEvent>(event);
-                                     int  width       = resizeEvent->GetWidth();
-                                     int  height      = resizeEvent->GetHeight();
-
-                                     Rendering::RenderingCommand::SetViewport(width, height);
-                                     MS_DEBUG("window resize event: {0}x{1}", width, height);
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(WindowResizeEvent));
-
-    m_EventDispatcher->Subscribe(typeid(WindowMinimizeEvent),
-                                 [](std::shared_ptr<Event> event)
-                                 {
-                                     auto minimizeEvent = std::static_pointer_cast<WindowMinimizeEvent>(event);
-                                     int  minimized     = minimizeEvent->IsMinimized();
-
-                                     MS_DEBUG("window minimize event: {0}", minimized);
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(WindowMinimizeEvent));
-
-    m_EventDispatcher->Subscribe(typeid(WindowFocusEvent),
-                                 [](std::shared_ptr<Event> event)
-                                 {
-                                     auto focusEvent = std::static_pointer_cast<WindowFocusEvent>(event);
-                                     int  focused    = focusEvent->IsFocused();
-
-                                     MS_LOUD_DEBUG("window focus event: {0}", focused);
-                                 });
-
-    m_SubscribedWindowEvents.push_back(typeid(WindowFocusEvent));
+    // A high polling rate mouse sends several of these a frame, only where they end up matters to the camera
+    m_EventQueue->SetCoalescing<MouseMoveEvent, CoalescePolicy::KeepLatest>();
+    m_EventQueue->SetCoalescing<MouseScrollEvent, CoalescePolicy::Sum>();
+    m_EventQueue->SetCoalescing<WindowResizeEvent, CoalescePolicy::KeepLatest>();
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<KeyPressEvent>(
+        [this](const Event &event)
+        {
+            const auto &keyEvent = static_cast<const KeyPressEvent &>(event);
+            int        key       = keyEvent.GetKeyCode();
+            int        action    = keyEvent.GetAction();
+
+            switch (action)
+            {
+                case GLFW_PRESS:
+                    MS_LOUD_DEBUG("key press event: {0} - {1}", action, key);
+
+                    // Held keys move the camera in the fixed update, not per event
+                    SetMovementKey(key, true);
+
+                    if (key == GLFW_KEY_ESCAPE && m_CameraController->GetConnected())
+                    {
+                        glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+                        m_CameraController->SetConnected(false);
+                        m_FirstMouse = true;
+                    }
+                    else if (key == GLFW_KEY_ESCAPE && !m_CameraController->GetConnected())
+                    {
+                        glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+                        m_CameraController->SetConnected(true);
+                    }
+
+                    break;
+                case GLFW_RELEASE:
+                    MS_LOUD_DEBUG("key release event: {0} - {1}", action, key);
+                    SetMovementKey(key, false);
+                    break;
+                case GLFW_REPEAT:
+                    MS_LOUD_DEBUG("key repeat event: {0} - {1}", action, key);
+                    break;
+            }
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<MouseButtonPressEvent>(
+        [this](const Event &event)
+        {
+            const auto &btnEvent = static_cast<const MouseButtonPressEvent &>(event);
+            int        btn       = btnEvent.GetButton();
+            int        action    = btnEvent.GetAction();
+
+            switch (action)
+            {
+                case GLFW_PRESS:
+                    MS_LOUD_DEBUG("mouse button press event: {0} - {1}", action, btn);
+
+                    if (m_CameraController && m_CameraController->GetConnected())
+                    {
+                        if (btn == GLFW_MOUSE_BUTTON_MIDDLE)
+                        {
+                            m_CameraController->SetFov(65.0f);
+                        }
+                    }
+
+                    break;
+                case GLFW_RELEASE:
+                    MS_LOUD_DEBUG("mouse button release event: {0} - {1}", action, btn);
+                    break;
+            }
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<MouseScrollEvent>(
+        [this](const Event &event)
+        {
+            const auto &scrollEvent = static_cast<const MouseScrollEvent &>(event);
+            int        yOffset      = scrollEvent.GetYOffset();
+
+            if (m_CameraController && m_CameraController->GetConnected())
+            {
+                m_CameraController->SetFov(m_CameraController->GetFov() - (float) yOffset);
+
+                if (m_CameraController->GetFov() < 1.0f)
+                    m_CameraController->SetFov(1.0f);
+                if (m_CameraController->GetFov() > 120.0f)
+                    m_CameraController->SetFov(120.0f);
+            }
+
+            MS_LOUD_DEBUG("mouse scroll event: x{0}, y{1}", scrollEvent.GetXOffset(), yOffset);
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<MouseMoveEvent>(
+        [this](const Event &event)
+        {
+            const auto &moveEvent = static_cast<const MouseMoveEvent &>(event);
+            double     xPosition  = moveEvent.GetXPosition();
+            double     yPosition  = moveEvent.GetYPosition();
+
+            if (m_CameraController && m_CameraController->GetConnected())
+            {
+                if (m_FirstMouse)
+                {
+                    m_LastX      = xPosition;
+                    m_LastY      = yPosition;
+                    m_FirstMouse = false;
+                }
+
+                float xoffset = xPosition - m_LastX;
+                float yoffset = m_LastY - yPosition;
+                m_LastX       = xPosition;
+                m_LastY       = yPosition;
+
+                xoffset *= m_CamSensitivity;
+                yoffset *= m_CamSensitivity;
+
+                m_CameraController->SetPitch(m_CameraController->GetPitch() + yoffset);
+                m_CameraController->SetYaw(m_CameraController->GetYaw() + xoffset);
+
+                if (m_CameraController->GetPitch() > 89.0f)
+                    m_CameraController->SetPitch(89.0f);
+                if (m_CameraController->GetPitch() < -89.0f)
+                    m_CameraController->SetPitch(-89.0f);
+
+                glm::vec3 direction;
+                direction.x = cos(glm::radians(m_CameraController->GetYaw()))
+                              * cos(glm::radians(m_CameraController->GetPitch()));
+                direction.y = sin(glm::radians(m_CameraController->GetPitch()));
+                direction.z = sin(glm::radians(m_CameraController->GetYaw()))
+                              * cos(glm::radians(m_CameraController->GetPitch()));
+
+                // Normalize the direction vector
+                m_CameraController->SetDirection(glm::normalize(direction));
+                m_CameraController->SetFront(m_CameraController->GetDirection());
+            }
+
+            MS_LOUD_DEBUG("mouse move event: x{0}, y{1}", xPosition, yPosition);
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<WindowCloseEvent>(
+        [this](const Event &event)
+        {
+            MS_DEBUG("window close event");
+            TerminateWindow();
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<WindowResizeEvent>(
+        [](const Event &event)
+        {
+            const auto &resizeEvent = static_cast<const WindowResizeEvent &>(event);
+            int        width        = resizeEvent.GetWidth();
+            int        height       = resizeEvent.GetHeight();
+
+            Rendering::RenderingCommand::SetViewport(width, height);
+            MS_DEBUG("window resize event: {0}x{1}", width, height);
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<WindowMinimizeEvent>(
+        [this](const Event &event)
+        {
+            const auto &minimizeEvent = static_cast<const WindowMinimizeEvent &>(event);
+            int        minimized      = minimizeEvent.IsMinimized();
+
+            m_WindowData.Minimized = minimized;
+            MS_DEBUG("window minimize event: {0}", minimized);
+        }));
+
+    m_WindowSubscriptions.push_back(m_EventDispatcher->Subscribe<WindowFocusEvent>(
+        [this](const Event &event)
+        {
+            const auto &focusEvent = static_cast<const WindowFocusEvent &>(event);
+            int        focused     = focusEvent.IsFocused();
+
+            m_WindowData.Focused = focused;
+            MS_LOUD_DEBUG("window focus event: {0}", focused);
+        }));
 }
 
 } // namespace Core
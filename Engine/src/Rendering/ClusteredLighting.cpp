@@ -0,0 +1,261 @@
+#include "Include/ClusteredLighting.h"
+#include "Core/Include/JobSystem.h"
+#include "Core/Include/Profiler.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+ClusteredLighting::ClusteredLighting()
+    : m_ClusterLights(s_ClusterCount), m_Clusters(s_ClusterCount)
+{
+    m_Ring = std::make_unique<RingBuffer>(RenderingAPI::BufferTarget::ShaderStorage, s_RingSegmentSize);
+}
+
+void ClusteredLighting::Update(const std::vector<Lighting::Light> &lights, const std::vector<int> &shadowSlots,
+                               const glm::mat4 &view, const glm::mat4 &projection, float nearClip, float farClip)
+{
+    MS_PROFILE_FUNCTION();
+
+    m_Ring->BeginFrame();
+
+    m_Near = nearClip;
+    m_Far = farClip;
+
+    float logDepthRange = std::log(m_Far / m_Near);
+    m_SliceScale = s_GridZ / logDepthRange;
+    m_SliceBias = s_GridZ * std::log(m_Near) / logDepthRange;
+
+    // Inactive and directional lights never make it into the table
+    m_Lights.clear();
+    for (size_t i = 0; i < lights.size(); ++i)
+    {
+        const auto &light = lights[i];
+        if (light.type != Lighting::LightType::Point || !light.isActive)
+        {
+            continue;
+        }
+
+        float radius = LightRadius(light, m_Far);
+        if (radius <= 0.0f)
+        {
+            continue;
+        }
+
+        GPUPointLight gpuLight;
+        gpuLight.positionRadius = glm::vec4(light.position, radius);
+        gpuLight.ambient = glm::vec4(light.ambient, 0.0f);
+        gpuLight.diffuse = glm::vec4(light.diffuse, 0.0f);
+        gpuLight.specular = glm::vec4(light.specular, 0.0f);
+        float shadowSlot = i < shadowSlots.size() ? static_cast<float>(shadowSlots[i]) : -1.0f;
+        gpuLight.attenuation = glm::vec4(light.constant, light.linear, light.quadratic, shadowSlot);
+        m_Lights.push_back(gpuLight);
+    }
+
+    m_Bounds.resize(m_Lights.size());
+
+    auto &jobSystem = Core::JobSystem::GetJobSystemInstance();
+
+    jobSystem->ParallelFor(m_Lights.size(), s_LightBatchSize, [this, &view, &projection](size_t begin, size_t end) {
+        ComputeLightBounds(begin, end, view, projection);
+    });
+
+    // Each slice owns a disjoint set of cluster lists, so slices can be filled without locking
+    jobSystem->ParallelFor(s_GridZ, 1, [this](size_t begin, size_t end) { AssignSlices(begin, end); });
+
+    UploadClusters();
+}
+
+void ClusteredLighting::Bind() const
+{
+    m_Ring->Bind(m_LightAllocation, s_PointLightBinding);
+    m_Ring->Bind(m_ClusterAllocation, s_ClusterBinding);
+    m_Ring->Bind(m_IndexAllocation, s_LightIndexBinding);
+}
+
+void ClusteredLighting::EndFrame()
+{
+    m_Ring->EndFrame();
+}
+
+void ClusteredLighting::ComputeLightBounds(size_t begin, size_t end, const glm::mat4 &view,
+                                           const glm::mat4 &projection)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        ClusterBounds &bounds = m_Bounds[i];
+
+        // Empty until proven otherwise
+        bounds = {0, -1, 0, -1, 0, -1};
+
+        glm::vec3 centre = glm::vec3(view * glm::vec4(glm::vec3(m_Lights[i].positionRadius), 1.0f));
+        float radius = m_Lights[i].positionRadius.w;
+
+        float depth = -centre.z;
+        float nearDepth = depth - radius;
+        float farDepth = depth + radius;
+
+        if (farDepth < m_Near || nearDepth > m_Far)
+        {
+            continue;
+        }
+
+        int minX = 0, maxX = s_GridX - 1;
+        int minY = 0, maxY = s_GridY - 1;
+
+        // A sphere crossing the near plane can cover any tile, otherwise project the corners of its view space
+        // bounding box. x/z is monotonic in z, so the nearest and furthest depths give the extremes.
+        if (nearDepth > m_Near)
+        {
+            glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+
+            for (float z : {nearDepth, farDepth})
+            {
+                for (float offset : {-radius, radius})
+                {
+                    float ndcX = (centre.x + offset) * projection[0][0] / z;
+                    float ndcY = (centre.y + offset) * projection[1][1] / z;
+
+                    ndcMin = glm::min(ndcMin, glm::vec2(ndcX, ndcY));
+                    ndcMax = glm::max(ndcMax, glm::vec2(ndcX, ndcY));
+                }
+            }
+
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+            {
+                continue;
+            }
+
+            auto toTile = [](float ndc, unsigned gridSize) {
+                int tile = static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * gridSize));
+                return std::clamp(tile, 0, static_cast<int>(gridSize) - 1);
+            };
+
+            minX = toTile(ndcMin.x, s_GridX);
+            maxX = toTile(ndcMax.x, s_GridX);
+            minY = toTile(ndcMin.y, s_GridY);
+            maxY = toTile(ndcMax.y, s_GridY);
+        }
+
+        bounds = {minX,
+                  maxX,
+                  minY,
+                  maxY,
+                  SliceForDepth(std::max(nearDepth, m_Near)),
+                  SliceForDepth(std::min(farDepth, m_Far))};
+    }
+}
+
+void ClusteredLighting::AssignSlices(size_t begin, size_t end)
+{
+    for (size_t slice = begin; slice < end; ++slice)
+    {
+        size_t sliceStart = slice * s_GridX * s_GridY;
+        for (size_t cluster = sliceStart; cluster < sliceStart + s_GridX * s_GridY; ++cluster)
+        {
+            m_ClusterLights[cluster].clear();
+        }
+
+        int z = static_cast<int>(slice);
+        for (size_t i = 0; i < m_Bounds.size(); ++i)
+        {
+            const ClusterBounds &bounds = m_Bounds[i];
+            if (z < bounds.minZ || z > bounds.maxZ)
+            {
+                continue;
+            }
+
+            for (int y = bounds.minY; y <= bounds.maxY; ++y)
+            {
+                for (int x = bounds.minX; x <= bounds.maxX; ++x)
+                {
+                    auto &clusterLights = m_ClusterLights[sliceStart + y * s_GridX + x];
+                    if (clusterLights.size() < s_MaxLightsPerCluster)
+                    {
+                        clusterLights.push_back(static_cast<unsigned>(i));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ClusteredLighting::UploadClusters()
+{
+    m_LightIndices.clear();
+    m_Stats.maxLightsInCluster = 0;
+
+    for (unsigned cluster = 0; cluster < s_ClusterCount; ++cluster)
+    {
+        const auto &clusterLights = m_ClusterLights[cluster];
+
+        m_Clusters[cluster].offset = static_cast<unsigned>(m_LightIndices.size());
+        m_Clusters[cluster].count = static_cast<unsigned>(clusterLights.size());
+        m_LightIndices.insert(m_LightIndices.end(), clusterLights.begin(), clusterLights.end());
+
+        m_Stats.maxLightsInCluster = std::max(m_Stats.maxLightsInCluster, m_Clusters[cluster].count);
+    }
+
+    m_Stats.pointLightCount = static_cast<unsigned>(m_Lights.size());
+    m_Stats.visibleLightCount = static_cast<unsigned>(
+        std::count_if(m_Bounds.begin(), m_Bounds.end(), [](const ClusterBounds &bounds) {
+            return bounds.minZ <= bounds.maxZ;
+        }));
+    m_Stats.lightIndexCount = static_cast<unsigned>(m_LightIndices.size());
+
+    // Zero sized ranges can't be bound, so empty tables still take one element
+    auto upload = [this](const void *data, size_t size, size_t minimumSize) {
+        RingBuffer::Allocation allocation = m_Ring->Allocate(std::max(size, minimumSize));
+        if (allocation.data && size > 0)
+        {
+            std::memcpy(allocation.data, data, size);
+        }
+
+        return allocation;
+    };
+
+    m_LightAllocation = upload(m_Lights.data(), m_Lights.size() * sizeof(GPUPointLight), sizeof(GPUPointLight));
+    m_ClusterAllocation = upload(m_Clusters.data(), m_Clusters.size() * sizeof(Cluster), sizeof(Cluster));
+    m_IndexAllocation = upload(m_LightIndices.data(), m_LightIndices.size() * sizeof(unsigned), sizeof(unsigned));
+}
+
+int ClusteredLighting::SliceForDepth(float depth) const
+{
+    int slice = static_cast<int>(std::floor(std::log(depth) * m_SliceScale - m_SliceBias));
+    return std::clamp(slice, 0, static_cast<int>(s_GridZ) - 1);
+}
+
+float ClusteredLighting::LightRadius(const Lighting::Light &light, float maxRadius)
+{
+    // Distance at which the brightest channel falls below a few 8-bit steps, the shader fades the light out
+    // towards it so the cutoff doesn't show on cluster edges
+    constexpr float cutoff = 5.0f / 256.0f;
+
+    glm::vec3 colour = light.ambient + light.diffuse + light.specular;
+    float intensity = std::max(colour.r, std::max(colour.g, colour.b));
+    float target = intensity / cutoff;
+
+    if (target <= light.constant)
+    {
+        return 0.0f;
+    }
+
+    float radius = maxRadius;
+    if (light.quadratic > 0.0f)
+    {
+        float discriminant = light.linear * light.linear - 4.0f * light.quadratic * (light.constant - target);
+        radius = (-light.linear + std::sqrt(discriminant)) / (2.0f * light.quadratic);
+    }
+    else if (light.linear > 0.0f)
+    {
+        radius = (target - light.constant) / light.linear;
+    }
+
+    return std::min(radius, maxRadius);
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
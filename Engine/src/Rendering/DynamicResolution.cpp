@@ -0,0 +1,65 @@
+#include "Include/DynamicResolution.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+void DynamicResolution::Update(float gpuMilliseconds, float budgetMilliseconds)
+{
+    if (m_SmoothedMilliseconds <= 0.0f)
+        m_SmoothedMilliseconds = gpuMilliseconds;
+    else
+        m_SmoothedMilliseconds += (gpuMilliseconds - m_SmoothedMilliseconds) * s_Smoothing;
+
+    if (m_SettleSamples > 0)
+    {
+        --m_SettleSamples;
+        return;
+    }
+
+    // Most of the frame's cost scales with pixel count, so the scale that fits goes with the square root
+    float fitScale = GetScale() * std::sqrt(budgetMilliseconds / std::max(m_SmoothedMilliseconds, 0.01f));
+    int fitSteps = static_cast<int>(std::floor(fitScale / s_ScaleStep));
+
+    int nextSteps = m_ScaleSteps;
+
+    if (m_SmoothedMilliseconds > budgetMilliseconds)
+    {
+        nextSteps = std::min(fitSteps, m_ScaleSteps - 1);
+    }
+    else if (m_SmoothedMilliseconds < budgetMilliseconds * s_RaiseThreshold && fitSteps > m_ScaleSteps)
+    {
+        nextSteps = m_ScaleSteps + 1;
+    }
+
+    nextSteps = std::clamp(nextSteps, s_MinScaleSteps, s_MaxScaleSteps);
+
+    if (nextSteps != m_ScaleSteps)
+    {
+        m_ScaleSteps = nextSteps;
+        m_SettleSamples = s_SettleSamples;
+
+        MS_DEBUG("render scale {0:.2f} for {1:.2f}ms against a {2:.2f}ms budget", GetScale(), m_SmoothedMilliseconds,
+                 budgetMilliseconds);
+    }
+}
+
+void DynamicResolution::Reset()
+{
+    m_ScaleSteps = s_MaxScaleSteps;
+    m_SettleSamples = 0;
+    m_SmoothedMilliseconds = 0.0f;
+}
+
+glm::ivec2 DynamicResolution::GetScaledSize(int width, int height) const
+{
+    float scale = GetScale();
+
+    return {std::max(static_cast<int>(width * scale + 0.5f), 1), std::max(static_cast<int>(height * scale + 0.5f), 1)};
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
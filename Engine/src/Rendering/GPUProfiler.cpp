@@ -0,0 +1,241 @@
+#include "Include/GPUProfiler.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+std::shared_ptr<GPUProfiler> GPUProfiler::s_GPUProfiler;
+
+void GPUProfiler::Init()
+{
+    s_GPUProfiler = std::make_shared<GPUProfiler>();
+    MS_INFO("gpu profiler initialised");
+}
+
+void GPUProfiler::Shutdown()
+{
+    if (!s_GPUProfiler)
+    {
+        return;
+    }
+
+    for (auto &frame : s_GPUProfiler->m_Frames)
+    {
+        for (auto &query : frame.queryPool)
+        {
+            RenderingCommand::DeleteQuery(query);
+        }
+    }
+
+    s_GPUProfiler.reset();
+}
+
+void GPUProfiler::BeginFrame()
+{
+    m_CurrentFrame = (m_CurrentFrame + 1) % s_BufferedFrames;
+    FrameQueries &frame = m_Frames[m_CurrentFrame];
+
+    if (frame.pending)
+    {
+        if (!IsFrameAvailable(frame))
+        {
+            m_Recording = false;
+            return;
+        }
+
+        CollectFrame(frame);
+    }
+
+    frame.usedQueries = 0;
+    frame.passes.clear();
+    m_OpenPasses.clear();
+    m_Recording = true;
+}
+
+void GPUProfiler::EndFrame()
+{
+    if (!m_Recording)
+        return;
+
+    if (!m_OpenPasses.empty())
+    {
+        MS_WARN("gpu profiler frame ended with {0} passes still open", m_OpenPasses.size());
+        while (!m_OpenPasses.empty())
+        {
+            EndPass();
+        }
+    }
+
+    FrameQueries &frame = m_Frames[m_CurrentFrame];
+    frame.pending = !frame.passes.empty();
+    m_Recording = false;
+}
+
+void GPUProfiler::BeginPass(const char *name)
+{
+    if (!m_Recording)
+    {
+        m_OpenPasses.push_back(-1);
+        return;
+    }
+
+    FrameQueries &frame = m_Frames[m_CurrentFrame];
+
+    RecordedPass pass;
+    pass.name = name;
+    pass.depth = static_cast<int>(m_OpenPasses.size());
+    pass.beginQuery = NextQuery(frame);
+    pass.endQuery = NextQuery(frame);
+
+    RenderingCommand::QueryTimestamp(pass.beginQuery);
+
+    m_OpenPasses.push_back(static_cast<int>(frame.passes.size()));
+    frame.passes.push_back(pass);
+}
+
+void GPUProfiler::EndPass()
+{
+    if (m_OpenPasses.empty())
+    {
+        MS_WARN("gpu profiler pass ended without being started");
+        return;
+    }
+
+    int passIndex = m_OpenPasses.back();
+    m_OpenPasses.pop_back();
+
+    if (passIndex < 0)
+        return;
+
+    RenderingCommand::QueryTimestamp(m_Frames[m_CurrentFrame].passes[passIndex].endQuery);
+}
+
+const GPUProfiler::PassTiming *GPUProfiler::FindPass(const std::string &name) const
+{
+    const PassTiming *found = nullptr;
+
+    for (const auto &pass : m_Passes)
+    {
+        if (pass.name == name && (!found || pass.depth < found->depth))
+        {
+            found = &pass;
+        }
+    }
+
+    return found;
+}
+
+unsigned GPUProfiler::NextQuery(FrameQueries &frame)
+{
+    if (frame.usedQueries == frame.queryPool.size())
+    {
+        unsigned query = 0;
+        RenderingCommand::CreateQuery(query);
+        frame.queryPool.push_back(query);
+    }
+
+    return frame.queryPool[frame.usedQueries++];
+}
+
+bool GPUProfiler::IsFrameAvailable(const FrameQueries &frame) const
+{
+    for (const auto &pass : frame.passes)
+    {
+        if (!RenderingCommand::IsQueryResultAvailable(pass.endQuery))
+            return false;
+    }
+
+    return true;
+}
+
+void GPUProfiler::CollectFrame(FrameQueries &frame)
+{
+    frame.pending = false;
+    m_Passes.clear();
+
+    uint64_t frameBegin = UINT64_MAX;
+    uint64_t frameEnd = 0;
+
+    for (const auto &pass : frame.passes)
+    {
+        uint64_t begin = RenderingCommand::GetQueryResult(pass.beginQuery);
+        uint64_t end = RenderingCommand::GetQueryResult(pass.endQuery);
+
+        frameBegin = std::min(frameBegin, begin);
+        frameEnd = std::max(frameEnd, end);
+
+        PassTiming timing;
+        timing.name = pass.name;
+        timing.depth = pass.depth;
+
+        float milliseconds = end > begin ? static_cast<float>(end - begin) / 1000000.0f : 0.0f;
+        AddSample(m_History[timing.name], timing, milliseconds);
+
+        m_Passes.push_back(timing);
+    }
+
+    m_FrameTiming.name = "Frame";
+    AddSample(m_FrameHistory, m_FrameTiming, static_cast<float>(frameEnd - frameBegin) / 1000000.0f);
+
+    ++m_CollectedFrames;
+}
+
+void GPUProfiler::AddSample(PassHistory &history, PassTiming &timing, float milliseconds)
+{
+    history.samples[history.next] = milliseconds;
+    history.next = (history.next + 1) % history.samples.size();
+    history.count = std::min(history.count + 1, history.samples.size());
+
+    float sum = 0.0f;
+    timing.minMilliseconds = milliseconds;
+    timing.maxMilliseconds = milliseconds;
+
+    for (size_t i = 0; i < history.count; ++i)
+    {
+        sum += history.samples[i];
+        timing.minMilliseconds = std::min(timing.minMilliseconds, history.samples[i]);
+        timing.maxMilliseconds = std::max(timing.maxMilliseconds, history.samples[i]);
+    }
+
+    timing.lastMilliseconds = milliseconds;
+    timing.averageMilliseconds = sum / static_cast<float>(history.count);
+}
+
+bool GPUProfiler::ExportJSON(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        MS_ERROR("failed to open {0} for gpu timings", path);
+        return false;
+    }
+
+    auto writeTiming = [&file](const PassTiming &timing) {
+        file << "{\"name\": \"" << timing.name << "\", \"depth\": " << timing.depth
+             << ", \"lastMs\": " << timing.lastMilliseconds << ", \"averageMs\": " << timing.averageMilliseconds
+             << ", \"minMs\": " << timing.minMilliseconds << ", \"maxMs\": " << timing.maxMilliseconds << "}";
+    };
+
+    file << "{\n";
+    file << "  \"collectedFrames\": " << m_CollectedFrames << ",\n";
+    file << "  \"frame\": ";
+    writeTiming(m_FrameTiming);
+    file << ",\n  \"passes\": [";
+
+    for (size_t i = 0; i < m_Passes.size(); ++i)
+    {
+        file << (i == 0 ? "\n    " : ",\n    ");
+        writeTiming(m_Passes[i]);
+    }
+
+    file << "\n  ]\n}\n";
+
+    MS_INFO("gpu timings written to {0}", path);
+    return true;
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
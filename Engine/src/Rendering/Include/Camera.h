@@ -4,7 +4,6 @@
 #include "Rendering/Include/CameraController.h"
 
 #include "Core/Include/Logger.h"
-#include "Core/Include/Time.h"
 #include "Rendering/Include/RenderingCommand.h"
 
 #include <glm/glm.hpp>
@@ -19,33 +18,40 @@ namespace Rendering
 
 class Camera : public CameraController
 {
-    Core::Time &time = Core::Time::GetInstance();
-
   public:
     Camera(const glm::vec3 &pos, const glm::vec3 &front, const glm::vec3 &up)
-        : m_CameraPos(pos), m_CameraFront(front), m_CameraUp(up)
+        : m_CameraPos(pos), m_PreviousCameraPos(pos), m_RenderCameraPos(pos), m_CameraFront(front), m_CameraUp(up)
+    {
+    }
+
+    void OnMoveForward(float deltaTime) override
+    {
+        m_CameraPos += m_CameraSpeed * deltaTime * m_CameraFront;
+    }
+
+    void OnMoveBackward(float deltaTime) override
     {
-        Core::Time &time = Core::Time::GetInstance();
+        m_CameraPos -= m_CameraSpeed * deltaTime * m_CameraFront;
     }
 
-    void OnMoveForward() override
+    void OnMoveLeft(float deltaTime) override
     {
-        m_CameraPos += m_CameraSpeed * time.GetDeltaTime() * m_CameraFront;
+        m_CameraPos -= glm::normalize(glm::cross(m_CameraFront, m_CameraUp)) * m_CameraSpeed * deltaTime;
     }
 
-    void OnMoveBackward() override
+    void OnMoveRight(float deltaTime) override
     {
-        m_CameraPos -= m_CameraSpeed * time.GetDeltaTime() * m_CameraFront;
+        m_CameraPos += glm::normalize(glm::cross(m_CameraFront, m_CameraUp)) * m_CameraSpeed * deltaTime;
     }
 
-    void OnMoveLeft() override
+    void BeginFixedStep() override
     {
-        m_CameraPos -= glm::normalize(glm::cross(m_CameraFront, m_CameraUp)) * m_CameraSpeed * time.GetDeltaTime();
+        m_PreviousCameraPos = m_CameraPos;
     }
 
-    void OnMoveRight() override
+    void SetInterpolation(float alpha) override
     {
-        m_CameraPos += glm::normalize(glm::cross(m_CameraFront, m_CameraUp)) * m_CameraSpeed * time.GetDeltaTime();
+        m_RenderCameraPos = glm::mix(m_PreviousCameraPos, m_CameraPos, alpha);
     }
 
     inline glm::mat4 GetProjectionMatrix() const
@@ -61,9 +67,10 @@ class Camera : public CameraController
         return m_Model;
     }
 
+    // Where the camera is drawn from, interpolated between the last two fixed steps
     inline glm::vec3 GetPosition() const
     {
-        return m_CameraPos;
+        return m_RenderCameraPos;
     }
     inline glm::vec3 GetFront() const
     {
@@ -105,9 +112,12 @@ class Camera : public CameraController
     void SetModel(glm::vec3 model);
     void SetModelTransform(unsigned shaderID, glm::mat4 model);
 
+    // Teleports, nothing is interpolated across the jump
     void SetPosition(const glm::vec3 &pos)
     {
         m_CameraPos = pos;
+        m_PreviousCameraPos = pos;
+        m_RenderCameraPos = pos;
     }
     void SetFront(const glm::vec3 &front) override
     {
@@ -150,6 +160,8 @@ class Camera : public CameraController
     glm::mat4 m_Model;
 
     glm::vec3 m_CameraPos;
+    glm::vec3 m_PreviousCameraPos;
+    glm::vec3 m_RenderCameraPos;
     glm::vec3 m_CameraFront;
     glm::vec3 m_CameraUp;
     glm::vec3 m_CameraDirection;
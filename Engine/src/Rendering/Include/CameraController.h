@@ -12,10 +12,16 @@ namespace Rendering
 class CameraController
 {
     public:
-        virtual void OnMoveForward()  = 0;
-        virtual void OnMoveBackward() = 0;
-        virtual void OnMoveLeft()     = 0;
-        virtual void OnMoveRight()    = 0;
+        // Movement happens in fixed steps, deltaTime is the step length in seconds
+        virtual void OnMoveForward(float deltaTime)  = 0;
+        virtual void OnMoveBackward(float deltaTime) = 0;
+        virtual void OnMoveLeft(float deltaTime)     = 0;
+        virtual void OnMoveRight(float deltaTime)    = 0;
+
+        // Called before each fixed step moves the camera, then once a frame with how far the frame is past the last
+        // step so what's drawn sits between the last two steps instead of jumping from one to the next
+        virtual void BeginFixedStep()              = 0;
+        virtual void SetInterpolation(float alpha) = 0;
 
         virtual float GetPitch() const = 0;
         virtual float GetYaw() const   = 0;
@@ -0,0 +1,123 @@
+#ifndef CLUSTEREDLIGHTING_H
+#define CLUSTEREDLIGHTING_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/Lighting.h"
+#include "Rendering/Include/RingBuffer.h"
+#include <glm/glm.hpp>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Splits the view frustum into a grid of screen tiles by exponential depth slices and works out, every frame on
+// the CPU, which point lights reach each cluster. Fragment shaders find their cluster from screen position and
+// view depth and only shade the lights in its list, so the per-fragment cost follows local light density rather
+// than the number of lights in the scene.
+class ClusteredLighting
+{
+  public:
+    struct Stats
+    {
+        unsigned pointLightCount = 0;
+        unsigned visibleLightCount = 0;
+        unsigned lightIndexCount = 0;
+        unsigned maxLightsInCluster = 0;
+    };
+
+    static constexpr unsigned s_GridX = 16;
+    static constexpr unsigned s_GridY = 9;
+    static constexpr unsigned s_GridZ = 24;
+    static constexpr unsigned s_ClusterCount = s_GridX * s_GridY * s_GridZ;
+    static constexpr unsigned s_MaxLightsPerCluster = 128;
+
+    static constexpr unsigned s_PointLightBinding = 4;
+    static constexpr unsigned s_ClusterBinding = 5;
+    static constexpr unsigned s_LightIndexBinding = 6;
+
+    ClusteredLighting();
+
+    // Cluster data is written into a ring segment, EndFrame fences it once the frame's draws are submitted.
+    // shadowSlots holds each light's point shadow slot, or -1, indexed like lights
+    void Update(const std::vector<Lighting::Light> &lights, const std::vector<int> &shadowSlots,
+                const glm::mat4 &view, const glm::mat4 &projection, float nearClip, float farClip);
+    void Bind() const;
+    void EndFrame();
+
+    // x and y turn log(view depth) into a slice index, see FrameData in the default shaders
+    inline glm::vec4 GetClusterParams() const
+    {
+        return glm::vec4(m_SliceScale, m_SliceBias, m_Near, m_Far);
+    }
+
+    inline glm::ivec4 GetClusterGrid() const
+    {
+        return glm::ivec4(s_GridX, s_GridY, s_GridZ, 0);
+    }
+
+    inline const Stats &GetStats() const
+    {
+        return m_Stats;
+    }
+
+    // Distance past which a point light contributes less than a few 8-bit steps
+    static float LightRadius(const Lighting::Light &light, float maxRadius);
+
+  private:
+    // Mirrors PointLight in the default shaders, std430
+    struct GPUPointLight
+    {
+        glm::vec4 positionRadius;
+        glm::vec4 ambient;
+        glm::vec4 diffuse;
+        glm::vec4 specular;
+        glm::vec4 attenuation; // constant, linear, quadratic, shadow slot
+    };
+
+    struct Cluster
+    {
+        unsigned offset;
+        unsigned count;
+    };
+
+    struct ClusterBounds
+    {
+        int minX, maxX;
+        int minY, maxY;
+        int minZ, maxZ;
+    };
+
+    void ComputeLightBounds(size_t begin, size_t end, const glm::mat4 &view, const glm::mat4 &projection);
+    void AssignSlices(size_t begin, size_t end);
+    void UploadClusters();
+
+    int SliceForDepth(float depth) const;
+
+  private:
+    static constexpr size_t s_RingSegmentSize = 4 * 1024 * 1024;
+    static constexpr size_t s_LightBatchSize = 128;
+
+    std::unique_ptr<RingBuffer> m_Ring;
+    RingBuffer::Allocation m_LightAllocation, m_ClusterAllocation, m_IndexAllocation;
+
+    float m_Near = 0.1f, m_Far = 100.0f;
+    float m_SliceScale = 0.0f, m_SliceBias = 0.0f;
+
+    std::vector<GPUPointLight> m_Lights;
+    std::vector<ClusterBounds> m_Bounds;
+
+    // Per-cluster scratch lists keep their capacity between frames
+    std::vector<std::vector<unsigned>> m_ClusterLights;
+    std::vector<Cluster> m_Clusters;
+    std::vector<unsigned> m_LightIndices;
+
+    Stats m_Stats;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // CLUSTEREDLIGHTING_H
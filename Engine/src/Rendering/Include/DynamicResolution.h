@@ -0,0 +1,53 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include "Core/Include/Core.h"
+#include <glm/glm.hpp>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Picks the scene's internal render scale from measured GPU frame time. The scale moves in fixed steps so render
+// targets are only ever a handful of sizes, drops straight to a step that fits when over budget, climbs back one
+// step at a time when there is headroom, and waits a few samples after every change for the timings to catch up.
+class DynamicResolution
+{
+  public:
+    void Update(float gpuMilliseconds, float budgetMilliseconds);
+    void Reset();
+
+    inline float GetScale() const
+    {
+        return m_ScaleSteps * s_ScaleStep;
+    }
+
+    inline float GetSmoothedMilliseconds() const
+    {
+        return m_SmoothedMilliseconds;
+    }
+
+    glm::ivec2 GetScaledSize(int width, int height) const;
+
+  private:
+    static constexpr float s_ScaleStep = 0.05f;
+    static constexpr int s_MinScaleSteps = 10;
+    static constexpr int s_MaxScaleSteps = 20;
+
+    // Only scale back up when comfortably under budget, so the scale doesn't flip between two steps
+    static constexpr float s_RaiseThreshold = 0.85f;
+    static constexpr float s_Smoothing = 0.15f;
+    static constexpr int s_SettleSamples = 6;
+
+    int m_ScaleSteps = s_MaxScaleSteps;
+    int m_SettleSamples = 0;
+    float m_SmoothedMilliseconds = 0.0f;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // DYNAMICRESOLUTION_H
@@ -0,0 +1,144 @@
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RenderingCommand.h"
+#include <array>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Per-pass GPU timings from timestamp queries written at the start and end of each pass. Every frame records into
+// its own set of queries and is read back a few frames later once all of them are available, so the CPU never
+// waits on the GPU. If the oldest frame still isn't done when its slot comes round again, that frame goes untimed.
+//
+// Passes can nest, and are reported in the order they were recorded with a rolling average over recent frames.
+class GPUProfiler
+{
+  public:
+    struct PassTiming
+    {
+        std::string name;
+        int depth = 0;
+
+        float lastMilliseconds = 0.0f;
+        float averageMilliseconds = 0.0f;
+        float minMilliseconds = 0.0f;
+        float maxMilliseconds = 0.0f;
+    };
+
+    // Times the GPU work submitted between its construction and destruction
+    class Scope
+    {
+      public:
+        explicit Scope(const char *name)
+        {
+            GetGPUProfilerInstance()->BeginPass(name);
+        }
+
+        ~Scope()
+        {
+            GetGPUProfilerInstance()->EndPass();
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    static void Init();
+
+    // Deletes every query and drops the instance, call while the GL context is still alive
+    static void Shutdown();
+
+    inline static std::shared_ptr<GPUProfiler> &GetGPUProfilerInstance()
+    {
+        MS_ASSERT(s_GPUProfiler, "gpu profiler failed to initialise");
+        return s_GPUProfiler;
+    }
+
+    void BeginFrame();
+    void EndFrame();
+
+    // Names must outlive the frame, string literals are expected
+    void BeginPass(const char *name);
+    void EndPass();
+
+    inline const std::vector<PassTiming> &GetPasses() const
+    {
+        return m_Passes;
+    }
+
+    // Outermost pass of that name in the last collected frame, nullptr if it wasn't recorded
+    const PassTiming *FindPass(const std::string &name) const;
+
+    // First timestamp to last of the frame, which includes any gaps between passes
+    inline const PassTiming &GetFrameTiming() const
+    {
+        return m_FrameTiming;
+    }
+
+    // Counts up each time a frame's timings are read back
+    inline uint64_t GetCollectedFrames() const
+    {
+        return m_CollectedFrames;
+    }
+
+    bool ExportJSON(const std::string &path) const;
+
+  private:
+    struct RecordedPass
+    {
+        const char *name;
+        int depth;
+        unsigned beginQuery;
+        unsigned endQuery;
+    };
+
+    struct FrameQueries
+    {
+        std::vector<unsigned> queryPool;
+        size_t usedQueries = 0;
+        std::vector<RecordedPass> passes;
+        bool pending = false;
+    };
+
+    struct PassHistory
+    {
+        std::array<float, 120> samples = {};
+        size_t count = 0;
+        size_t next = 0;
+    };
+
+    unsigned NextQuery(FrameQueries &frame);
+    bool IsFrameAvailable(const FrameQueries &frame) const;
+    void CollectFrame(FrameQueries &frame);
+
+    static void AddSample(PassHistory &history, PassTiming &timing, float milliseconds);
+
+  private:
+    static std::shared_ptr<GPUProfiler> s_GPUProfiler;
+
+    static constexpr size_t s_BufferedFrames = 3;
+
+    std::array<FrameQueries, s_BufferedFrames> m_Frames;
+    size_t m_CurrentFrame = 0;
+    bool m_Recording = false;
+
+    // Indices into the current frame's passes, -1 for passes begun while the frame isn't being recorded
+    std::vector<int> m_OpenPasses;
+
+    std::vector<PassTiming> m_Passes;
+    std::unordered_map<std::string, PassHistory> m_History;
+    PassTiming m_FrameTiming;
+    PassHistory m_FrameHistory;
+    uint64_t m_CollectedFrames = 0;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // GPUPROFILER_H
@@ -0,0 +1,82 @@
+#ifndef MATERIALREGISTRY_H
+#define MATERIALREGISTRY_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/Material.h"
+#include "Rendering/Include/RenderingCommand.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Material table shared by every draw, uploaded as an SSBO so draws only carry an index into it. Entries are
+// re-uploaded only when they change, as a single dirty range per frame.
+class MaterialRegistry
+{
+  public:
+    // Mirrors MaterialEntry in the default shaders, std430. Texture fields are texture streamer handles, -1 if the
+    // material has none.
+    struct MaterialEntry
+    {
+        glm::vec4 diffuse = glm::vec4(0.0f);
+        glm::vec4 specular = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); // w is shininess
+        glm::vec4 baseColour = glm::vec4(0.0f);
+
+        int diffuseTexture = -1;
+        int specularTexture = -1;
+        int normalTexture = -1;
+        int heightTexture = -1;
+    };
+
+    static constexpr unsigned s_MaterialTableBinding = 2;
+
+    static void Init();
+
+    inline static std::shared_ptr<MaterialRegistry> &GetMaterialRegistryInstance()
+    {
+        MS_ASSERT(s_MaterialRegistry, "material registry failed to initialise");
+        return s_MaterialRegistry;
+    }
+
+    unsigned RegisterMaterial(const MaterialEntry &entry);
+    unsigned RegisterMaterial(const Material::Mat &material);
+    void UpdateMaterial(unsigned index, const Material::Mat &material);
+
+    inline const MaterialEntry &GetMaterial(unsigned index) const
+    {
+        return m_Materials[index];
+    }
+
+    inline size_t GetMaterialCount() const
+    {
+        return m_Materials.size();
+    }
+
+    static void ApplyMaterial(MaterialEntry &entry, const Material::Mat &material);
+
+    void Upload();
+    void Bind();
+
+  private:
+    void MarkDirty(size_t index);
+
+  private:
+    static std::shared_ptr<MaterialRegistry> s_MaterialRegistry;
+
+    std::vector<MaterialEntry> m_Materials;
+
+    unsigned m_Buffer = 0;
+    size_t m_Capacity = 0;
+
+    // Half-open range of entries edited since the last upload
+    size_t m_DirtyBegin = SIZE_MAX;
+    size_t m_DirtyEnd = 0;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // MATERIALREGISTRY_H
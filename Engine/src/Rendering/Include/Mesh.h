@@ -13,6 +13,7 @@ namespace Rendering
 
 #define MAX_BONE_INFLUENCE 4
 
+// CPU side geometry for one sub-mesh, models merge these into a single set of GPU buffers
 class Mesh
 {
     public:
@@ -39,22 +40,16 @@ class Mesh
         std::vector<Vertex>   vertices;
         std::vector<unsigned> indices;
         std::vector<Texture>  textures;
+        unsigned              materialIndex;
 
-        Mesh(std::vector<Vertex> vertices, std::vector<unsigned> indices, std::vector<Texture> textures)
+        Mesh(std::vector<Vertex> vertices, std::vector<unsigned> indices, std::vector<Texture> textures,
+             unsigned materialIndex)
             : vertices(std::move(vertices))
             , indices(std::move(indices))
             , textures(std::move(textures))
+            , materialIndex(materialIndex)
         {
-            SetupMesh();
         }
-
-        void Draw(Shader &shader);
-
-    private:
-        void SetupMesh();
-
-    private:
-        unsigned m_VAO, m_VBO, m_EBO;
 };
 
 } // namespace Rendering
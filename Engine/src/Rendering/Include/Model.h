@@ -1,8 +1,10 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include "Rendering/Include/MaterialRegistry.h"
 #include "Rendering/Include/Mesh.h"
 #include "Rendering/Include/Shader.h"
+#include "Rendering/Include/TextureStreamer.h"
 #include <assimp/Importer.hpp>
 #include <assimp/mesh.h>
 #include <assimp/postprocess.h>
@@ -35,10 +37,32 @@ class Model
         scale = glm::vec3(1);
     }
 
+    void RequestTextureResolution(int pixels);
+
+    inline float GetBoundingRadius() const
+    {
+        return m_BoundingRadius;
+    }
+
+    // Public so the micro benchmarks can time the conversion on its own
+    Mesh ProcessMesh(aiMesh *mesh, const aiScene *scene);
+
   private:
+    // Matches the layout glMultiDrawElementsIndirect reads
+    struct DrawCommand
+    {
+        unsigned count;
+        unsigned instanceCount;
+        unsigned firstIndex;
+        int baseVertex;
+        unsigned baseInstance;
+    };
+
+    static constexpr int s_MaterialIndexAttribute = 7;
+
     void LoadModel(std::string &path);
+    void SetupBuffers();
     void ProcessNode(aiNode *node, const aiScene *scene);
-    Mesh ProcessMesh(aiMesh *mesh, const aiScene *scene);
     std::vector<Mesh::Texture> LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
     unsigned TextureFromFile(const std::string &path, const std::string &directory, bool gamma = false);
 
@@ -51,6 +75,13 @@ class Model
     std::vector<Mesh> m_Meshes;
     std::string m_Directory;
     std::vector<Mesh::Texture> m_TexturesLoaded;
+    float m_BoundingRadius = 0.0f;
+    std::unordered_map<unsigned, unsigned> m_MaterialsBySceneIndex;
+
+    unsigned m_VAO = 0, m_VBO = 0, m_EBO = 0;
+    unsigned m_DrawMaterialBuffer = 0, m_IndirectBuffer = 0;
+    int m_DrawCount = 0;
+    size_t m_IndexCount = 0;
 };
 
 } // namespace Rendering
@@ -0,0 +1,108 @@
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RenderingCommand.h"
+#include "Rendering/Include/Shader.h"
+#include <array>
+#include <glm/glm.hpp>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Frustum and hierarchical-Z occlusion culling for bounding spheres.
+//
+// Once a frame's depth is final it is reduced on the GPU into a max-depth pyramid and a small level is copied
+// back through a pixel buffer without stalling. When a copy lands a few frames later the CPU finishes the pyramid
+// and tests bounds against it using the camera that rendered that depth, so the test reprojects each object into
+// the older frame rather than trusting stale screen positions. Anything the older frame can't vouch for, such as
+// bounds outside its view or crossing its near plane, or depth that is too old, is treated as visible.
+class OcclusionCuller
+{
+  public:
+    struct Stats
+    {
+        unsigned testedCount = 0;
+        unsigned frustumCulledCount = 0;
+        unsigned occlusionCulledCount = 0;
+
+        // Frames between the depth used for testing and the current frame, -1 when none is available
+        int depthAge = -1;
+    };
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller &) = delete;
+    OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+    // Collects finished readbacks and sets up this frame's frustum, call before any visibility test
+    void BeginFrame(const glm::mat4 &view, const glm::mat4 &projection, bool occlusionEnabled);
+    bool IsVisible(const glm::vec3 &centre, float radius);
+
+    // Call once the frame's depth buffer is final. The pyramid is sized from the full resolution view rather than
+    // the depth texture, so dynamic resolution changing the render scale doesn't rebuild it or drop its readbacks
+    void BuildDepthPyramid(unsigned depthTexture, int viewWidth, int viewHeight);
+
+    inline const Stats &GetStats() const
+    {
+        return m_Stats;
+    }
+
+  private:
+    struct Readback
+    {
+        unsigned buffer = 0;
+        RenderingAPI::Fence fence = nullptr;
+        glm::mat4 view, projection;
+        uint64_t frame = 0;
+        bool pending = false;
+    };
+
+    bool IsInFrustum(const glm::vec3 &centre, float radius) const;
+    bool IsOccluded(const glm::vec3 &centre, float radius) const;
+
+    void CollectReadbacks();
+    void BuildCPUPyramid();
+    void ResizePyramid(int width, int height);
+    void ReleaseReadbacks();
+
+  private:
+    static constexpr unsigned s_ReadbackCount = 3;
+    static constexpr int s_MaxReadbackSize = 128;
+    static constexpr uint64_t s_MaxDepthAge = 4;
+    static constexpr unsigned s_GroupSize = 8;
+
+    Shader m_DownsampleShader;
+
+    // GPU pyramid, level 0 is half the view and the last level is the one read back
+    unsigned m_PyramidTexture = 0;
+    int m_ViewWidth = 0, m_ViewHeight = 0;
+    std::vector<glm::ivec2> m_PyramidSizes;
+
+    std::array<Readback, s_ReadbackCount> m_Readbacks;
+    unsigned m_NextReadback = 0;
+
+    // CPU pyramid built from the newest readback, and the camera that rendered it
+    std::vector<std::vector<float>> m_DepthLevels;
+    std::vector<glm::ivec2> m_DepthSizes;
+    glm::mat4 m_DepthView, m_DepthProjection;
+    uint64_t m_DepthFrame = 0;
+    bool m_HasDepth = false;
+
+    glm::mat4 m_View, m_Projection;
+    std::array<glm::vec4, 6> m_FrustumPlanes;
+    bool m_OcclusionEnabled = true;
+
+    uint64_t m_Frame = 0;
+    Stats m_Stats;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // OCCLUSIONCULLER_H
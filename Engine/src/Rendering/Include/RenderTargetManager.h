@@ -0,0 +1,124 @@
+#ifndef RENDERTARGETMANAGER_H
+#define RENDERTARGETMANAGER_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RenderingCommand.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Owns every offscreen framebuffer and its attachments. Persistent targets are resized by request and the request
+// is applied in BeginFrame(), so a target is only reallocated when its size really changes and never while a
+// frame might still be sampling it.
+//
+// Transient targets are pooled by description: releasing one hands it back to the pool, and an acquire with the
+// same size and attachments reuses it instead of going back to the driver. Pooled targets that sit unused for a
+// few frames are freed.
+class RenderTargetManager
+{
+  public:
+    using Handle = unsigned;
+
+    static constexpr Handle s_InvalidHandle = UINT32_MAX;
+
+    struct RenderTargetDesc
+    {
+        int width = 0, height = 0;
+        bool hasColor = true;
+        bool hasDepth = true;
+
+        inline bool operator==(const RenderTargetDesc &other) const
+        {
+            return width == other.width && height == other.height && hasColor == other.hasColor &&
+                   hasDepth == other.hasDepth;
+        }
+    };
+
+    struct RenderTarget
+    {
+        RenderTargetDesc desc;
+        unsigned FBO = 0;
+        unsigned colorTexture = 0;
+        unsigned depthTexture = 0;
+    };
+
+    struct Stats
+    {
+        size_t allocatedBytes = 0;
+
+        unsigned persistentCount = 0;
+        unsigned transientCount = 0;
+        unsigned transientInUse = 0;
+        unsigned allocationsLastFrame = 0;
+        unsigned totalAllocations = 0;
+    };
+
+    static void Init();
+
+    // Releases every target and drops the instance, call while the GL context is still alive
+    static void Shutdown();
+
+    inline static std::shared_ptr<RenderTargetManager> &GetRenderTargetManagerInstance()
+    {
+        MS_ASSERT(s_RenderTargetManager, "render target manager failed to initialise");
+        return s_RenderTargetManager;
+    }
+
+    Handle CreateTarget(const RenderTargetDesc &desc);
+    void Resize(Handle handle, int width, int height);
+
+    Handle AcquireTransient(const RenderTargetDesc &desc);
+    void ReleaseTransient(Handle handle);
+
+    void BeginFrame();
+
+    inline const RenderTarget &GetTarget(Handle handle) const
+    {
+        return m_Targets[handle].target;
+    }
+
+    inline const Stats &GetStats() const
+    {
+        return m_Stats;
+    }
+
+  private:
+    struct TargetEntry
+    {
+        RenderTarget target;
+
+        // Size asked for since the last BeginFrame, persistent targets only
+        int requestedWidth = 0, requestedHeight = 0;
+
+        bool transient = false;
+        bool inUse = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    Handle AddEntry(const TargetEntry &entry);
+    void Allocate(RenderTarget &target);
+    void Release(RenderTarget &target);
+
+    static size_t TargetBytes(const RenderTargetDesc &desc);
+
+  private:
+    static std::shared_ptr<RenderTargetManager> s_RenderTargetManager;
+
+    static constexpr uint64_t s_TransientLifetimeFrames = 8;
+
+    std::vector<TargetEntry> m_Targets;
+    std::vector<Handle> m_FreeHandles;
+
+    uint64_t m_Frame = 0;
+    unsigned m_FrameAllocations = 0;
+    Stats m_Stats;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // RENDERTARGETMANAGER_H
@@ -4,8 +4,14 @@
 #include "Core/Include/Window.h"
 #include "Include/EditorUI.h"
 #include "Rendering/Include/Camera.h"
+#include "Rendering/Include/ClusteredLighting.h"
+#include "Rendering/Include/DynamicResolution.h"
+#include "Rendering/Include/OcclusionCuller.h"
+#include "Rendering/Include/RenderTargetManager.h"
 #include "Rendering/Include/RenderingCommand.h"
+#include "Rendering/Include/RingBuffer.h"
 #include "Rendering/Include/Scene.h"
+#include "Rendering/Include/ShadowMaps.h"
 #include "Tools/Include/BaseShapes.h"
 
 namespace Moonstone
@@ -17,6 +23,23 @@ namespace Rendering
 class Renderer
 {
   public:
+    // Mirrors the std140 FrameData/DrawData blocks in the default shaders
+    struct FrameData
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 viewPos;
+        glm::vec4 clusterParams;
+        glm::ivec4 clusterGrid;
+    };
+
+    struct DrawData
+    {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;
+        glm::ivec4 drawInfo; // x is the material index
+    };
+
     Renderer(std::shared_ptr<Scene> scene);
 
     inline void SetWindow(std::shared_ptr<Core::Window> window)
@@ -29,22 +52,70 @@ class Renderer
         m_SceneRenderTarget = editorUI;
     }
 
+    inline RenderTargetManager::Handle GetSceneTarget() const
+    {
+        return m_SceneTarget;
+    }
+
     void InitializeActiveCamera();
     void InitializeScene();
     void InitializeFramebuffer();
 
     void RenderScene();
     void SetupCamera();
+    void CullScene();
+    void RenderShadowMaps();
+    bool RenderShadowCasters(const glm::mat4 &view, const glm::mat4 &projection);
     void RenderEditorGrid();
+    void RenderDepthPrepass();
     void RenderVisibleObjects();
     void RenderVisibleModels();
+    void RenderUpscale(const RenderTargetManager::RenderTarget &source,
+                       const RenderTargetManager::RenderTarget &destination);
+    void UpdateRenderScale();
 
     template <typename T> void RenderLighting(T &object);
+    RingBuffer::Allocation AllocateDrawData(const glm::mat4 &model, int materialIndex = -1);
+    bool PushDrawData(const glm::mat4 &model, int materialIndex = -1);
 
     void CleanupScene();
     void DeactivateDirectionalLight();
     void DeactivatePointLight(Lighting::Light &light);
 
+    // Sets the directional light's uniforms through Uniforms' setters, which take the same arguments as
+    // RenderingCommand's. Returns the number of uniforms set
+    template <typename Uniforms = RenderingCommand>
+    static unsigned SetLightUniforms(unsigned shaderID, const std::vector<Lighting::Light> &lights)
+    {
+        unsigned uniformCount = 0;
+
+        // Only the directional light is a uniform, point lights come from the cluster buffers
+        for (const auto &light : lights)
+        {
+            if (light.type == Lighting::LightType::Directional)
+            {
+                Uniforms::SetUniformVec3(shaderID, "dirLight.direction", light.direction);
+                Uniforms::SetUniformVec3(shaderID, "dirLight.ambient", light.ambient);
+                Uniforms::SetUniformVec3(shaderID, "dirLight.diffuse", light.diffuse);
+                Uniforms::SetUniformVec3(shaderID, "dirLight.specular", light.specular);
+                Uniforms::SetUniformBool(shaderID, "dirLight.isActive", light.isActive);
+                uniformCount += 5;
+            }
+        }
+
+        return uniformCount;
+    }
+
+    // User applied transformations
+    template <typename T> static glm::mat4 GetTransformationMatrix(const T &entity)
+    {
+        return glm::translate(glm::mat4(1.0f), entity.position) *
+               glm::rotate(glm::mat4(1.0f), glm::radians(entity.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)) *
+               glm::rotate(glm::mat4(1.0f), glm::radians(entity.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
+               glm::rotate(glm::mat4(1.0f), glm::radians(entity.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
+               glm::scale(glm::mat4(1.0f), entity.scale);
+    }
+
   private:
     // Scene
     std::shared_ptr<Scene> m_Scene;
@@ -54,9 +125,51 @@ class Renderer
     // Objects
     unsigned m_VAO, m_VBO;
 
-    // Frame Buffer
+    // Per-frame uniform data
+    static constexpr unsigned s_FrameDataBinding = 0;
+    static constexpr unsigned s_DrawDataBinding = 1;
+    static constexpr size_t s_UniformRingSegmentSize = 4 * 1024 * 1024;
+    std::unique_ptr<RingBuffer> m_UniformRing;
+    RingBuffer::Allocation m_FrameDataAllocation;
+
+    // Point lights
+    std::unique_ptr<ClusteredLighting> m_ClusteredLighting;
+
+    // Depth pre-pass, draws are rebuilt and sorted front to back every frame
+    struct DepthPrepassDraw
+    {
+        float distance;
+        glm::mat4 transform;
+        unsigned vao;
+        size_t size;
+        Model *model;
+    };
+
+    Shader m_DepthShader;
+    std::vector<DepthPrepassDraw> m_DepthPrepassDraws;
+
+    // Visibility
+    std::unique_ptr<OcclusionCuller> m_OcclusionCuller;
+    std::vector<bool> m_ObjectVisibility, m_ModelVisibility;
+
+    // Shadows, caster draw data is written once per frame and shared by every cascade and cube face redrawn
+    std::unique_ptr<ShadowMaps> m_ShadowMaps;
+    std::vector<RingBuffer::Allocation> m_ShadowCasterDrawData;
+
+    // Dynamic resolution, the GPU profiler's timing of the scene pass decides the internal render scale
+    static constexpr float s_UpscaleSharpness = 0.5f;
+    static constexpr const char *s_ScenePassName = "Scene";
+    uint64_t m_CollectedGPUFrames = 0;
+    std::unique_ptr<DynamicResolution> m_DynamicResolution;
+    Shader m_UpscaleShader;
+
+    // Frame Buffer, sized to the editor's scene view rather than the window
     std::shared_ptr<Core::EditorUI> m_SceneRenderTarget;
-    unsigned m_FBShaderID, m_FBO, m_FBOTextureMap, m_FBODepthTexture, m_ScreenQuadVAO, m_ScreenQuadVBO;
+    RenderTargetManager::Handle m_SceneTarget = RenderTargetManager::s_InvalidHandle;
+
+    // Size of the target this frame renders into, smaller than the scene target under dynamic resolution
+    int m_TargetWidth = 1, m_TargetHeight = 1;
+    unsigned m_FBShaderID, m_ScreenQuadVAO, m_ScreenQuadVBO;
 };
 
 } // namespace Rendering
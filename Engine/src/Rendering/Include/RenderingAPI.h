@@ -51,7 +51,9 @@ class RenderingAPI
     {
         Texture1D,
         Texture2D,
-        Texture3D
+        Texture3D,
+        Texture2DArray,
+        TextureCubeMapArray
     };
 
     enum class TextureParameterName
@@ -70,6 +72,42 @@ class RenderingAPI
         Repeat,
     };
 
+    enum class BufferTarget
+    {
+        Array,
+        ElementArray,
+        Uniform,
+        ShaderStorage,
+        DrawIndirect,
+        PixelPack
+    };
+
+    enum class ImageAccess
+    {
+        ReadOnly,
+        WriteOnly,
+        ReadWrite
+    };
+
+    enum class MemoryBarrierType
+    {
+        ShaderImageAccess,
+        TextureFetch,
+        PixelBuffer,
+        All
+    };
+
+    enum class DepthFunction
+    {
+        Less,
+        LessEqual,
+        Equal,
+        Always
+    };
+
+    // Opaque GPU fence, owned by the implementation between InsertFence and WaitFence
+    using Fence = void *;
+
     enum class TextureFormat
     {
         Red,
@@ -112,6 +150,10 @@ class RenderingAPI
     virtual void InitVertexShader(unsigned &vertexShader, const char *vertexShaderSrc) = 0;
     virtual void InitFragmentShader(unsigned &fragmentShader, const char *fragmentShaderSrc) = 0;
     virtual void InitShaderProgram(unsigned &shaderProgram, unsigned &vertexShader, unsigned &fragmentShader) = 0;
+    virtual void InitComputeShader(unsigned &computeShader, const char *computeShaderSrc) = 0;
+    virtual void InitComputeProgram(unsigned &shaderProgram, unsigned &computeShader) = 0;
+    virtual void DispatchCompute(unsigned groupsX, unsigned groupsY, unsigned groupsZ) = 0;
+    virtual void InsertMemoryBarrier(MemoryBarrierType barrier) = 0;
     virtual void InitVertexArray(unsigned &VAO) = 0;
     virtual void InitVertexBuffer(unsigned &VBO, float *vertices, size_t size) = 0;
     virtual void BindVertexBuffer(unsigned &VBO) = 0;
@@ -120,19 +162,49 @@ class RenderingAPI
     virtual void InitVertexAttributes(int index, int size, NumericalDataType type, BooleanDataType normalize,
                                       size_t stride, size_t offset) = 0;
 
+    virtual void InitIntegerVertexAttributes(int index, int size, NumericalDataType type, size_t stride,
+                                             size_t offset) = 0;
+    virtual void SetVertexAttributeDivisor(int index, unsigned divisor) = 0;
+
+    virtual void InitBuffer(unsigned &buffer, size_t size, const void *data, bool dynamic) = 0;
+    virtual void UpdateBuffer(unsigned buffer, size_t offset, size_t size, const void *data) = 0;
+    virtual void BindBuffer(BufferTarget target, unsigned buffer) = 0;
+    virtual void BindBufferBase(BufferTarget target, unsigned bindingIndex, unsigned buffer) = 0;
+    virtual void InitPersistentBuffer(unsigned &buffer, size_t size, void *&mappedData) = 0;
+    virtual void BindBufferRange(BufferTarget target, unsigned bindingIndex, unsigned buffer, size_t offset,
+                                 size_t size) = 0;
+    virtual size_t GetBufferOffsetAlignment(BufferTarget target) = 0;
+    virtual void DeleteBuffer(unsigned &buffer) = 0;
+    virtual void ReadBuffer(unsigned buffer, size_t offset, size_t size, void *data) = 0;
+
+    virtual Fence InsertFence() = 0;
+    virtual void WaitFence(Fence &fence) = 0;
+    virtual bool IsFenceSignalled(Fence &fence) = 0;
+
+    // GPU timer queries, results are in nanoseconds and should only be read once available
+    virtual void CreateQuery(unsigned &query) = 0;
+    virtual void DeleteQuery(unsigned &query) = 0;
+    virtual void QueryTimestamp(unsigned query) = 0;
+    virtual bool IsQueryResultAvailable(unsigned query) = 0;
+    virtual uint64_t GetQueryResult(unsigned query) = 0;
+
+    // Vendor, renderer and version of the device the context is running on
+    virtual std::string GetDeviceDescription() = 0;
+
     virtual void SetPolygonMode(PolygonDataType dataType) = 0;
     virtual void SetViewport(int width, int height) = 0;
 
     virtual void SubmitDrawCommands(unsigned shaderProgram, unsigned VAO, size_t size) = 0;
     virtual void SubmitDrawArrays(DrawMode drawMode, int index, int count) = 0;
+    virtual void SubmitMultiDrawIndirect(unsigned VAO, unsigned indirectBuffer, int drawCount) = 0;
 
     virtual void Cleanup(unsigned &VAO, unsigned &VBO, unsigned &shaderProgram) = 0;
 
     virtual void UseProgram(unsigned &ID) = 0;
 
     virtual void SetUniformBool(const unsigned &ID, const std::string &name, bool value) = 0;
-    virtual void SetUniformInt(const unsigned &ID, const std::string &name, bool value) = 0;
-    virtual void SetUniformFloat(const unsigned &ID, const std::string &name, bool value) = 0;
+    virtual void SetUniformInt(const unsigned &ID, const std::string &name, int value) = 0;
+    virtual void SetUniformFloat(const unsigned &ID, const std::string &name, float value) = 0;
     virtual void SetUniformMat4(const unsigned &ID, const std::string &name, glm::mat4 value) = 0;
     virtual void SetUniformVec3(const unsigned &ID, const std::string &name, glm::vec3 value) = 0;
 
@@ -140,19 +212,47 @@ class RenderingAPI
     virtual void SetTextureParameters(TextureTarget target, TextureParameterName paramName, TextureParameter param) = 0;
     virtual void UploadTexture(TextureTarget target, int mipmapLevel, TextureFormat texFormat, int x, int y,
                                TextureFormat imageDataType, NumericalDataType dataType, unsigned char *texData) = 0;
+    virtual void SetTextureMipRange(TextureTarget target, int baseLevel, int maxLevel) = 0;
+    virtual void DeleteTexture(unsigned &texture) = 0;
+
+    virtual void CreateTextureArray(unsigned &texture) = 0;
+    virtual void AllocateTextureArrayLevel(int mipmapLevel, int width, int height, int layers) = 0;
+    virtual void UploadTextureArrayLayer(int mipmapLevel, int layer, int width, int height, TextureFormat imageDataType,
+                                         NumericalDataType dataType, const unsigned char *texData) = 0;
+    virtual void CopyTextureArrayLayers(unsigned source, unsigned destination, int mipmapLevel, int width, int height,
+                                        int layers) = 0;
 
     virtual void BindTexture(Texture texture, TextureTarget target, unsigned textureObject) = 0;
 
+    // Single channel 32-bit float textures with a full mip chain, used for GPU built data like depth pyramids
+    virtual void InitFloatTexture(unsigned &texture, int width, int height, int mipmapLevels) = 0;
+    virtual void BindImageTexture(unsigned unit, unsigned texture, int mipmapLevel, ImageAccess access) = 0;
+    virtual void ReadFloatTextureToBuffer(unsigned texture, int mipmapLevel, unsigned buffer, size_t size) = 0;
+
+    // Depth textures with hardware comparison enabled, layers are cube faces for TextureCubeMapArray
+    virtual void InitShadowTexture(unsigned &texture, TextureTarget target, int size, int layers) = 0;
+
     virtual void EnableBlending() = 0;
     virtual void DisableBlending() = 0;
     virtual void EnableDepthMask() = 0;
     virtual void DisableDepthMask() = 0;
+    virtual void EnablePolygonOffset(float factor, float units) = 0;
+    virtual void DisablePolygonOffset() = 0;
+    virtual void SetDepthFunction(DepthFunction function) = 0;
+    virtual void EnableColorMask() = 0;
+    virtual void DisableColorMask() = 0;
 
     virtual void BindFrameBuffer(unsigned int &FBO) = 0;
     virtual void DrawFrameBuffer(unsigned &shaderID, unsigned &quadVAO, unsigned &FBOTexMap) = 0;
-    virtual void InitFrameBuffer(int &width, int &height, unsigned &FBOTextureMap, unsigned &FBODepthTexture,
-                                 unsigned &FBO, unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO) = 0;
-    virtual void RescaleFramebuffer(unsigned &texMap, int &width, int &height) = 0;
+    virtual void InitScreenQuad(unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO) = 0;
+
+    // Fixed size render target attachments, a new texture is needed to change size. Either attachment may be 0.
+    virtual void InitColorTarget(unsigned &texture, int width, int height) = 0;
+    virtual void InitDepthTarget(unsigned &texture, int width, int height) = 0;
+    virtual bool InitFrameBuffer(unsigned &FBO, unsigned colorTexture, unsigned depthTexture) = 0;
+    virtual void DeleteFrameBuffer(unsigned &FBO) = 0;
+    virtual void InitDepthFrameBuffer(unsigned &FBO) = 0;
+    virtual void AttachDepthLayer(unsigned FBO, unsigned texture, int layer) = 0;
 
   private:
     static API s_API;
@@ -12,20 +12,68 @@ namespace Rendering
 class RenderingCommand
 {
   public:
+    // Counted by the wrappers below as commands are issued, from the render thread only
+    struct Stats
+    {
+        unsigned drawCalls = 0;
+        unsigned indirectDraws = 0;
+        uint64_t triangles = 0;
+        unsigned computeDispatches = 0;
+
+        unsigned programSwitches = 0;
+        unsigned stateChanges = 0;
+        unsigned uniformUploads = 0;
+
+        // Writes through persistently mapped buffers don't go through here and aren't counted
+        unsigned bufferUploads = 0;
+        size_t uploadedBytes = 0;
+        unsigned textureUploads = 0;
+
+        unsigned bufferBinds = 0;
+        unsigned vertexArrayBinds = 0;
+        unsigned textureBinds = 0;
+        unsigned framebufferBinds = 0;
+    };
+
+    // Called once at the start of every frame, the finished frame's counts move to GetLastFrameStats()
+    inline static void ResetStats()
+    {
+        s_LastFrameStats = s_Stats;
+        s_Stats = Stats();
+    }
+
+    inline static const Stats &GetStats()
+    {
+        return s_Stats;
+    }
+
+    inline static const Stats &GetLastFrameStats()
+    {
+        return s_LastFrameStats;
+    }
+
     inline static void EnableDepthTesting()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->EnableDepthTesting();
     }
     inline static void EnableFaceCulling()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->EnableFaceCulling();
     }
     inline static void DisableFaceCulling()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->DisableFaceCulling();
     }
     inline static void ClearColor(const glm::vec4 &color)
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->ClearColor(color);
     }
     inline static void Clear()
@@ -48,6 +96,28 @@ class RenderingCommand
         s_RenderingAPI->InitShaderProgram(shaderProgram, vertexShader, fragmentShader);
     }
 
+    inline static void InitComputeShader(unsigned &computeShader, const char *computeShaderSrc)
+    {
+        s_RenderingAPI->InitComputeShader(computeShader, computeShaderSrc);
+    }
+
+    inline static void InitComputeProgram(unsigned &shaderProgram, unsigned &computeShader)
+    {
+        s_RenderingAPI->InitComputeProgram(shaderProgram, computeShader);
+    }
+
+    inline static void DispatchCompute(unsigned groupsX, unsigned groupsY, unsigned groupsZ)
+    {
+        ++s_Stats.computeDispatches;
+
+        s_RenderingAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+    }
+
+    inline static void InsertMemoryBarrier(RenderingAPI::MemoryBarrierType barrier)
+    {
+        s_RenderingAPI->InsertMemoryBarrier(barrier);
+    }
+
     inline static void InitVertexArray(unsigned &VAO)
     {
         s_RenderingAPI->InitVertexArray(VAO);
@@ -60,10 +130,14 @@ class RenderingCommand
 
     inline static void BindVertexBuffer(unsigned &VBO)
     {
+        ++s_Stats.bufferBinds;
+
         s_RenderingAPI->BindVertexBuffer(VBO);
     }
     inline static void BindVertexArray(unsigned int &VAO)
     {
+        ++s_Stats.vertexArrayBinds;
+
         s_RenderingAPI->BindVertexArray(VAO);
     }
 
@@ -78,26 +152,158 @@ class RenderingCommand
         s_RenderingAPI->InitVertexAttributes(index, size, type, normalize, stride, offset);
     };
 
+    inline static void InitIntegerVertexAttributes(int index, int size, RenderingAPI::NumericalDataType type,
+                                                   size_t stride, size_t offset)
+    {
+        s_RenderingAPI->InitIntegerVertexAttributes(index, size, type, stride, offset);
+    }
+
+    inline static void SetVertexAttributeDivisor(int index, unsigned divisor)
+    {
+        s_RenderingAPI->SetVertexAttributeDivisor(index, divisor);
+    }
+
+    inline static void InitBuffer(unsigned &buffer, size_t size, const void *data, bool dynamic)
+    {
+        s_RenderingAPI->InitBuffer(buffer, size, data, dynamic);
+    }
+
+    inline static void UpdateBuffer(unsigned buffer, size_t offset, size_t size, const void *data)
+    {
+        ++s_Stats.bufferUploads;
+        s_Stats.uploadedBytes += size;
+
+        s_RenderingAPI->UpdateBuffer(buffer, offset, size, data);
+    }
+
+    inline static void BindBuffer(RenderingAPI::BufferTarget target, unsigned buffer)
+    {
+        ++s_Stats.bufferBinds;
+
+        s_RenderingAPI->BindBuffer(target, buffer);
+    }
+
+    inline static void BindBufferBase(RenderingAPI::BufferTarget target, unsigned bindingIndex, unsigned buffer)
+    {
+        ++s_Stats.bufferBinds;
+
+        s_RenderingAPI->BindBufferBase(target, bindingIndex, buffer);
+    }
+
+    inline static void InitPersistentBuffer(unsigned &buffer, size_t size, void *&mappedData)
+    {
+        s_RenderingAPI->InitPersistentBuffer(buffer, size, mappedData);
+    }
+
+    inline static void BindBufferRange(RenderingAPI::BufferTarget target, unsigned bindingIndex, unsigned buffer,
+                                       size_t offset, size_t size)
+    {
+        ++s_Stats.bufferBinds;
+
+        s_RenderingAPI->BindBufferRange(target, bindingIndex, buffer, offset, size);
+    }
+
+    inline static size_t GetBufferOffsetAlignment(RenderingAPI::BufferTarget target)
+    {
+        return s_RenderingAPI->GetBufferOffsetAlignment(target);
+    }
+
+    inline static void DeleteBuffer(unsigned &buffer)
+    {
+        s_RenderingAPI->DeleteBuffer(buffer);
+    }
+
+    inline static void ReadBuffer(unsigned buffer, size_t offset, size_t size, void *data)
+    {
+        s_RenderingAPI->ReadBuffer(buffer, offset, size, data);
+    }
+
+    inline static RenderingAPI::Fence InsertFence()
+    {
+        return s_RenderingAPI->InsertFence();
+    }
+
+    inline static void WaitFence(RenderingAPI::Fence &fence)
+    {
+        s_RenderingAPI->WaitFence(fence);
+    }
+
+    inline static bool IsFenceSignalled(RenderingAPI::Fence &fence)
+    {
+        return s_RenderingAPI->IsFenceSignalled(fence);
+    }
+
+    inline static void CreateQuery(unsigned &query)
+    {
+        s_RenderingAPI->CreateQuery(query);
+    }
+
+    inline static void DeleteQuery(unsigned &query)
+    {
+        s_RenderingAPI->DeleteQuery(query);
+    }
+
+    inline static void QueryTimestamp(unsigned query)
+    {
+        s_RenderingAPI->QueryTimestamp(query);
+    }
+
+    inline static bool IsQueryResultAvailable(unsigned query)
+    {
+        return s_RenderingAPI->IsQueryResultAvailable(query);
+    }
+
+    inline static uint64_t GetQueryResult(unsigned query)
+    {
+        return s_RenderingAPI->GetQueryResult(query);
+    }
+
+    inline static std::string GetDeviceDescription()
+    {
+        return s_RenderingAPI->GetDeviceDescription();
+    }
+
     inline static void SetPolygonMode(RenderingAPI::PolygonDataType dataType)
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->SetPolygonMode(dataType);
     };
 
     inline static void SetViewport(int width, int height)
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->SetViewport(width, height);
     }
 
     inline static void SubmitDrawCommands(unsigned shaderProgram, unsigned VAO, size_t size)
     {
+        ++s_Stats.drawCalls;
+        s_Stats.triangles += size / 3;
+
         s_RenderingAPI->SubmitDrawCommands(shaderProgram, VAO, size);
     };
 
     inline static void SubmitDrawArrays(RenderingAPI::DrawMode drawMode, int index, int count)
     {
+        ++s_Stats.drawCalls;
+        if (drawMode == RenderingAPI::DrawMode::Triangles)
+            s_Stats.triangles += count / 3;
+
         s_RenderingAPI->SubmitDrawArrays(drawMode, index, count);
     };
 
+    // indexCount is the total across every draw in the buffer, only used for the stats
+    inline static void SubmitMultiDrawIndirect(unsigned VAO, unsigned indirectBuffer, int drawCount, size_t indexCount)
+    {
+        ++s_Stats.drawCalls;
+        s_Stats.indirectDraws += drawCount;
+        s_Stats.triangles += indexCount / 3;
+
+        s_RenderingAPI->SubmitMultiDrawIndirect(VAO, indirectBuffer, drawCount);
+    }
+
     inline static void Cleanup(unsigned &VAO, unsigned &VBO, unsigned &shaderProgram)
     {
         s_RenderingAPI->Cleanup(VAO, VBO, shaderProgram);
@@ -105,31 +311,43 @@ class RenderingCommand
 
     inline static void UseProgram(unsigned &ID)
     {
+        ++s_Stats.programSwitches;
+
         s_RenderingAPI->UseProgram(ID);
     }
 
     inline static void SetUniformBool(const unsigned &ID, const std::string &name, bool value)
     {
+        ++s_Stats.uniformUploads;
+
         s_RenderingAPI->SetUniformBool(ID, name, value);
     };
 
-    inline static void SetUniformInt(const unsigned &ID, const std::string &name, bool value)
+    inline static void SetUniformInt(const unsigned &ID, const std::string &name, int value)
     {
+        ++s_Stats.uniformUploads;
+
         s_RenderingAPI->SetUniformInt(ID, name, value);
     };
 
     inline static void SetUniformFloat(const unsigned &ID, const std::string &name, float value)
     {
+        ++s_Stats.uniformUploads;
+
         s_RenderingAPI->SetUniformFloat(ID, name, value);
     };
 
     inline static void SetUniformMat4(const unsigned &ID, const std::string &name, glm::mat4 value)
     {
+        ++s_Stats.uniformUploads;
+
         s_RenderingAPI->SetUniformMat4(ID, name, value);
     };
 
     inline static void SetUniformVec3(const unsigned &ID, const std::string &name, glm::vec3 value)
     {
+        ++s_Stats.uniformUploads;
+
         s_RenderingAPI->SetUniformVec3(ID, name, value);
     };
 
@@ -150,37 +368,144 @@ class RenderingCommand
                                      RenderingAPI::TextureFormat imageDataType,
                                      RenderingAPI::NumericalDataType dataType, unsigned char *texData)
     {
+        ++s_Stats.textureUploads;
+
         s_RenderingAPI->UploadTexture(target, mipmapLevel, texFormat, x, y, imageDataType, dataType, texData);
     };
 
+    inline static void SetTextureMipRange(RenderingAPI::TextureTarget target, int baseLevel, int maxLevel)
+    {
+        s_RenderingAPI->SetTextureMipRange(target, baseLevel, maxLevel);
+    }
+
+    inline static void DeleteTexture(unsigned &texture)
+    {
+        s_RenderingAPI->DeleteTexture(texture);
+    }
+
+    inline static void CreateTextureArray(unsigned &texture)
+    {
+        s_RenderingAPI->CreateTextureArray(texture);
+    }
+
+    inline static void AllocateTextureArrayLevel(int mipmapLevel, int width, int height, int layers)
+    {
+        s_RenderingAPI->AllocateTextureArrayLevel(mipmapLevel, width, height, layers);
+    }
+
+    inline static void UploadTextureArrayLayer(int mipmapLevel, int layer, int width, int height,
+                                               RenderingAPI::TextureFormat imageDataType,
+                                               RenderingAPI::NumericalDataType dataType, const unsigned char *texData)
+    {
+        ++s_Stats.textureUploads;
+
+        s_RenderingAPI->UploadTextureArrayLayer(mipmapLevel, layer, width, height, imageDataType, dataType, texData);
+    }
+
+    inline static void CopyTextureArrayLayers(unsigned source, unsigned destination, int mipmapLevel, int width,
+                                              int height, int layers)
+    {
+        s_RenderingAPI->CopyTextureArrayLayers(source, destination, mipmapLevel, width, height, layers);
+    }
+
     inline static void BindTexture(RenderingAPI::Texture texture, RenderingAPI::TextureTarget target,
                                    unsigned textureObject)
     {
+        ++s_Stats.textureBinds;
+
         s_RenderingAPI->BindTexture(texture, target, textureObject);
     }
 
+    inline static void InitFloatTexture(unsigned &texture, int width, int height, int mipmapLevels)
+    {
+        s_RenderingAPI->InitFloatTexture(texture, width, height, mipmapLevels);
+    }
+
+    inline static void BindImageTexture(unsigned unit, unsigned texture, int mipmapLevel,
+                                        RenderingAPI::ImageAccess access)
+    {
+        ++s_Stats.textureBinds;
+
+        s_RenderingAPI->BindImageTexture(unit, texture, mipmapLevel, access);
+    }
+
+    inline static void ReadFloatTextureToBuffer(unsigned texture, int mipmapLevel, unsigned buffer, size_t size)
+    {
+        s_RenderingAPI->ReadFloatTextureToBuffer(texture, mipmapLevel, buffer, size);
+    }
+
+    inline static void InitShadowTexture(unsigned &texture, RenderingAPI::TextureTarget target, int size, int layers)
+    {
+        s_RenderingAPI->InitShadowTexture(texture, target, size, layers);
+    }
+
     inline static void EnableBlending()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->EnableBlending();
     }
 
     inline static void DisableBlending()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->DisableBlending();
     }
 
     inline static void EnableDepthMask()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->EnableDepthMask();
     };
 
     inline static void DisableDepthMask()
     {
+        ++s_Stats.stateChanges;
+
         s_RenderingAPI->DisableDepthMask();
     };
 
+    inline static void EnablePolygonOffset(float factor, float units)
+    {
+        ++s_Stats.stateChanges;
+
+        s_RenderingAPI->EnablePolygonOffset(factor, units);
+    }
+
+    inline static void DisablePolygonOffset()
+    {
+        ++s_Stats.stateChanges;
+
+        s_RenderingAPI->DisablePolygonOffset();
+    }
+
+    inline static void SetDepthFunction(RenderingAPI::DepthFunction function)
+    {
+        ++s_Stats.stateChanges;
+
+        s_RenderingAPI->SetDepthFunction(function);
+    }
+
+    inline static void EnableColorMask()
+    {
+        ++s_Stats.stateChanges;
+
+        s_RenderingAPI->EnableColorMask();
+    }
+
+    inline static void DisableColorMask()
+    {
+        ++s_Stats.stateChanges;
+
+        s_RenderingAPI->DisableColorMask();
+    }
+
     inline static void BindFrameBuffer(unsigned int &FBO)
     {
+        ++s_Stats.framebufferBinds;
+
         s_RenderingAPI->BindFrameBuffer(FBO);
     }
 
@@ -189,20 +514,46 @@ class RenderingCommand
         s_RenderingAPI->DrawFrameBuffer(shaderID, quadVAO, FBOTexMap);
     };
 
-    inline static void InitFrameBuffer(int &width, int &height, unsigned &FBOTextureMap, unsigned &FBODepthTexture,
-                                       unsigned &FBO, unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO)
+    inline static void InitScreenQuad(unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO)
     {
-        s_RenderingAPI->InitFrameBuffer(width, height, FBOTextureMap, FBODepthTexture, FBO, ScreenQuadVAO,
-                                        ScreenQuadVBO);
-    };
+        s_RenderingAPI->InitScreenQuad(ScreenQuadVAO, ScreenQuadVBO);
+    }
 
-    inline static void RescaleFramebuffer(unsigned &texMap, int &width, int &height)
+    inline static void InitColorTarget(unsigned &texture, int width, int height)
     {
-        s_RenderingAPI->RescaleFramebuffer(texMap, width, height);
-    };
+        s_RenderingAPI->InitColorTarget(texture, width, height);
+    }
+
+    inline static void InitDepthTarget(unsigned &texture, int width, int height)
+    {
+        s_RenderingAPI->InitDepthTarget(texture, width, height);
+    }
+
+    inline static bool InitFrameBuffer(unsigned &FBO, unsigned colorTexture, unsigned depthTexture)
+    {
+        return s_RenderingAPI->InitFrameBuffer(FBO, colorTexture, depthTexture);
+    }
+
+    inline static void DeleteFrameBuffer(unsigned &FBO)
+    {
+        s_RenderingAPI->DeleteFrameBuffer(FBO);
+    }
+
+    inline static void InitDepthFrameBuffer(unsigned &FBO)
+    {
+        s_RenderingAPI->InitDepthFrameBuffer(FBO);
+    }
+
+    inline static void AttachDepthLayer(unsigned FBO, unsigned texture, int layer)
+    {
+        s_RenderingAPI->AttachDepthLayer(FBO, texture, layer);
+    }
 
   private:
     static std::unique_ptr<RenderingAPI> s_RenderingAPI;
+
+    static Stats s_Stats;
+    static Stats s_LastFrameStats;
 };
 
 } // namespace Rendering
@@ -0,0 +1,111 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RenderingCommand.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Persistently mapped buffer split into one segment per frame in flight. Each frame writes linearly into its own
+// segment and fences it at the end; the segment is only reused once that fence has signalled, so per-frame data
+// never reallocates driver storage or stalls on an implicit sync.
+//
+// A frame that outgrows its segment moves the ring to a buffer with larger segments on the spot. The old buffer is
+// kept alive until the GPU is done with it, and allocations remember which buffer they came from so anything already
+// handed out this frame stays valid.
+class RingBuffer
+{
+  public:
+    struct Allocation
+    {
+        void *data = nullptr;
+        unsigned buffer = 0;
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    RingBuffer(RenderingAPI::BufferTarget target, size_t segmentSize, unsigned framesInFlight = 3);
+    ~RingBuffer();
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    void BeginFrame();
+    void EndFrame();
+
+    Allocation Allocate(size_t size);
+
+    template <typename T> inline Allocation Push(const T &value)
+    {
+        Allocation allocation = Allocate(sizeof(T));
+        if (allocation.data)
+        {
+            std::memcpy(allocation.data, &value, sizeof(T));
+        }
+
+        return allocation;
+    }
+
+    // Failed allocations are never bound, the caller should skip whatever would have read them
+    inline bool Bind(const Allocation &allocation, unsigned bindingIndex) const
+    {
+        if (allocation.size == 0)
+        {
+            return false;
+        }
+
+        RenderingCommand::BindBufferRange(m_Target, bindingIndex, allocation.buffer, allocation.offset,
+                                          allocation.size);
+        return true;
+    }
+
+    inline unsigned GetBuffer() const
+    {
+        return m_Buffer;
+    }
+
+    inline size_t GetUsedBytes() const
+    {
+        return m_Head;
+    }
+
+    inline size_t GetSegmentSize() const
+    {
+        return m_SegmentSize;
+    }
+
+  private:
+    bool Grow(size_t minimumSegmentSize);
+
+  private:
+    // Buffers the ring has grown out of, deleted once the frames that used them are done
+    struct RetiredBuffer
+    {
+        unsigned buffer;
+        RenderingAPI::Fence fence;
+    };
+
+    RenderingAPI::BufferTarget m_Target;
+    unsigned m_Buffer = 0;
+    unsigned char *m_MappedData = nullptr;
+
+    size_t m_SegmentSize;
+    size_t m_Alignment;
+    unsigned m_FramesInFlight;
+    unsigned m_CurrentSegment = 0;
+    size_t m_Head = 0;
+    bool m_OverflowReported = false;
+
+    std::vector<RenderingAPI::Fence> m_Fences;
+    std::vector<RetiredBuffer> m_RetiredBuffers;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // RINGBUFFER_H
@@ -28,6 +28,7 @@ struct SceneObject
     std::string name;
     Rendering::Shader shader;
     size_t size;
+    unsigned materialIndex = 0;
 
     void Clear()
     {
@@ -57,6 +58,12 @@ struct Scene
 
     glm::vec4 background = {0.15f, 0.15f, 0.15f, 1.0f};
     bool isGridEnabled = true;
+    bool isDepthPrepassEnabled = false;
+    bool isOcclusionCullingEnabled = true;
+
+    // Renders the scene below the view's resolution when the GPU goes over budget, then upscales it
+    bool isDynamicResolutionEnabled = false;
+    float gpuFrameBudgetMs = 12.0f;
 
     Scene() = default;
     ~Scene() = default;
@@ -18,6 +18,7 @@ class Shader
     unsigned int ID;
 
     Shader(const char *vertexPath, const char *fragmentPath);
+    explicit Shader(const char *computePath);
     Shader() = default;
     void Use();
 
@@ -0,0 +1,154 @@
+#ifndef SHADOWMAPS_H
+#define SHADOWMAPS_H
+
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RingBuffer.h"
+#include "Rendering/Include/Scene.h"
+#include <array>
+#include <glm/glm.hpp>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Cascaded shadow maps for the directional light and cube shadows for the point lights nearest the camera, both
+// cached between frames. A cascade or cube face is only re-rendered when its light changes, a caster inside it
+// moves, appears or disappears, or the camera leaves the area the cascade was last centred on. Cascades are sized
+// with headroom around their slice of the view frustum and snapped to whole texels when they re-centre, so small
+// camera movements reuse the cached depth without any shimmering.
+class ShadowMaps
+{
+  public:
+    struct Stats
+    {
+        unsigned cascadesRendered = 0;
+        unsigned facesRendered = 0;
+        unsigned pointShadowCount = 0;
+    };
+
+    // Mirrors the std140 ShadowData block in the default shaders
+    struct ShadowData
+    {
+        glm::mat4 cascadeViewProjection[4];
+        glm::vec4 cascadeSplits;
+        glm::vec4 shadowParams; // x cascade count, y point shadow near plane, z cascade texel size
+    };
+
+    // Returns false if any caster could not be drawn, the layer then stays dirty and is redrawn next frame
+    using CasterPass = std::function<bool(const glm::mat4 &view, const glm::mat4 &projection)>;
+
+    static constexpr int s_CascadeCount = 3;
+    static constexpr int s_CascadeSize = 2048;
+    static constexpr int s_MaxPointShadows = 4;
+    static constexpr int s_PointShadowSize = 512;
+
+    static constexpr unsigned s_ShadowDataBinding = 2;
+    static constexpr RenderingAPI::Texture s_CascadeTextureUnit = RenderingAPI::Texture::Texture8;
+    static constexpr RenderingAPI::Texture s_PointShadowTextureUnit = RenderingAPI::Texture::Texture9;
+
+    ShadowMaps();
+    ~ShadowMaps();
+
+    ShadowMaps(const ShadowMaps &) = delete;
+    ShadowMaps &operator=(const ShadowMaps &) = delete;
+
+    // Works out what has to be redrawn this frame and assigns point shadow slots
+    void Update(const Scene &scene, const glm::mat4 &view, const glm::mat4 &projection, float nearClip,
+                float farClip);
+
+    // Calls pass once per stale cascade or cube face with its shadow FBO layer bound and cleared
+    void Render(const CasterPass &pass);
+    void Bind() const;
+    void EndFrame();
+
+    // Point shadow slot per scene light, -1 for lights without one
+    inline const std::vector<int> &GetPointShadowSlots() const
+    {
+        return m_PointShadowSlots;
+    }
+
+    inline const Stats &GetStats() const
+    {
+        return m_Stats;
+    }
+
+  private:
+    struct Bounds
+    {
+        glm::vec3 centre;
+        float radius;
+    };
+
+    struct CasterState
+    {
+        glm::vec3 position, rotation, scale;
+        Bounds bounds;
+    };
+
+    struct Cascade
+    {
+        glm::vec3 centre = glm::vec3(0.0f);
+        float extent = 0.0f;
+        glm::mat4 view, projection;
+        bool valid = false;
+        bool dirty = true;
+    };
+
+    struct PointShadow
+    {
+        std::string lightId;
+        glm::vec3 position = glm::vec3(0.0f);
+        float radius = 0.0f;
+        bool inUse = false;
+        std::array<bool, 6> dirtyFaces = {};
+    };
+
+    template <typename T> void TrackCaster(std::vector<CasterState> &states, size_t index, const T &caster,
+                                           float localRadius);
+    void UpdateCasters(const Scene &scene);
+    void UpdateCascades(const Scene &scene, const glm::mat4 &view, const glm::mat4 &projection, float nearClip);
+    void UpdatePointShadows(const Scene &scene, const glm::vec3 &cameraPosition, float farClip);
+
+    bool CascadeTouches(const Cascade &cascade, const Bounds &bounds) const;
+    static bool FaceTouches(const PointShadow &shadow, int face, const Bounds &bounds);
+    static glm::mat4 FaceView(const glm::vec3 &position, int face);
+
+  private:
+    static constexpr float s_ShadowDistance = 60.0f;
+    static constexpr float s_CascadeSplitLambda = 0.75f;
+    static constexpr float s_CascadeHeadroom = 0.25f;
+    static constexpr float s_CasterDistance = 50.0f;
+    static constexpr float s_PointShadowNear = 0.05f;
+
+    unsigned m_FrameBuffer = 0;
+    unsigned m_CascadeTexture = 0;
+    unsigned m_PointShadowTexture = 0;
+
+    std::unique_ptr<RingBuffer> m_Ring;
+    RingBuffer::Allocation m_ShadowDataAllocation;
+    ShadowData m_ShadowData;
+
+    // Directional light
+    std::array<Cascade, s_CascadeCount> m_Cascades;
+    bool m_HasDirectionalLight = false;
+    glm::vec3 m_LightDirection = glm::vec3(0.0f);
+
+    // Point lights
+    std::array<PointShadow, s_MaxPointShadows> m_PointShadows;
+    std::vector<int> m_PointShadowSlots;
+
+    // Last known transform of every caster, moved casters invalidate what they overlap before and after the move
+    std::vector<CasterState> m_ObjectCasters, m_ModelCasters;
+    std::vector<Bounds> m_ChangedBounds;
+    bool m_InvalidateAll = true;
+
+    Stats m_Stats;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // SHADOWMAPS_H
@@ -0,0 +1,211 @@
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include "Core/Events/Include/EventQueue.h"
+#include "Core/Include/Core.h"
+#include "Rendering/Include/RenderingCommand.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+// Textures are registered with only their smallest mips resident. Higher mips are decoded on a worker thread
+// when a draw asks for more screen-space resolution, uploaded on the main thread in Update(), and evicted
+// least-recently-used first whenever residency goes over the VRAM budget.
+//
+// Every texture lives as a layer of a same-sized RGBA8 texture array, so meshes with different materials can be
+// drawn together without rebinding. Shaders look a texture handle up in the texture table to find its array slot,
+// layer and the first resident mip to clamp sampling to.
+//
+// Once every array slot is taken, a texture of yet another size is resampled to the size of the closest existing
+// array rather than left unloaded.
+class TextureStreamer
+{
+  public:
+    struct Stats
+    {
+        size_t residentBytes = 0;
+        size_t peakResidentBytes = 0;
+        size_t budgetBytes = 0;
+        size_t uploadedBytesLastFrame = 0;
+
+        unsigned textureCount = 0;
+        unsigned arrayCount = 0;
+        unsigned fullyResidentCount = 0;
+        unsigned pendingRequests = 0;
+        unsigned evictedMips = 0;
+    };
+
+    // Mirrors TextureRef in the default mesh shader, std430
+    struct TextureRef
+    {
+        int slot = -1;
+        int layer = 0;
+        float minLod = 0.0f;
+        float padding = 0.0f;
+    };
+
+    static constexpr int s_MaxArraySlots = 8;
+    static constexpr unsigned s_TextureTableBinding = 3;
+
+    TextureStreamer();
+    ~TextureStreamer();
+
+    static void Init();
+
+    inline static std::shared_ptr<TextureStreamer> &GetTextureStreamerInstance()
+    {
+        MS_ASSERT(s_TextureStreamer, "texture streamer failed to initialise");
+        return s_TextureStreamer;
+    }
+
+    // Returns a handle into the texture table, not a GL texture object
+    unsigned RegisterTexture(const std::string &path);
+    void RequestResolution(unsigned handle, int pixels);
+
+    void Update();
+    void Bind();
+
+    inline void SetBudget(size_t budgetBytes)
+    {
+        m_BudgetBytes = budgetBytes;
+    }
+
+    inline size_t GetBudget() const
+    {
+        return m_BudgetBytes;
+    }
+
+    inline const Stats &GetStats() const
+    {
+        return m_Stats;
+    }
+
+  private:
+    struct MipLevel
+    {
+        int width, height;
+        std::vector<unsigned char> data;
+    };
+
+    struct TextureArray
+    {
+        unsigned id = 0;
+        int width = 0, height = 0;
+        int mipCount = 0;
+        int layerCount = 0, layerCapacity = 0;
+
+        // Levels [allocatedBase, mipCount) have storage for every layer
+        int allocatedBase = 0;
+    };
+
+    struct StreamedTexture
+    {
+        std::string path;
+        int array = -1;
+        int layer = -1;
+
+        // Size the layer is stored at, which differs from the source when it was fitted into another array
+        int width = 0, height = 0;
+        int mipCount = 0;
+        int tailLevel = 0;
+
+        // This layer's data is uploaded for [residentBase, mipCount), -1 until the first decode lands
+        int residentBase = -1;
+        int requestedPixels = 0;
+        // DesiredBaseLevel() for this frame's requests, cached before they are reset
+        int desiredBase = 0;
+        uint64_t lastUsedFrame = 0;
+        bool jobPending = false;
+        bool failed = false;
+    };
+
+    struct DecodeJob
+    {
+        unsigned handle;
+        std::string path;
+        int firstLevel;
+        int lastLevel;
+
+        // Resample the source to this size first, 0 keeps the source size
+        int width = 0, height = 0;
+    };
+
+    struct DecodeResult
+    {
+        unsigned handle;
+        bool success = false;
+        int width = 0, height = 0;
+        int firstLevel = 0;
+        std::vector<MipLevel> levels;
+    };
+
+    void WorkerLoop();
+    static DecodeResult Decode(const DecodeJob &job);
+    static MipLevel Resample(const MipLevel &source, int width, int height);
+
+    void UploadResult(DecodeResult &result);
+    void QueueStreamingRequests();
+    void EvictToBudget(size_t headroom = 0);
+
+    int AcquireLayer(StreamedTexture &texture);
+    int ClosestArray(int width, int height) const;
+    void GrowArray(TextureArray &array);
+    void SetArrayParameters();
+    void AllocateArrayLevels(TextureArray &array, int baseLevel);
+    void ReleaseUnusedArrayLevels(int arrayIndex);
+    bool CanEvictTopLevel(int arrayIndex, uint64_t &lastUsedFrame) const;
+    void EvictTopLevel(int arrayIndex);
+    void UpdateTextureRefs(int arrayIndex);
+    void UploadTextureTable();
+    void RefreshStats();
+
+    int DesiredBaseLevel(const StreamedTexture &texture) const;
+    size_t ArrayLevelBytes(const TextureArray &array, int level) const;
+    size_t BytesToAllocate(const StreamedTexture &texture, int baseLevel) const;
+
+    static int MipCount(int width, int height);
+
+  private:
+    static std::shared_ptr<TextureStreamer> s_TextureStreamer;
+
+    static constexpr int s_TailSize = 64;
+    static constexpr int s_MaxArrayLayers = 256;
+    static constexpr size_t s_MaxUploadBytesPerFrame = 16 * 1024 * 1024;
+
+    std::vector<StreamedTexture> m_Textures;
+    std::vector<TextureRef> m_TextureRefs;
+    std::unordered_map<std::string, unsigned> m_TexturesByPath;
+    std::vector<TextureArray> m_Arrays;
+
+    unsigned m_TextureTableBuffer = 0;
+    size_t m_TextureTableCapacity = 0;
+    bool m_TextureTableDirty = true;
+
+    size_t m_BudgetBytes = 512 * 1024 * 1024;
+    size_t m_ResidentBytes = 0;
+    uint64_t m_Frame = 0;
+    Stats m_Stats;
+
+    // Finished decodes are announced from the worker thread
+    std::shared_ptr<Core::EventQueue> m_EventQueue;
+
+    std::thread m_Worker;
+    std::mutex m_JobMutex;
+    std::condition_variable m_JobCondition;
+    std::deque<DecodeJob> m_Jobs;
+    std::deque<DecodeResult> m_Results;
+    bool m_StopWorker = false;
+};
+
+} // namespace Rendering
+
+} // namespace Moonstone
+
+#endif // TEXTURESTREAMER_H
@@ -0,0 +1,99 @@
+#include "Include/MaterialRegistry.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+std::shared_ptr<MaterialRegistry> MaterialRegistry::s_MaterialRegistry;
+
+void MaterialRegistry::Init()
+{
+    s_MaterialRegistry = std::make_shared<MaterialRegistry>();
+    MS_INFO("material registry initialised");
+}
+
+unsigned MaterialRegistry::RegisterMaterial(const MaterialEntry &entry)
+{
+    m_Materials.push_back(entry);
+    MarkDirty(m_Materials.size() - 1);
+
+    return static_cast<unsigned>(m_Materials.size() - 1);
+}
+
+unsigned MaterialRegistry::RegisterMaterial(const Material::Mat &material)
+{
+    MaterialEntry entry;
+    ApplyMaterial(entry, material);
+
+    return RegisterMaterial(entry);
+}
+
+void MaterialRegistry::UpdateMaterial(unsigned index, const Material::Mat &material)
+{
+    if (index >= m_Materials.size())
+    {
+        MS_WARN("tried to update unregistered material {0}", index);
+        return;
+    }
+
+    ApplyMaterial(m_Materials[index], material);
+    MarkDirty(index);
+}
+
+void MaterialRegistry::ApplyMaterial(MaterialEntry &entry, const Material::Mat &material)
+{
+    entry.diffuse = glm::vec4(material.diffuse, 1.0f);
+    entry.specular = glm::vec4(material.specular, material.shininess);
+    entry.baseColour = glm::vec4(material.baseColour, 1.0f);
+}
+
+void MaterialRegistry::MarkDirty(size_t index)
+{
+    m_DirtyBegin = std::min(m_DirtyBegin, index);
+    m_DirtyEnd = std::max(m_DirtyEnd, index + 1);
+}
+
+void MaterialRegistry::Upload()
+{
+    if (m_DirtyBegin >= m_DirtyEnd)
+    {
+        return;
+    }
+
+    if (m_Materials.size() > m_Capacity)
+    {
+        size_t capacity = std::max<size_t>(m_Capacity, 64);
+        while (capacity < m_Materials.size())
+        {
+            capacity *= 2;
+        }
+
+        RenderingCommand::DeleteBuffer(m_Buffer);
+        RenderingCommand::InitBuffer(m_Buffer, capacity * sizeof(MaterialEntry), nullptr, true);
+        m_Capacity = capacity;
+
+        // A fresh buffer has nothing in it yet
+        m_DirtyBegin = 0;
+        m_DirtyEnd = m_Materials.size();
+    }
+
+    RenderingCommand::UpdateBuffer(m_Buffer, m_DirtyBegin * sizeof(MaterialEntry),
+                                   (m_DirtyEnd - m_DirtyBegin) * sizeof(MaterialEntry), &m_Materials[m_DirtyBegin]);
+
+    m_DirtyBegin = SIZE_MAX;
+    m_DirtyEnd = 0;
+}
+
+void MaterialRegistry::Bind()
+{
+    if (m_Buffer != 0)
+    {
+        RenderingCommand::BindBufferBase(RenderingAPI::BufferTarget::ShaderStorage, s_MaterialTableBinding, m_Buffer);
+    }
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
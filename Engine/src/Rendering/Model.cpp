@@ -1,4 +1,6 @@
 #include "Include/Model.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
 #include "assimp/postprocess.h"
 
 namespace Moonstone
@@ -9,14 +11,20 @@ namespace Rendering
 
 void Model::Draw(Rendering::Shader &shader)
 {
-    for (auto &mesh : m_Meshes)
+    if (m_DrawCount == 0)
     {
-        mesh.Draw(shader);
+        return;
     }
+
+    // Every sub-mesh goes out in one call, materials are picked per draw from the material table
+    RenderingCommand::SubmitMultiDrawIndirect(m_VAO, m_IndirectBuffer, m_DrawCount, m_IndexCount);
 }
 
 void Model::LoadModel(std::string &path)
 {
+    MS_PROFILE_FUNCTION();
+    MS_MEMORY_TAG(Meshes);
+
     Assimp::Importer import;
     const aiScene *scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs |
                                                      aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace);
@@ -30,6 +38,74 @@ void Model::LoadModel(std::string &path)
     MS_DEBUG("imported model succesfully");
     m_Directory = path.substr(0, path.find_last_of('/'));
     ProcessNode(scene->mRootNode, scene);
+    SetupBuffers();
+}
+
+void Model::SetupBuffers()
+{
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<unsigned> indices;
+    std::vector<DrawCommand> drawCommands;
+    std::vector<int> drawMaterials;
+
+    for (auto &mesh : m_Meshes)
+    {
+        DrawCommand command;
+        command.count = static_cast<unsigned>(mesh.indices.size());
+        command.instanceCount = 1;
+        command.firstIndex = static_cast<unsigned>(indices.size());
+        command.baseVertex = static_cast<int>(vertices.size());
+        command.baseInstance = static_cast<unsigned>(drawCommands.size());
+
+        drawCommands.push_back(command);
+        drawMaterials.push_back(static_cast<int>(mesh.materialIndex));
+
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+    }
+
+    if (drawCommands.empty())
+    {
+        return;
+    }
+
+    RenderingCommand::InitVertexArray(m_VAO);
+    RenderingCommand::InitVertexBuffer(m_VBO, reinterpret_cast<float *>(vertices.data()),
+                                       vertices.size() * sizeof(Mesh::Vertex));
+    RenderingCommand::InitElementBuffer(m_EBO, indices.data(), indices.size() * sizeof(unsigned));
+
+    RenderingCommand::InitVertexAttributes(0, 3, RenderingAPI::NumericalDataType::Float,
+                                           RenderingAPI::BooleanDataType::False, sizeof(Mesh::Vertex), 0);
+    RenderingCommand::InitVertexAttributes(1, 3, RenderingAPI::NumericalDataType::Float,
+                                           RenderingAPI::BooleanDataType::False, sizeof(Mesh::Vertex),
+                                           offsetof(Mesh::Vertex, Normal));
+    RenderingCommand::InitVertexAttributes(2, 2, RenderingAPI::NumericalDataType::Float,
+                                           RenderingAPI::BooleanDataType::False, sizeof(Mesh::Vertex),
+                                           offsetof(Mesh::Vertex, TexCoords));
+    RenderingCommand::InitVertexAttributes(3, 3, RenderingAPI::NumericalDataType::Float,
+                                           RenderingAPI::BooleanDataType::False, sizeof(Mesh::Vertex),
+                                           offsetof(Mesh::Vertex, Tangent));
+    RenderingCommand::InitVertexAttributes(4, 3, RenderingAPI::NumericalDataType::Float,
+                                           RenderingAPI::BooleanDataType::False, sizeof(Mesh::Vertex),
+                                           offsetof(Mesh::Vertex, Bitangent));
+
+    // One material index per draw, fetched through baseInstance
+    RenderingCommand::InitBuffer(m_DrawMaterialBuffer, drawMaterials.size() * sizeof(int), drawMaterials.data(),
+                                 false);
+    RenderingCommand::BindBuffer(RenderingAPI::BufferTarget::Array, m_DrawMaterialBuffer);
+    RenderingCommand::InitIntegerVertexAttributes(s_MaterialIndexAttribute, 1, RenderingAPI::NumericalDataType::Int,
+                                                  sizeof(int), 0);
+    RenderingCommand::SetVertexAttributeDivisor(s_MaterialIndexAttribute, 1);
+
+    unsigned clearVAO = 0;
+    RenderingCommand::BindVertexArray(clearVAO);
+
+    RenderingCommand::InitBuffer(m_IndirectBuffer, drawCommands.size() * sizeof(DrawCommand), drawCommands.data(),
+                                 false);
+    m_DrawCount = static_cast<int>(drawCommands.size());
+    m_IndexCount = indices.size();
+
+    MS_DEBUG("model merged into {0} draws, {1} vertices", m_DrawCount, vertices.size());
 }
 
 void Model::ProcessNode(aiNode *node, const aiScene *scene)
@@ -69,6 +145,7 @@ Mesh Model::ProcessMesh(aiMesh *mesh, const aiScene *scene)
         vector.y = mesh->mVertices[i].y;
         vector.z = mesh->mVertices[i].z;
         vertex.Position = vector;
+        m_BoundingRadius = std::max(m_BoundingRadius, glm::length(vector));
         // Norm
         if (mesh->HasNormals())
         {
@@ -114,6 +191,7 @@ Mesh Model::ProcessMesh(aiMesh *mesh, const aiScene *scene)
         }
     }
 
+    unsigned materialIndex = 0;
     if (mesh->mMaterialIndex >= 0)
     {
         aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
@@ -131,9 +209,27 @@ Mesh Model::ProcessMesh(aiMesh *mesh, const aiScene *scene)
 
         std::vector<Mesh::Texture> heightMaps = LoadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
         textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
+
+        auto registered = m_MaterialsBySceneIndex.find(mesh->mMaterialIndex);
+        if (registered != m_MaterialsBySceneIndex.end())
+        {
+            materialIndex = registered->second;
+        }
+        else
+        {
+            MaterialRegistry::MaterialEntry entry;
+            MaterialRegistry::ApplyMaterial(entry, Material::Mat());
+            entry.diffuseTexture = diffuseMaps.empty() ? -1 : static_cast<int>(diffuseMaps[0].id);
+            entry.specularTexture = specularMaps.empty() ? -1 : static_cast<int>(specularMaps[0].id);
+            entry.normalTexture = normalMaps.empty() ? -1 : static_cast<int>(normalMaps[0].id);
+            entry.heightTexture = heightMaps.empty() ? -1 : static_cast<int>(heightMaps[0].id);
+
+            materialIndex = MaterialRegistry::GetMaterialRegistryInstance()->RegisterMaterial(entry);
+            m_MaterialsBySceneIndex[mesh->mMaterialIndex] = materialIndex;
+        }
     }
 
-    return Mesh(vertices, indices, textures);
+    return Mesh(vertices, indices, textures, materialIndex);
 }
 
 std::vector<Mesh::Texture> Model::LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName)
@@ -172,53 +268,17 @@ unsigned Model::TextureFromFile(const std::string &path, const std::string &dire
     std::string filename = path;
     filename = directory + '/' + filename;
 
-    unsigned textureID;
-    Rendering::RenderingCommand::CreateTexture(textureID);
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        RenderingAPI::TextureFormat format;
-        if (nrComponents == 1)
-        {
-            format = RenderingAPI::TextureFormat::Red;
-        }
-        else if (nrComponents == 3)
-        {
-            format = RenderingAPI::TextureFormat::RGB;
-        }
-        else if (nrComponents == 4)
-        {
-            format = RenderingAPI::TextureFormat::RGBA;
-        }
+    // Only the mip tail is resident at first, the streamer pulls in detail as the model gets closer
+    return TextureStreamer::GetTextureStreamerInstance()->RegisterTexture(filename);
+}
 
-        Rendering::RenderingCommand::UploadTexture(Rendering::RenderingAPI::TextureTarget::Texture2D, 0, format, width,
-                                                   height, format, RenderingAPI::NumericalDataType::UnsignedByte, data);
-
-        RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2D,
-                                               RenderingAPI::TextureParameterName::TextureWrapS,
-                                               RenderingAPI::TextureParameter::Repeat);
-        RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2D,
-                                               RenderingAPI::TextureParameterName::TextureWrapT,
-                                               RenderingAPI::TextureParameter::Repeat);
-        RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2D,
-                                               RenderingAPI::TextureParameterName::TextureFilteringMin,
-                                               RenderingAPI::TextureParameter::LinearMipmapLinear);
-        RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2D,
-                                               RenderingAPI::TextureParameterName::TextureFilteringMag,
-                                               RenderingAPI::TextureParameter::Linear);
-
-        stbi_image_free(data);
-        MS_DEBUG("Loaded texture: width={0}, height={1}, components={2}", width, height, nrComponents);
-    }
-    else
+void Model::RequestTextureResolution(int pixels)
+{
+    auto &streamer = TextureStreamer::GetTextureStreamerInstance();
+    for (auto &texture : m_TexturesLoaded)
     {
-        MS_ERROR("texture failed to load: {0}", path);
-        stbi_image_free(data);
+        streamer->RequestResolution(texture.id, pixels);
     }
-
-    return textureID;
 }
 
 } // namespace Rendering
@@ -0,0 +1,321 @@
+#include "Include/OcclusionCuller.h"
+#include "Core/Include/Profiler.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+OcclusionCuller::OcclusionCuller()
+{
+    std::string downsampleComp = std::string(RESOURCE_DIR) + "/Shaders/Culling/hizdownsample.comp";
+    m_DownsampleShader = Shader(downsampleComp.c_str());
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    ReleaseReadbacks();
+    RenderingCommand::DeleteTexture(m_PyramidTexture);
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4 &view, const glm::mat4 &projection, bool occlusionEnabled)
+{
+    MS_PROFILE_FUNCTION();
+
+    ++m_Frame;
+
+    m_View = view;
+    m_Projection = projection;
+    m_OcclusionEnabled = occlusionEnabled;
+    m_Stats = {};
+
+    CollectReadbacks();
+
+    m_Stats.depthAge = m_HasDepth ? static_cast<int>(m_Frame - m_DepthFrame) : -1;
+
+    // Gribb-Hartmann, each plane is the last row of the view projection plus or minus one of the others
+    glm::mat4 viewProjection = projection * view;
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            float sign = side == 0 ? 1.0f : -1.0f;
+            glm::vec4 plane;
+            for (int column = 0; column < 4; ++column)
+            {
+                plane[column] = viewProjection[column][3] + sign * viewProjection[column][i];
+            }
+
+            m_FrustumPlanes[i * 2 + side] = plane / glm::length(glm::vec3(plane));
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const glm::vec3 &centre, float radius)
+{
+    ++m_Stats.testedCount;
+
+    if (!IsInFrustum(centre, radius))
+    {
+        ++m_Stats.frustumCulledCount;
+        return false;
+    }
+
+    if (m_OcclusionEnabled && IsOccluded(centre, radius))
+    {
+        ++m_Stats.occlusionCulledCount;
+        return false;
+    }
+
+    return true;
+}
+
+void OcclusionCuller::BuildDepthPyramid(unsigned depthTexture, int viewWidth, int viewHeight)
+{
+    if (!m_OcclusionEnabled || viewWidth <= 0 || viewHeight <= 0)
+    {
+        return;
+    }
+
+    if (viewWidth != m_ViewWidth || viewHeight != m_ViewHeight)
+    {
+        ResizePyramid(viewWidth, viewHeight);
+    }
+
+    // The downsample covers source texels by ratio, so level 0 reads a depth buffer of any render scale the same way
+    m_DownsampleShader.Use();
+
+    for (size_t level = 0; level < m_PyramidSizes.size(); ++level)
+    {
+        unsigned source = level == 0 ? depthTexture : m_PyramidTexture;
+        int sourceLevel = level == 0 ? 0 : static_cast<int>(level) - 1;
+
+        RenderingCommand::BindTexture(RenderingAPI::Texture::Texture0, RenderingAPI::TextureTarget::Texture2D, source);
+        RenderingCommand::SetUniformInt(m_DownsampleShader.ID, "sourceLevel", sourceLevel);
+        RenderingCommand::BindImageTexture(0, m_PyramidTexture, static_cast<int>(level),
+                                           RenderingAPI::ImageAccess::WriteOnly);
+
+        glm::ivec2 size = m_PyramidSizes[level];
+        RenderingCommand::DispatchCompute((size.x + s_GroupSize - 1) / s_GroupSize,
+                                          (size.y + s_GroupSize - 1) / s_GroupSize, 1);
+
+        // The next level fetches what this one stored
+        RenderingCommand::InsertMemoryBarrier(RenderingAPI::MemoryBarrierType::TextureFetch);
+    }
+
+    // Skip the copy rather than stall when every readback slot is still in flight
+    Readback &readback = m_Readbacks[m_NextReadback];
+    if (readback.pending)
+    {
+        return;
+    }
+
+    RenderingCommand::InsertMemoryBarrier(RenderingAPI::MemoryBarrierType::All);
+
+    glm::ivec2 readbackSize = m_PyramidSizes.back();
+    RenderingCommand::ReadFloatTextureToBuffer(m_PyramidTexture, static_cast<int>(m_PyramidSizes.size()) - 1,
+                                               readback.buffer, readbackSize.x * readbackSize.y * sizeof(float));
+
+    readback.fence = RenderingCommand::InsertFence();
+    readback.view = m_View;
+    readback.projection = m_Projection;
+    readback.frame = m_Frame;
+    readback.pending = true;
+
+    m_NextReadback = (m_NextReadback + 1) % s_ReadbackCount;
+}
+
+bool OcclusionCuller::IsInFrustum(const glm::vec3 &centre, float radius) const
+{
+    for (const auto &plane : m_FrustumPlanes)
+    {
+        if (glm::dot(glm::vec3(plane), centre) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OcclusionCuller::IsOccluded(const glm::vec3 &centre, float radius) const
+{
+    if (!m_HasDepth || m_Frame - m_DepthFrame > s_MaxDepthAge)
+    {
+        return false;
+    }
+
+    glm::vec3 viewCentre = glm::vec3(m_DepthView * glm::vec4(centre, 1.0f));
+    float nearDepth = -viewCentre.z - radius;
+    float farDepth = -viewCentre.z + radius;
+
+    // Near plane of a standard OpenGL perspective projection
+    float nearClip = m_DepthProjection[3][2] / (m_DepthProjection[2][2] - 1.0f);
+    if (nearDepth <= nearClip)
+    {
+        return false;
+    }
+
+    // Screen bounds of the sphere's view space box, x/z is monotonic in z so the extremes sit at the near and far
+    // depths
+    glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+    for (float z : {nearDepth, farDepth})
+    {
+        for (float offset : {-radius, radius})
+        {
+            glm::vec2 ndc((viewCentre.x + offset) * m_DepthProjection[0][0] / z,
+                          (viewCentre.y + offset) * m_DepthProjection[1][1] / z);
+
+            ndcMin = glm::min(ndcMin, ndc);
+            ndcMax = glm::max(ndcMax, ndc);
+        }
+    }
+
+    // Parts outside the older view have no depth to test against
+    if (ndcMin.x < -1.0f || ndcMin.y < -1.0f || ndcMax.x > 1.0f || ndcMax.y > 1.0f)
+    {
+        return false;
+    }
+
+    glm::ivec2 baseSize = m_DepthSizes[0];
+    auto toTexel = [](float ndc, int size) {
+        return std::clamp(static_cast<int>((ndc * 0.5f + 0.5f) * size), 0, size - 1);
+    };
+
+    int minX = toTexel(ndcMin.x, baseSize.x), maxX = toTexel(ndcMax.x, baseSize.x);
+    int minY = toTexel(ndcMin.y, baseSize.y), maxY = toTexel(ndcMax.y, baseSize.y);
+
+    // Coarsest level where the bounds cover at most two texels on each axis
+    size_t level = 0;
+    while (level + 1 < m_DepthLevels.size() && ((maxX >> level) - (minX >> level) > 1 ||
+                                                (maxY >> level) - (minY >> level) > 1))
+    {
+        ++level;
+    }
+
+    const std::vector<float> &depth = m_DepthLevels[level];
+    int levelWidth = m_DepthSizes[level].x;
+
+    float farthest = 0.0f;
+    for (int y = minY >> level; y <= (maxY >> level); ++y)
+    {
+        for (int x = minX >> level; x <= (maxX >> level); ++x)
+        {
+            farthest = std::max(farthest, depth[y * levelWidth + x]);
+        }
+    }
+
+    // Window space depth of the sphere's nearest point in the older frame
+    float clipZ = m_DepthProjection[2][2] * -nearDepth + m_DepthProjection[3][2];
+    float nearestDepth = clipZ / nearDepth * 0.5f + 0.5f;
+
+    return nearestDepth > farthest;
+}
+
+void OcclusionCuller::CollectReadbacks()
+{
+    // Oldest first, so a newer finished copy always wins
+    bool collected = false;
+    for (unsigned i = 0; i < s_ReadbackCount; ++i)
+    {
+        Readback &readback = m_Readbacks[(m_NextReadback + i) % s_ReadbackCount];
+        if (!readback.pending || !RenderingCommand::IsFenceSignalled(readback.fence))
+        {
+            continue;
+        }
+
+        glm::ivec2 size = m_PyramidSizes.back();
+        m_DepthLevels.resize(1);
+        m_DepthLevels[0].resize(size.x * size.y);
+        RenderingCommand::ReadBuffer(readback.buffer, 0, m_DepthLevels[0].size() * sizeof(float),
+                                     m_DepthLevels[0].data());
+
+        m_DepthView = readback.view;
+        m_DepthProjection = readback.projection;
+        m_DepthFrame = readback.frame;
+        readback.pending = false;
+        collected = true;
+    }
+
+    if (collected)
+    {
+        BuildCPUPyramid();
+        m_HasDepth = true;
+    }
+}
+
+void OcclusionCuller::BuildCPUPyramid()
+{
+    m_DepthSizes.assign(1, m_PyramidSizes.back());
+
+    while (m_DepthSizes.back().x > 1 || m_DepthSizes.back().y > 1)
+    {
+        glm::ivec2 sourceSize = m_DepthSizes.back();
+        glm::ivec2 size((sourceSize.x + 1) / 2, (sourceSize.y + 1) / 2);
+
+        const std::vector<float> &source = m_DepthLevels.back();
+        std::vector<float> level(size.x * size.y);
+
+        // Texel (x, y) covers source texels 2x..2x+1, clamped for odd sizes, matching the x >> level lookup
+        for (int y = 0; y < size.y; ++y)
+        {
+            for (int x = 0; x < size.x; ++x)
+            {
+                int x0 = x * 2, x1 = std::min(x * 2 + 1, sourceSize.x - 1);
+                int y0 = y * 2, y1 = std::min(y * 2 + 1, sourceSize.y - 1);
+
+                level[y * size.x + x] =
+                    std::max(std::max(source[y0 * sourceSize.x + x0], source[y0 * sourceSize.x + x1]),
+                             std::max(source[y1 * sourceSize.x + x0], source[y1 * sourceSize.x + x1]));
+            }
+        }
+
+        m_DepthLevels.push_back(std::move(level));
+        m_DepthSizes.push_back(size);
+    }
+}
+
+void OcclusionCuller::ResizePyramid(int width, int height)
+{
+    ReleaseReadbacks();
+    RenderingCommand::DeleteTexture(m_PyramidTexture);
+
+    m_ViewWidth = width;
+    m_ViewHeight = height;
+    m_HasDepth = false;
+
+    // Halve until the level is small enough to read back every frame, rounding down like GL mip sizes do
+    m_PyramidSizes.clear();
+    glm::ivec2 size(std::max(width / 2, 1), std::max(height / 2, 1));
+    m_PyramidSizes.push_back(size);
+
+    while (size.x > s_MaxReadbackSize || size.y > s_MaxReadbackSize)
+    {
+        size = glm::ivec2(std::max(size.x / 2, 1), std::max(size.y / 2, 1));
+        m_PyramidSizes.push_back(size);
+    }
+
+    RenderingCommand::InitFloatTexture(m_PyramidTexture, m_PyramidSizes[0].x, m_PyramidSizes[0].y,
+                                       static_cast<int>(m_PyramidSizes.size()));
+
+    size_t readbackBytes = size.x * size.y * sizeof(float);
+    for (auto &readback : m_Readbacks)
+    {
+        RenderingCommand::InitBuffer(readback.buffer, readbackBytes, nullptr, true);
+    }
+}
+
+void OcclusionCuller::ReleaseReadbacks()
+{
+    for (auto &readback : m_Readbacks)
+    {
+        RenderingCommand::WaitFence(readback.fence);
+        RenderingCommand::DeleteBuffer(readback.buffer);
+        readback.pending = false;
+    }
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
@@ -1,6 +1,7 @@
 #ifndef OPENGLrenderingAPI_H
 #define OPENGLrenderingAPI_H
 
+#include "Core/Include/MemoryTracker.h"
 #include "Rendering/Include/RenderingAPI.h"
 #include "Tools/Include/BaseShapes.h"
 #include <glad/glad.h>
@@ -22,6 +23,10 @@ class OpenGLRenderingAPI : public RenderingAPI
     virtual void InitVertexShader(unsigned &vertexShader, const char *vertexShaderSrc) override;
     virtual void InitFragmentShader(unsigned &fragmentShader, const char *fragmentShaderSrc) override;
     virtual void InitShaderProgram(unsigned &shaderProgram, unsigned &vertexShader, unsigned &fragmentShader) override;
+    virtual void InitComputeShader(unsigned &computeShader, const char *computeShaderSrc) override;
+    virtual void InitComputeProgram(unsigned &shaderProgram, unsigned &computeShader) override;
+    virtual void DispatchCompute(unsigned groupsX, unsigned groupsY, unsigned groupsZ) override;
+    virtual void InsertMemoryBarrier(MemoryBarrierType barrier) override;
     virtual void InitVertexArray(unsigned &VAO) override;
     virtual void InitVertexBuffer(unsigned &VBO, float *vertices, size_t size) override;
     virtual void BindVertexBuffer(unsigned &VBO) override;
@@ -30,8 +35,36 @@ class OpenGLRenderingAPI : public RenderingAPI
     virtual void InitVertexAttributes(int index, int size, NumericalDataType type, BooleanDataType normalize,
                                       size_t stride, size_t offset) override;
 
+    virtual void InitIntegerVertexAttributes(int index, int size, NumericalDataType type, size_t stride,
+                                             size_t offset) override;
+    virtual void SetVertexAttributeDivisor(int index, unsigned divisor) override;
+
+    virtual void InitBuffer(unsigned &buffer, size_t size, const void *data, bool dynamic) override;
+    virtual void UpdateBuffer(unsigned buffer, size_t offset, size_t size, const void *data) override;
+    virtual void BindBuffer(BufferTarget target, unsigned buffer) override;
+    virtual void BindBufferBase(BufferTarget target, unsigned bindingIndex, unsigned buffer) override;
+    virtual void InitPersistentBuffer(unsigned &buffer, size_t size, void *&mappedData) override;
+    virtual void BindBufferRange(BufferTarget target, unsigned bindingIndex, unsigned buffer, size_t offset,
+                                 size_t size) override;
+    virtual size_t GetBufferOffsetAlignment(BufferTarget target) override;
+    virtual void DeleteBuffer(unsigned &buffer) override;
+    virtual void ReadBuffer(unsigned buffer, size_t offset, size_t size, void *data) override;
+
+    virtual Fence InsertFence() override;
+    virtual void WaitFence(Fence &fence) override;
+    virtual bool IsFenceSignalled(Fence &fence) override;
+
+    virtual void CreateQuery(unsigned &query) override;
+    virtual void DeleteQuery(unsigned &query) override;
+    virtual void QueryTimestamp(unsigned query) override;
+    virtual bool IsQueryResultAvailable(unsigned query) override;
+    virtual uint64_t GetQueryResult(unsigned query) override;
+
+    virtual std::string GetDeviceDescription() override;
+
     virtual void SubmitDrawCommands(unsigned shaderProgram, unsigned VAO, size_t size) override;
     virtual void SubmitDrawArrays(DrawMode drawMode, int index, int count) override;
+    virtual void SubmitMultiDrawIndirect(unsigned VAO, unsigned indirectBuffer, int drawCount) override;
 
     virtual void SetPolygonMode(PolygonDataType polygonMode) override;
     virtual void SetViewport(int width, int height) override;
@@ -41,8 +74,8 @@ class OpenGLRenderingAPI : public RenderingAPI
     virtual void UseProgram(unsigned &ID) override;
 
     virtual void SetUniformBool(const unsigned &ID, const std::string &name, bool value) override;
-    virtual void SetUniformInt(const unsigned &ID, const std::string &name, bool value) override;
-    virtual void SetUniformFloat(const unsigned &ID, const std::string &name, bool value) override;
+    virtual void SetUniformInt(const unsigned &ID, const std::string &name, int value) override;
+    virtual void SetUniformFloat(const unsigned &ID, const std::string &name, float value) override;
     virtual void SetUniformMat4(const unsigned &ID, const std::string &name, glm::mat4 value) override;
     virtual void SetUniformVec3(const unsigned &ID, const std::string &name, glm::vec3 value) override;
 
@@ -53,20 +86,57 @@ class OpenGLRenderingAPI : public RenderingAPI
     virtual void UploadTexture(TextureTarget target, int mipmapLevel, TextureFormat texFormat, int x, int y,
                                TextureFormat imageDataType, NumericalDataType dataType,
                                unsigned char *texData) override;
+    virtual void SetTextureMipRange(TextureTarget target, int baseLevel, int maxLevel) override;
+    virtual void DeleteTexture(unsigned &texture) override;
+
+    virtual void CreateTextureArray(unsigned &texture) override;
+    virtual void AllocateTextureArrayLevel(int mipmapLevel, int width, int height, int layers) override;
+    virtual void UploadTextureArrayLayer(int mipmapLevel, int layer, int width, int height, TextureFormat imageDataType,
+                                         NumericalDataType dataType, const unsigned char *texData) override;
+    virtual void CopyTextureArrayLayers(unsigned source, unsigned destination, int mipmapLevel, int width, int height,
+                                        int layers) override;
 
     virtual void BindTexture(Texture texture, TextureTarget target, unsigned textureObject) override;
 
+    virtual void InitFloatTexture(unsigned &texture, int width, int height, int mipmapLevels) override;
+    virtual void BindImageTexture(unsigned unit, unsigned texture, int mipmapLevel, ImageAccess access) override;
+    virtual void ReadFloatTextureToBuffer(unsigned texture, int mipmapLevel, unsigned buffer, size_t size) override;
+
+    virtual void InitShadowTexture(unsigned &texture, TextureTarget target, int size, int layers) override;
+
     virtual void EnableBlending() override;
     virtual void DisableBlending() override;
     virtual void EnableDepthMask() override;
     virtual void DisableDepthMask() override;
+    virtual void EnablePolygonOffset(float factor, float units) override;
+    virtual void DisablePolygonOffset() override;
+    virtual void SetDepthFunction(DepthFunction function) override;
+    virtual void EnableColorMask() override;
+    virtual void DisableColorMask() override;
 
     virtual void BindFrameBuffer(unsigned int &FBO) override;
     virtual void DrawFrameBuffer(unsigned &shaderID, unsigned &quadVAO, unsigned &FBOTexMap) override;
-    virtual void InitFrameBuffer(int &width, int &height, unsigned &FBOTextureMap, unsigned &FBODepthTexture,
-                                 unsigned &FBO, unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO) override;
+    virtual void InitScreenQuad(unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO) override;
+
+    virtual void InitColorTarget(unsigned &texture, int width, int height) override;
+    virtual void InitDepthTarget(unsigned &texture, int width, int height) override;
+    virtual bool InitFrameBuffer(unsigned &FBO, unsigned colorTexture, unsigned depthTexture) override;
+    virtual void DeleteFrameBuffer(unsigned &FBO) override;
 
-    virtual void RescaleFramebuffer(unsigned &texMap, int &width, int &height) override;
+    virtual void InitDepthFrameBuffer(unsigned &FBO) override;
+    virtual void AttachDepthLayer(unsigned FBO, unsigned texture, int layer) override;
+
+  private:
+    static constexpr int s_MaxMipLevels = 16;
+
+    // Resources reported to the memory tracker as they get storage and dropped when they are deleted
+    void TrackBuffer(unsigned buffer, size_t size);
+    void TrackTexture(unsigned texture, size_t size);
+    void ReleaseBuffer(unsigned buffer);
+    void ReleaseTexture(unsigned texture);
+
+    // Texture array levels are allocated and released one at a time, the texture's size is the sum of its levels
+    std::unordered_map<unsigned, std::array<size_t, s_MaxMipLevels>> m_TextureArrayLevelBytes;
 
   private:
     inline static GLuint ToOpenGLShaderType(NumericalDataType type)
@@ -115,7 +185,13 @@ class OpenGLRenderingAPI : public RenderingAPI
             return GL_TEXTURE_2D;
             break;
         case TextureTarget::Texture3D:
-            return GL_TEXTURE_1D;
+            return GL_TEXTURE_3D;
+            break;
+        case TextureTarget::Texture2DArray:
+            return GL_TEXTURE_2D_ARRAY;
+            break;
+        case TextureTarget::TextureCubeMapArray:
+            return GL_TEXTURE_CUBE_MAP_ARRAY;
             break;
         default:
             return 0;
@@ -123,6 +199,109 @@ class OpenGLRenderingAPI : public RenderingAPI
         }
     }
 
+    inline static GLenum ToOpenGLTextureBinding(TextureTarget target)
+    {
+        switch (target)
+        {
+        case TextureTarget::Texture1D:
+            return GL_TEXTURE_BINDING_1D;
+        case TextureTarget::Texture2D:
+            return GL_TEXTURE_BINDING_2D;
+        case TextureTarget::Texture3D:
+            return GL_TEXTURE_BINDING_3D;
+        case TextureTarget::Texture2DArray:
+            return GL_TEXTURE_BINDING_2D_ARRAY;
+        case TextureTarget::TextureCubeMapArray:
+            return GL_TEXTURE_BINDING_CUBE_MAP_ARRAY;
+        default:
+            return 0;
+        }
+    }
+
+    inline static size_t TextureFormatBytes(TextureFormat format)
+    {
+        switch (format)
+        {
+        case TextureFormat::Red:
+            return 1;
+        case TextureFormat::RGB:
+            return 3;
+        case TextureFormat::RGBA:
+            return 4;
+        default:
+            return 4;
+        }
+    }
+
+    inline static GLuint ToOpenGLBufferTarget(BufferTarget target)
+    {
+        switch (target)
+        {
+        case BufferTarget::Array:
+            return GL_ARRAY_BUFFER;
+        case BufferTarget::ElementArray:
+            return GL_ELEMENT_ARRAY_BUFFER;
+        case BufferTarget::Uniform:
+            return GL_UNIFORM_BUFFER;
+        case BufferTarget::ShaderStorage:
+            return GL_SHADER_STORAGE_BUFFER;
+        case BufferTarget::DrawIndirect:
+            return GL_DRAW_INDIRECT_BUFFER;
+        case BufferTarget::PixelPack:
+            return GL_PIXEL_PACK_BUFFER;
+        default:
+            return 0;
+        }
+    }
+
+    inline static GLuint ToOpenGLImageAccess(ImageAccess access)
+    {
+        switch (access)
+        {
+        case ImageAccess::ReadOnly:
+            return GL_READ_ONLY;
+        case ImageAccess::WriteOnly:
+            return GL_WRITE_ONLY;
+        case ImageAccess::ReadWrite:
+            return GL_READ_WRITE;
+        default:
+            return GL_READ_WRITE;
+        }
+    }
+
+    inline static GLbitfield ToOpenGLMemoryBarrier(MemoryBarrierType barrier)
+    {
+        switch (barrier)
+        {
+        case MemoryBarrierType::ShaderImageAccess:
+            return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        case MemoryBarrierType::TextureFetch:
+            return GL_TEXTURE_FETCH_BARRIER_BIT;
+        case MemoryBarrierType::PixelBuffer:
+            return GL_PIXEL_BUFFER_BARRIER_BIT;
+        case MemoryBarrierType::All:
+        default:
+            return GL_ALL_BARRIER_BITS;
+        }
+    }
+
+    inline static GLuint ToOpenGLDepthFunction(DepthFunction function)
+    {
+        switch (function)
+        {
+        case DepthFunction::Less:
+            return GL_LESS;
+        case DepthFunction::LessEqual:
+            return GL_LEQUAL;
+        case DepthFunction::Equal:
+            return GL_EQUAL;
+        case DepthFunction::Always:
+            return GL_ALWAYS;
+        default:
+            return GL_LESS;
+        }
+    }
+
     inline static GLuint ToOpenGLTextureParameterName(TextureParameterName paramName)
     {
         switch (paramName)
@@ -177,21 +356,7 @@ class OpenGLRenderingAPI : public RenderingAPI
 
     inline static GLuint ToOpenGLTexture(Texture texture)
     {
-        switch (texture)
-        {
-        case Texture::Texture0:
-            return GL_TEXTURE0;
-            break;
-        case Texture::Texture1:
-            return GL_TEXTURE1;
-            break;
-        case Texture::Texture2:
-            return GL_TEXTURE2;
-            break;
-        default:
-            return 0;
-            break;
-        }
+        return GL_TEXTURE0 + static_cast<GLuint>(texture);
     }
 
     inline static GLuint ToOpenGLDrawMode(DrawMode mode)
@@ -93,6 +93,54 @@ void OpenGLRenderingAPI::InitShaderProgram(unsigned &shaderProgram, unsigned &ve
     glDeleteShader(fragmentShader);
 }
 
+void OpenGLRenderingAPI::InitComputeShader(unsigned &computeShader, const char *computeShaderSrc)
+{
+    computeShader = glCreateShader(GL_COMPUTE_SHADER);
+
+    glShaderSource(computeShader, 1, &computeShaderSrc, NULL);
+    glCompileShader(computeShader);
+
+    int success;
+    char infoLog[512];
+    glGetShaderiv(computeShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(computeShader, 512, NULL, infoLog);
+        MS_ERROR("compute shader failed to compile: {0}", infoLog);
+        return;
+    }
+}
+
+void OpenGLRenderingAPI::InitComputeProgram(unsigned &shaderProgram, unsigned &computeShader)
+{
+    shaderProgram = glCreateProgram();
+
+    glAttachShader(shaderProgram, computeShader);
+    glLinkProgram(shaderProgram);
+
+    int success;
+    char infoLog[512];
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        MS_ERROR("compute program failed to link: {0}", infoLog);
+        return;
+    }
+
+    glDeleteShader(computeShader);
+}
+
+void OpenGLRenderingAPI::DispatchCompute(unsigned groupsX, unsigned groupsY, unsigned groupsZ)
+{
+    glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void OpenGLRenderingAPI::InsertMemoryBarrier(MemoryBarrierType barrier)
+{
+    glMemoryBarrier(ToOpenGLMemoryBarrier(barrier));
+}
+
 void OpenGLRenderingAPI::InitVertexArray(unsigned &VAO)
 {
     glGenVertexArrays(1, &VAO);
@@ -104,6 +152,8 @@ void OpenGLRenderingAPI::InitVertexBuffer(unsigned &VBO, float *vertices, size_t
     glGenBuffers(1, &VBO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+
+    TrackBuffer(VBO, size);
 };
 
 void OpenGLRenderingAPI::BindVertexBuffer(unsigned &VBO)
@@ -121,6 +171,8 @@ void OpenGLRenderingAPI::InitElementBuffer(unsigned &EBO, unsigned *indices, siz
     glGenBuffers(1, &EBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+
+    TrackBuffer(EBO, size);
 };
 
 void OpenGLRenderingAPI::SetPolygonMode(PolygonDataType polygonMode)
@@ -152,6 +204,200 @@ void OpenGLRenderingAPI::InitVertexAttributes(int index, int size, NumericalData
     glEnableVertexAttribArray(index);
 };
 
+void OpenGLRenderingAPI::InitIntegerVertexAttributes(int index, int size, NumericalDataType type, size_t stride,
+                                                     size_t offset)
+{
+    glVertexAttribIPointer(index, size, ToOpenGLShaderType(type), stride, (void *)offset);
+    glEnableVertexAttribArray(index);
+}
+
+void OpenGLRenderingAPI::SetVertexAttributeDivisor(int index, unsigned divisor)
+{
+    glVertexAttribDivisor(index, divisor);
+}
+
+void OpenGLRenderingAPI::InitBuffer(unsigned &buffer, size_t size, const void *data, bool dynamic)
+{
+    glCreateBuffers(1, &buffer);
+    glNamedBufferData(buffer, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+
+    TrackBuffer(buffer, size);
+}
+
+void OpenGLRenderingAPI::UpdateBuffer(unsigned buffer, size_t offset, size_t size, const void *data)
+{
+    glNamedBufferSubData(buffer, offset, size, data);
+}
+
+void OpenGLRenderingAPI::ReadBuffer(unsigned buffer, size_t offset, size_t size, void *data)
+{
+    glGetNamedBufferSubData(buffer, offset, size, data);
+}
+
+void OpenGLRenderingAPI::BindBuffer(BufferTarget target, unsigned buffer)
+{
+    glBindBuffer(ToOpenGLBufferTarget(target), buffer);
+}
+
+void OpenGLRenderingAPI::BindBufferBase(BufferTarget target, unsigned bindingIndex, unsigned buffer)
+{
+    glBindBufferBase(ToOpenGLBufferTarget(target), bindingIndex, buffer);
+}
+
+void OpenGLRenderingAPI::InitPersistentBuffer(unsigned &buffer, size_t size, void *&mappedData)
+{
+    // Immutable storage mapped once for the buffer's lifetime, coherent so writes need no explicit flush
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &buffer);
+    glNamedBufferStorage(buffer, size, nullptr, flags);
+    mappedData = glMapNamedBufferRange(buffer, 0, size, flags);
+    TrackBuffer(buffer, size);
+
+    if (!mappedData)
+    {
+        MS_ERROR("failed to persistently map buffer of {0} bytes", size);
+    }
+}
+
+void OpenGLRenderingAPI::BindBufferRange(BufferTarget target, unsigned bindingIndex, unsigned buffer, size_t offset,
+                                         size_t size)
+{
+    glBindBufferRange(ToOpenGLBufferTarget(target), bindingIndex, buffer, offset, size);
+}
+
+size_t OpenGLRenderingAPI::GetBufferOffsetAlignment(BufferTarget target)
+{
+    GLint alignment = 1;
+
+    if (target == BufferTarget::Uniform)
+    {
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+    else if (target == BufferTarget::ShaderStorage)
+    {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+
+    return static_cast<size_t>(alignment);
+}
+
+void OpenGLRenderingAPI::DeleteBuffer(unsigned &buffer)
+{
+    if (buffer != 0)
+    {
+        ReleaseBuffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+RenderingAPI::Fence OpenGLRenderingAPI::InsertFence()
+{
+    return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void OpenGLRenderingAPI::WaitFence(Fence &fence)
+{
+    if (!fence)
+    {
+        return;
+    }
+
+    GLsync sync = static_cast<GLsync>(fence);
+
+    // Flush on the first wait so the fence is guaranteed to eventually signal
+    GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true)
+    {
+        GLenum result = glClientWaitSync(sync, waitFlags, 1000000);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+
+        if (result == GL_WAIT_FAILED)
+        {
+            MS_ERROR("fence wait failed");
+            break;
+        }
+
+        waitFlags = 0;
+    }
+
+    glDeleteSync(sync);
+    fence = nullptr;
+}
+
+bool OpenGLRenderingAPI::IsFenceSignalled(Fence &fence)
+{
+    if (!fence)
+    {
+        return true;
+    }
+
+    GLsync sync = static_cast<GLsync>(fence);
+
+    // Zero timeout polls, the flush makes sure the fence is submitted rather than waiting on the next swap
+    GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        return false;
+    }
+
+    if (result == GL_WAIT_FAILED)
+    {
+        MS_ERROR("fence poll failed");
+    }
+
+    glDeleteSync(sync);
+    fence = nullptr;
+    return true;
+}
+
+void OpenGLRenderingAPI::CreateQuery(unsigned &query)
+{
+    glGenQueries(1, &query);
+}
+
+void OpenGLRenderingAPI::DeleteQuery(unsigned &query)
+{
+    if (query != 0)
+    {
+        glDeleteQueries(1, &query);
+        query = 0;
+    }
+}
+
+void OpenGLRenderingAPI::QueryTimestamp(unsigned query)
+{
+    glQueryCounter(query, GL_TIMESTAMP);
+}
+
+bool OpenGLRenderingAPI::IsQueryResultAvailable(unsigned query)
+{
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+}
+
+uint64_t OpenGLRenderingAPI::GetQueryResult(unsigned query)
+{
+    GLuint64 result = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+    return static_cast<uint64_t>(result);
+}
+
+std::string OpenGLRenderingAPI::GetDeviceDescription()
+{
+    std::stringstream ss;
+    ss << reinterpret_cast<const char *>(glGetString(GL_VENDOR)) << " / "
+       << reinterpret_cast<const char *>(glGetString(GL_RENDERER)) << " / "
+       << reinterpret_cast<const char *>(glGetString(GL_VERSION));
+
+    return ss.str();
+}
+
 void OpenGLRenderingAPI::SubmitDrawCommands(unsigned shaderProgram, unsigned VAO, size_t size)
 {
     glBindVertexArray(VAO);
@@ -160,6 +406,15 @@ void OpenGLRenderingAPI::SubmitDrawCommands(unsigned shaderProgram, unsigned VAO
     glActiveTexture(GL_TEXTURE0);
 }
 
+void OpenGLRenderingAPI::SubmitMultiDrawIndirect(unsigned VAO, unsigned indirectBuffer, int drawCount)
+{
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, drawCount, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
 void OpenGLRenderingAPI::SubmitDrawArrays(DrawMode drawMode, int index, int count)
 {
     glDrawArrays(ToOpenGLDrawMode(drawMode), index, count);
@@ -167,6 +422,8 @@ void OpenGLRenderingAPI::SubmitDrawArrays(DrawMode drawMode, int index, int coun
 
 void OpenGLRenderingAPI::Cleanup(unsigned &VAO, unsigned &VBO, unsigned &shaderProgram)
 {
+    ReleaseBuffer(VBO);
+
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
 }
@@ -181,12 +438,12 @@ void OpenGLRenderingAPI::SetUniformBool(const unsigned &ID, const std::string &n
     glUniform1i(glad_glGetUniformLocation(ID, name.c_str()), (int)value);
 };
 
-void OpenGLRenderingAPI::SetUniformInt(const unsigned &ID, const std::string &name, bool value)
+void OpenGLRenderingAPI::SetUniformInt(const unsigned &ID, const std::string &name, int value)
 {
     glUniform1i(glad_glGetUniformLocation(ID, name.c_str()), value);
 }
 
-void OpenGLRenderingAPI::SetUniformFloat(const unsigned &ID, const std::string &name, bool value)
+void OpenGLRenderingAPI::SetUniformFloat(const unsigned &ID, const std::string &name, float value)
 {
     glUniform1f(glad_glGetUniformLocation(ID, name.c_str()), value);
 }
@@ -222,6 +479,74 @@ void OpenGLRenderingAPI::UploadTexture(TextureTarget target, int mipmapLevel, Te
                  ToOpenGLTextureFormat(imageDataType), ToOpenGLShaderType(dataType), texData);
 
     glGenerateMipmap(ToOpenGLTextureTarget(target));
+
+    // Level 0 plus the generated chain, which adds roughly a third
+    GLint texture = 0;
+    glGetIntegerv(ToOpenGLTextureBinding(target), &texture);
+
+    size_t levelBytes = static_cast<size_t>(x) * y * TextureFormatBytes(texFormat);
+    TrackTexture(static_cast<unsigned>(texture), levelBytes + levelBytes / 3);
+}
+
+void OpenGLRenderingAPI::SetTextureMipRange(TextureTarget target, int baseLevel, int maxLevel)
+{
+    glTexParameteri(ToOpenGLTextureTarget(target), GL_TEXTURE_BASE_LEVEL, baseLevel);
+    glTexParameteri(ToOpenGLTextureTarget(target), GL_TEXTURE_MAX_LEVEL, maxLevel);
+}
+
+void OpenGLRenderingAPI::DeleteTexture(unsigned &texture)
+{
+    if (texture != 0)
+    {
+        ReleaseTexture(texture);
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
+
+void OpenGLRenderingAPI::CreateTextureArray(unsigned &texture)
+{
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+}
+
+void OpenGLRenderingAPI::AllocateTextureArrayLevel(int mipmapLevel, int width, int height, int layers)
+{
+    // Zero sized levels release their storage, so arrays stay mutable instead of using glTexStorage3D
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, mipmapLevel, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 nullptr);
+
+    GLint texture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &texture);
+
+    if (texture == 0 || mipmapLevel < 0 || mipmapLevel >= s_MaxMipLevels)
+        return;
+
+    auto &levels = m_TextureArrayLevelBytes[static_cast<unsigned>(texture)];
+    levels[mipmapLevel] = static_cast<size_t>(width) * height * layers * 4;
+
+    size_t bytes = 0;
+    for (size_t levelBytes : levels)
+    {
+        bytes += levelBytes;
+    }
+
+    TrackTexture(static_cast<unsigned>(texture), bytes);
+}
+
+void OpenGLRenderingAPI::UploadTextureArrayLayer(int mipmapLevel, int layer, int width, int height,
+                                                 TextureFormat imageDataType, NumericalDataType dataType,
+                                                 const unsigned char *texData)
+{
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mipmapLevel, 0, 0, layer, width, height, 1,
+                    ToOpenGLTextureFormat(imageDataType), ToOpenGLShaderType(dataType), texData);
+}
+
+void OpenGLRenderingAPI::CopyTextureArrayLayers(unsigned source, unsigned destination, int mipmapLevel, int width,
+                                                int height, int layers)
+{
+    glCopyImageSubData(source, GL_TEXTURE_2D_ARRAY, mipmapLevel, 0, 0, 0, destination, GL_TEXTURE_2D_ARRAY,
+                       mipmapLevel, 0, 0, 0, width, height, layers);
 }
 
 void OpenGLRenderingAPI::BindTexture(Texture texture, TextureTarget target, unsigned textureObject)
@@ -230,6 +555,56 @@ void OpenGLRenderingAPI::BindTexture(Texture texture, TextureTarget target, unsi
     glBindTexture(ToOpenGLTextureTarget(target), textureObject);
 }
 
+void OpenGLRenderingAPI::InitFloatTexture(unsigned &texture, int width, int height, int mipmapLevels)
+{
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, mipmapLevels, GL_R32F, width, height);
+
+    size_t bytes = 0;
+    for (int level = 0; level < mipmapLevels; ++level)
+    {
+        bytes += static_cast<size_t>(std::max(1, width >> level)) * std::max(1, height >> level) * sizeof(float);
+    }
+    TrackTexture(texture, bytes);
+
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void OpenGLRenderingAPI::BindImageTexture(unsigned unit, unsigned texture, int mipmapLevel, ImageAccess access)
+{
+    glBindImageTexture(unit, texture, mipmapLevel, GL_FALSE, 0, ToOpenGLImageAccess(access), GL_R32F);
+}
+
+void OpenGLRenderingAPI::ReadFloatTextureToBuffer(unsigned texture, int mipmapLevel, unsigned buffer, size_t size)
+{
+    // With a pack buffer bound the read is queued on the GPU and the pointer is an offset into the buffer
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glGetTextureImage(texture, mipmapLevel, GL_RED, GL_FLOAT, size, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void OpenGLRenderingAPI::InitShadowTexture(unsigned &texture, TextureTarget target, int size, int layers)
+{
+    glCreateTextures(ToOpenGLTextureTarget(target), 1, &texture);
+    glTextureStorage3D(texture, 1, GL_DEPTH_COMPONENT32F, size, size, layers);
+    TrackTexture(texture, static_cast<size_t>(size) * size * layers * sizeof(float));
+
+    // Linear filtering on a comparison sampler gives a free 2x2 PCF tap
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTextureParameteri(texture, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+    // Anything sampled outside a cascade reads as fully lit
+    float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTextureParameterfv(texture, GL_TEXTURE_BORDER_COLOR, border);
+}
+
 void OpenGLRenderingAPI::EnableBlending()
 {
     glEnable(GL_BLEND);
@@ -251,6 +626,32 @@ void OpenGLRenderingAPI::DisableDepthMask()
     glDepthMask(GL_FALSE);
 }
 
+void OpenGLRenderingAPI::EnablePolygonOffset(float factor, float units)
+{
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(factor, units);
+}
+
+void OpenGLRenderingAPI::DisablePolygonOffset()
+{
+    glDisable(GL_POLYGON_OFFSET_FILL);
+}
+
+void OpenGLRenderingAPI::SetDepthFunction(DepthFunction function)
+{
+    glDepthFunc(ToOpenGLDepthFunction(function));
+}
+
+void OpenGLRenderingAPI::EnableColorMask()
+{
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void OpenGLRenderingAPI::DisableColorMask()
+{
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+}
+
 void OpenGLRenderingAPI::BindFrameBuffer(unsigned int &FBO)
 {
     glBindFramebuffer(GL_FRAMEBUFFER, FBO);
@@ -270,65 +671,112 @@ void OpenGLRenderingAPI::DrawFrameBuffer(unsigned &shaderID, unsigned &quadVAO,
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
-void OpenGLRenderingAPI::InitFrameBuffer(int &width, int &height, unsigned &FBOTextureMap, unsigned &FBODepthTexture,
-                                         unsigned &FBO, unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO)
+void OpenGLRenderingAPI::InitDepthFrameBuffer(unsigned &FBO)
 {
-    glViewport(0, 0, width, height);
-
-    glGenTextures(1, &FBOTextureMap);
-    glBindTexture(GL_TEXTURE_2D, FBOTextureMap);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glGenTextures(1, &FBODepthTexture);
-    glBindTexture(GL_TEXTURE_2D, FBODepthTexture);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_BYTE, NULL);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glGenFramebuffers(1, &FBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)FBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FBOTextureMap, 0);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, FBODepthTexture, 0);
-
-    // End
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE)
-        MS_DEBUG("framebuffer initialised successfully");
-    else
-        MS_ERROR("framebuffer did not initialise successfully");
+    glCreateFramebuffers(1, &FBO);
+    glNamedFramebufferDrawBuffer(FBO, GL_NONE);
+    glNamedFramebufferReadBuffer(FBO, GL_NONE);
+}
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+void OpenGLRenderingAPI::AttachDepthLayer(unsigned FBO, unsigned texture, int layer)
+{
+    glNamedFramebufferTextureLayer(FBO, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+}
 
+void OpenGLRenderingAPI::InitScreenQuad(unsigned &ScreenQuadVAO, unsigned &ScreenQuadVBO)
+{
     glGenVertexArrays(1, &ScreenQuadVAO);
     glGenBuffers(1, &ScreenQuadVBO);
     glBindVertexArray(ScreenQuadVAO);
     glBindBuffer(GL_ARRAY_BUFFER, ScreenQuadVBO);
     glBufferData(GL_ARRAY_BUFFER, Tools::BaseShapes::screenQuadVerticesSize, &Tools::BaseShapes::screenQuadVertices,
                  GL_STATIC_DRAW);
+    TrackBuffer(ScreenQuadVBO, Tools::BaseShapes::screenQuadVerticesSize);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
+    glBindVertexArray(0);
+}
+
+void OpenGLRenderingAPI::InitColorTarget(unsigned &texture, int width, int height)
+{
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_RGBA8, width, height);
+    TrackTexture(texture, static_cast<size_t>(width) * height * 4);
+
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void OpenGLRenderingAPI::InitDepthTarget(unsigned &texture, int width, int height)
+{
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_DEPTH_COMPONENT24, width, height);
+
+    // 24-bit depth is padded out to 32 bits per texel on every driver worth counting
+    TrackTexture(texture, static_cast<size_t>(width) * height * 4);
+
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+bool OpenGLRenderingAPI::InitFrameBuffer(unsigned &FBO, unsigned colorTexture, unsigned depthTexture)
+{
+    glCreateFramebuffers(1, &FBO);
+
+    if (colorTexture != 0)
+    {
+        glNamedFramebufferTexture(FBO, GL_COLOR_ATTACHMENT0, colorTexture, 0);
+    }
+    else
+    {
+        glNamedFramebufferDrawBuffer(FBO, GL_NONE);
+        glNamedFramebufferReadBuffer(FBO, GL_NONE);
+    }
+
+    if (depthTexture != 0)
+        glNamedFramebufferTexture(FBO, GL_DEPTH_ATTACHMENT, depthTexture, 0);
+
+    return glCheckNamedFramebufferStatus(FBO, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void OpenGLRenderingAPI::DeleteFrameBuffer(unsigned &FBO)
+{
+    if (FBO != 0)
+    {
+        glDeleteFramebuffers(1, &FBO);
+        FBO = 0;
+    }
+}
+
+void OpenGLRenderingAPI::TrackBuffer(unsigned buffer, size_t size)
+{
+    Core::MemoryTracker::GetMemoryTrackerInstance()->TrackGPUResource(Core::MemoryTracker::GPUResourceType::Buffer,
+                                                                      buffer, size);
+}
+
+void OpenGLRenderingAPI::TrackTexture(unsigned texture, size_t size)
+{
+    Core::MemoryTracker::GetMemoryTrackerInstance()->TrackGPUResource(Core::MemoryTracker::GPUResourceType::Texture,
+                                                                      texture, size);
+}
+
+void OpenGLRenderingAPI::ReleaseBuffer(unsigned buffer)
+{
+    Core::MemoryTracker::GetMemoryTrackerInstance()->ReleaseGPUResource(Core::MemoryTracker::GPUResourceType::Buffer,
+                                                                        buffer);
 }
 
-void OpenGLRenderingAPI::RescaleFramebuffer(unsigned &texMap, int &width, int &height)
+void OpenGLRenderingAPI::ReleaseTexture(unsigned texture)
 {
-    glBindTexture(GL_TEXTURE_2D, texMap);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texMap, 0);
+    Core::MemoryTracker::GetMemoryTrackerInstance()->ReleaseGPUResource(Core::MemoryTracker::GPUResourceType::Texture,
+                                                                        texture);
+    m_TextureArrayLevelBytes.erase(texture);
 }
 
 } // namespace Rendering
@@ -0,0 +1,211 @@
+#include "Include/RenderTargetManager.h"
+#include "Core/Include/MemoryTracker.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+std::shared_ptr<RenderTargetManager> RenderTargetManager::s_RenderTargetManager;
+
+void RenderTargetManager::Init()
+{
+    s_RenderTargetManager = std::make_shared<RenderTargetManager>();
+    MS_INFO("render target manager initialised");
+}
+
+void RenderTargetManager::Shutdown()
+{
+    if (!s_RenderTargetManager)
+    {
+        return;
+    }
+
+    for (auto &entry : s_RenderTargetManager->m_Targets)
+    {
+        s_RenderTargetManager->Release(entry.target);
+    }
+
+    s_RenderTargetManager.reset();
+}
+
+RenderTargetManager::Handle RenderTargetManager::CreateTarget(const RenderTargetDesc &desc)
+{
+    TargetEntry entry;
+    entry.target.desc = desc;
+    entry.target.desc.width = std::max(desc.width, 1);
+    entry.target.desc.height = std::max(desc.height, 1);
+    entry.requestedWidth = entry.target.desc.width;
+    entry.requestedHeight = entry.target.desc.height;
+
+    Allocate(entry.target);
+
+    return AddEntry(entry);
+}
+
+void RenderTargetManager::Resize(Handle handle, int width, int height)
+{
+    if (handle >= m_Targets.size() || m_Targets[handle].transient)
+    {
+        MS_WARN("tried to resize unknown render target {0}", handle);
+        return;
+    }
+
+    // Collapsed or minimised views report an empty region, keep the last real size instead of reallocating
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    m_Targets[handle].requestedWidth = width;
+    m_Targets[handle].requestedHeight = height;
+}
+
+RenderTargetManager::Handle RenderTargetManager::AcquireTransient(const RenderTargetDesc &desc)
+{
+    for (Handle handle = 0; handle < m_Targets.size(); ++handle)
+    {
+        auto &entry = m_Targets[handle];
+
+        if (entry.transient && !entry.inUse && entry.target.FBO != 0 && entry.target.desc == desc)
+        {
+            entry.inUse = true;
+            entry.lastUsedFrame = m_Frame;
+            return handle;
+        }
+    }
+
+    TargetEntry entry;
+    entry.target.desc = desc;
+    entry.transient = true;
+    entry.inUse = true;
+    entry.lastUsedFrame = m_Frame;
+
+    Allocate(entry.target);
+
+    return AddEntry(entry);
+}
+
+void RenderTargetManager::ReleaseTransient(Handle handle)
+{
+    if (handle >= m_Targets.size() || !m_Targets[handle].transient)
+    {
+        MS_WARN("tried to release unknown transient render target {0}", handle);
+        return;
+    }
+
+    m_Targets[handle].inUse = false;
+    m_Targets[handle].lastUsedFrame = m_Frame;
+}
+
+void RenderTargetManager::BeginFrame()
+{
+    ++m_Frame;
+
+    m_Stats.allocationsLastFrame = m_FrameAllocations;
+    m_FrameAllocations = 0;
+
+    m_Stats.allocatedBytes = 0;
+    m_Stats.persistentCount = 0;
+    m_Stats.transientCount = 0;
+    m_Stats.transientInUse = 0;
+
+    for (Handle handle = 0; handle < m_Targets.size(); ++handle)
+    {
+        auto &entry = m_Targets[handle];
+        auto &desc = entry.target.desc;
+
+        if (entry.target.FBO == 0)
+        {
+            continue;
+        }
+
+        if (!entry.transient && (entry.requestedWidth != desc.width || entry.requestedHeight != desc.height))
+        {
+            Release(entry.target);
+
+            desc.width = entry.requestedWidth;
+            desc.height = entry.requestedHeight;
+            Allocate(entry.target);
+
+            MS_DEBUG("render target {0} resized to {1}x{2}", handle, desc.width, desc.height);
+        }
+
+        if (entry.transient && !entry.inUse && m_Frame - entry.lastUsedFrame > s_TransientLifetimeFrames)
+        {
+            Release(entry.target);
+            m_FreeHandles.push_back(handle);
+            continue;
+        }
+
+        m_Stats.allocatedBytes += TargetBytes(desc);
+
+        if (entry.transient)
+        {
+            ++m_Stats.transientCount;
+            m_Stats.transientInUse += entry.inUse ? 1 : 0;
+        }
+        else
+        {
+            ++m_Stats.persistentCount;
+        }
+    }
+}
+
+RenderTargetManager::Handle RenderTargetManager::AddEntry(const TargetEntry &entry)
+{
+    if (!m_FreeHandles.empty())
+    {
+        Handle handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+
+        m_Targets[handle] = entry;
+        return handle;
+    }
+
+    m_Targets.push_back(entry);
+    return static_cast<Handle>(m_Targets.size() - 1);
+}
+
+void RenderTargetManager::Allocate(RenderTarget &target)
+{
+    MS_MEMORY_TAG(RenderTargets);
+    auto &desc = target.desc;
+
+    if (desc.hasColor)
+    {
+        RenderingCommand::InitColorTarget(target.colorTexture, desc.width, desc.height);
+    }
+
+    if (desc.hasDepth)
+    {
+        RenderingCommand::InitDepthTarget(target.depthTexture, desc.width, desc.height);
+    }
+
+    if (!RenderingCommand::InitFrameBuffer(target.FBO, target.colorTexture, target.depthTexture))
+    {
+        MS_ERROR("render target {0}x{1} is incomplete", desc.width, desc.height);
+    }
+
+    ++m_FrameAllocations;
+    ++m_Stats.totalAllocations;
+}
+
+void RenderTargetManager::Release(RenderTarget &target)
+{
+    RenderingCommand::DeleteFrameBuffer(target.FBO);
+    RenderingCommand::DeleteTexture(target.colorTexture);
+    RenderingCommand::DeleteTexture(target.depthTexture);
+}
+
+size_t RenderTargetManager::TargetBytes(const RenderTargetDesc &desc)
+{
+    // RGBA8 colour and 24-bit depth padded to four bytes
+    size_t pixels = static_cast<size_t>(desc.width) * desc.height;
+    return pixels * ((desc.hasColor ? 4 : 0) + (desc.hasDepth ? 4 : 0));
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
@@ -1,9 +1,14 @@
 #include "Include/Renderer.h"
+#include "Core/Include/Profiler.h"
 #include "Include/BaseShapes.h"
 #include "Include/Logger.h"
+#include "Rendering/Include/GPUProfiler.h"
 #include "Rendering/Include/Lighting.h"
+#include "Rendering/Include/MaterialRegistry.h"
+#include "Rendering/Include/RenderTargetManager.h"
 #include "Rendering/Include/RenderingCommand.h"
 #include "Rendering/Include/Scene.h"
+#include "Rendering/Include/TextureStreamer.h"
 #include "ext/matrix_transform.hpp"
 #include "trigonometric.hpp"
 #include <memory>
@@ -34,34 +39,103 @@ void Renderer::InitializeScene()
     RenderingCommand::InitVertexBuffer(m_VBO, Tools::BaseShapes::gridVertices, Tools::BaseShapes::gridVerticesSize);
     RenderingCommand::InitVertexAttributes(0, 3, RenderingAPI::NumericalDataType::Float,
                                            RenderingAPI::BooleanDataType::False, 3 * sizeof(float), 0);
+
+    m_UniformRing = std::make_unique<RingBuffer>(RenderingAPI::BufferTarget::Uniform, s_UniformRingSegmentSize);
+    m_ClusteredLighting = std::make_unique<ClusteredLighting>();
+
+    std::string depthVert = std::string(RESOURCE_DIR) + "/Shaders/DefaultShapes/defaultdepth.vert";
+    std::string depthFrag = std::string(RESOURCE_DIR) + "/Shaders/DefaultShapes/defaultdepth.frag";
+    m_DepthShader = Shader(depthVert.c_str(), depthFrag.c_str());
+
+    m_OcclusionCuller = std::make_unique<OcclusionCuller>();
+    m_ShadowMaps = std::make_unique<ShadowMaps>();
+
+    std::string upscaleVert = std::string(RESOURCE_DIR) + "/Shaders/PostProcess/upscale.vert";
+    std::string upscaleFrag = std::string(RESOURCE_DIR) + "/Shaders/PostProcess/upscale.frag";
+    m_UpscaleShader = Shader(upscaleVert.c_str(), upscaleFrag.c_str());
+
+    m_DynamicResolution = std::make_unique<DynamicResolution>();
 }
 
 void Renderer::InitializeFramebuffer()
 {
-    int width, height;
-    glfwGetWindowSize(m_Window->m_Window, &width, &height);
-    RenderingCommand::InitFrameBuffer(width, height, m_FBOTextureMap, m_FBODepthTexture, m_FBO, m_ScreenQuadVAO,
-                                      m_ScreenQuadVBO);
+    RenderTargetManager::RenderTargetDesc desc;
+    glfwGetWindowSize(m_Window->m_Window, &desc.width, &desc.height);
+    m_SceneTarget = RenderTargetManager::GetRenderTargetManagerInstance()->CreateTarget(desc);
+
+    RenderingCommand::InitScreenQuad(m_ScreenQuadVAO, m_ScreenQuadVBO);
 
     std::string framebVert = std::string(RESOURCE_DIR) + "/Shaders/DefaultShapes/defaultfbo.vert";
     std::string framebFrag = std::string(RESOURCE_DIR) + "/Shaders/DefaultShapes/defaultfbo.frag";
     Rendering::Shader framebShader(framebVert.c_str(), framebFrag.c_str());
     m_FBShaderID = framebShader.ID;
 
-    m_SceneRenderTarget->SetFramebufferParams(m_FBOTextureMap, m_FBShaderID, m_ScreenQuadVAO);
+    // Headless runs have no editor to show the target in
+    if (m_SceneRenderTarget)
+        m_SceneRenderTarget->SetFramebufferParams(m_SceneTarget, m_FBShaderID, m_ScreenQuadVAO);
 }
 
 void Renderer::RenderScene()
 {
-    RenderingCommand::BindFrameBuffer(m_FBO);
+    MS_PROFILE_FUNCTION();
+
+    // Land finished mip uploads and queue new ones from last frame's requests before anything samples them
+    TextureStreamer::GetTextureStreamerInstance()->Update();
+    MaterialRegistry::GetMaterialRegistryInstance()->Upload();
+    MaterialRegistry::GetMaterialRegistryInstance()->Bind();
+
+    m_UniformRing->BeginFrame();
+
+    // Applies last frame's scene view size, only reallocating when it actually changed
+    auto &renderTargets = RenderTargetManager::GetRenderTargetManagerInstance();
+    renderTargets->BeginFrame();
+
+    GPUProfiler::GetGPUProfilerInstance()->BeginPass(s_ScenePassName);
+
+    // Below full scale the scene is drawn into a pooled smaller target and upscaled into the view at the end
+    RenderTargetManager::RenderTarget sceneTarget = renderTargets->GetTarget(m_SceneTarget);
+    RenderTargetManager::Handle renderHandle = m_SceneTarget;
+
+    if (m_Scene->isDynamicResolutionEnabled)
+    {
+        glm::ivec2 size = m_DynamicResolution->GetScaledSize(sceneTarget.desc.width, sceneTarget.desc.height);
+
+        if (size.x != sceneTarget.desc.width || size.y != sceneTarget.desc.height)
+        {
+            RenderTargetManager::RenderTargetDesc desc;
+            desc.width = size.x;
+            desc.height = size.y;
+            renderHandle = renderTargets->AcquireTransient(desc);
+        }
+    }
+
+    RenderTargetManager::RenderTarget renderTarget = renderTargets->GetTarget(renderHandle);
+    m_TargetWidth = renderTarget.desc.width;
+    m_TargetHeight = renderTarget.desc.height;
+
     RenderingCommand::EnableDepthTesting();
     RenderingCommand::EnableFaceCulling();
+
+    SetupCamera();
+    CullScene();
+    RenderShadowMaps();
+
+    unsigned renderFBO = renderTarget.FBO;
+    RenderingCommand::BindFrameBuffer(renderFBO);
     RenderingCommand::ClearColor(m_Scene->background);
     RenderingCommand::Clear();
 
-    SetupCamera();
+    bool depthPrepass = m_Scene->isDepthPrepassEnabled;
+
+    if (depthPrepass)
+    {
+        RenderDepthPrepass();
 
-    if (m_Scene->isGridEnabled)
+        // Depth is already final, so only the visible surface of each pixel runs the lighting shaders
+        RenderingCommand::SetDepthFunction(RenderingAPI::DepthFunction::Equal);
+        RenderingCommand::DisableDepthMask();
+    }
+    else if (m_Scene->isGridEnabled)
     {
         RenderEditorGrid();
     }
@@ -69,23 +143,252 @@ void Renderer::RenderScene()
     RenderVisibleObjects();
     RenderVisibleModels();
 
+    if (depthPrepass)
+    {
+        RenderingCommand::SetDepthFunction(RenderingAPI::DepthFunction::Less);
+        RenderingCommand::EnableDepthMask();
+
+        // The grid never wrote depth, draw it over the finished opaque pass instead
+        if (m_Scene->isGridEnabled)
+        {
+            RenderEditorGrid();
+        }
+    }
+
+    // Depth is final here, next frames test against it once its readback lands
+    {
+        GPUProfiler::Scope gpuScope("Depth Pyramid");
+        m_OcclusionCuller->BuildDepthPyramid(renderTarget.depthTexture, sceneTarget.desc.width,
+                                             sceneTarget.desc.height);
+    }
+
+    if (renderHandle != m_SceneTarget)
+    {
+        RenderUpscale(renderTarget, sceneTarget);
+        renderTargets->ReleaseTransient(renderHandle);
+    }
+
     unsigned int empty = 0;
     RenderingCommand::BindFrameBuffer(empty);
+
+    GPUProfiler::GetGPUProfilerInstance()->EndPass();
+    UpdateRenderScale();
+
+    m_UniformRing->EndFrame();
+    m_ClusteredLighting->EndFrame();
+    m_ShadowMaps->EndFrame();
+}
+
+void Renderer::RenderUpscale(const RenderTargetManager::RenderTarget &source,
+                             const RenderTargetManager::RenderTarget &destination)
+{
+    GPUProfiler::Scope gpuScope("Resolve");
+
+    unsigned destinationFBO = destination.FBO;
+    RenderingCommand::BindFrameBuffer(destinationFBO);
+    RenderingCommand::SetViewport(destination.desc.width, destination.desc.height);
+
+    // Every pixel of the view is overwritten, so there is nothing to clear or depth test against
+    RenderingCommand::SetDepthFunction(RenderingAPI::DepthFunction::Always);
+    RenderingCommand::DisableDepthMask();
+    RenderingCommand::SetPolygonMode(RenderingAPI::PolygonDataType::PolygonFill);
+
+    m_UpscaleShader.Use();
+    RenderingCommand::SetUniformFloat(m_UpscaleShader.ID, "sharpness", s_UpscaleSharpness);
+    RenderingCommand::BindTexture(RenderingAPI::Texture::Texture0, RenderingAPI::TextureTarget::Texture2D,
+                                  source.colorTexture);
+
+    RenderingCommand::BindVertexArray(m_ScreenQuadVAO);
+    RenderingCommand::SubmitDrawArrays(RenderingAPI::DrawMode::Triangles, 0, 6);
+
+    unsigned int empty = 0;
+    RenderingCommand::BindVertexArray(empty);
+
+    RenderingCommand::SetPolygonMode(m_Window->m_PolygonMode);
+    RenderingCommand::SetDepthFunction(RenderingAPI::DepthFunction::Less);
+    RenderingCommand::EnableDepthMask();
+}
+
+void Renderer::UpdateRenderScale()
+{
+    if (!m_Scene->isDynamicResolutionEnabled)
+    {
+        m_DynamicResolution->Reset();
+        return;
+    }
+
+    // Timings land a few frames late, and only when a frame's queries were free to record
+    auto &gpuProfiler = GPUProfiler::GetGPUProfilerInstance();
+    if (gpuProfiler->GetCollectedFrames() == m_CollectedGPUFrames)
+    {
+        return;
+    }
+
+    m_CollectedGPUFrames = gpuProfiler->GetCollectedFrames();
+
+    if (const GPUProfiler::PassTiming *scenePass = gpuProfiler->FindPass(s_ScenePassName))
+    {
+        m_DynamicResolution->Update(scenePass->lastMilliseconds, m_Scene->gpuFrameBudgetMs);
+    }
 }
 
 void Renderer::SetupCamera()
 {
+    MS_PROFILE_FUNCTION();
+
     float nearClip = 0.1f;
     float farClip = 100.0f;
 
-    m_Scene->activeCamera->SetProjectionMatrix(m_Window->GetWidth(), m_Window->GetHeight(), nearClip, farClip);
+    m_Scene->activeCamera->SetProjectionMatrix(m_TargetWidth, m_TargetHeight, nearClip, farClip);
 
     m_Scene->activeCamera->SetViewMatrix();
     m_Scene->activeCamera->SetModel({0, 0, 0});
+
+    FrameData frameData;
+    frameData.view = m_Scene->activeCamera->GetViewMatrix();
+    frameData.projection = m_Scene->activeCamera->GetProjectionMatrix();
+    frameData.viewPos = glm::vec4(m_Scene->activeCamera->GetPosition(), 1.0f);
+
+    // Shadow slots are picked first so the cluster light table can point at them
+    m_ShadowMaps->Update(*m_Scene, frameData.view, frameData.projection, nearClip, farClip);
+
+    // Point lights are binned against this frame's camera before anything is shaded
+    m_ClusteredLighting->Update(m_Scene->lights, m_ShadowMaps->GetPointShadowSlots(), frameData.view,
+                                frameData.projection, nearClip, farClip);
+    m_ClusteredLighting->Bind();
+
+    frameData.clusterParams = m_ClusteredLighting->GetClusterParams();
+    frameData.clusterGrid = m_ClusteredLighting->GetClusterGrid();
+
+    m_FrameDataAllocation = m_UniformRing->Push(frameData);
+    m_UniformRing->Bind(m_FrameDataAllocation, s_FrameDataBinding);
+}
+
+void Renderer::RenderShadowMaps()
+{
+    MS_PROFILE_FUNCTION();
+
+    GPUProfiler::Scope gpuScope("Shadows");
+
+    m_ShadowCasterDrawData.clear();
+
+    m_ShadowMaps->Render(
+        [this](const glm::mat4 &view, const glm::mat4 &projection) { return RenderShadowCasters(view, projection); });
+
+    // Shadow passes replace the camera's frame data and viewport
+    m_UniformRing->Bind(m_FrameDataAllocation, s_FrameDataBinding);
+    RenderingCommand::SetViewport(m_TargetWidth, m_TargetHeight);
+
+    m_ShadowMaps->Bind();
+}
+
+bool Renderer::RenderShadowCasters(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    FrameData frameData = {};
+    frameData.view = view;
+    frameData.projection = projection;
+
+    if (!m_UniformRing->Bind(m_UniformRing->Push(frameData), s_FrameDataBinding))
+    {
+        return false;
+    }
+
+    // Up to a few dozen passes redraw the same casters, so their transforms are only written by the first one
+    if (m_ShadowCasterDrawData.empty())
+    {
+        for (auto &object : m_Scene->objects)
+        {
+            m_ShadowCasterDrawData.push_back(AllocateDrawData(GetTransformationMatrix(object)));
+        }
+
+        for (auto &model : m_Scene->models)
+        {
+            m_ShadowCasterDrawData.push_back(AllocateDrawData(GetTransformationMatrix(model)));
+        }
+    }
+
+    m_DepthShader.Use();
+
+    bool complete = true;
+    size_t caster = 0;
+
+    // Casters outside the camera's view still shadow what is inside it, so nothing here is culled
+    for (auto &object : m_Scene->objects)
+    {
+        if (!m_UniformRing->Bind(m_ShadowCasterDrawData[caster++], s_DrawDataBinding))
+        {
+            complete = false;
+            continue;
+        }
+
+        RenderingCommand::BindVertexArray(object.vao);
+        RenderingCommand::SubmitDrawArrays(RenderingAPI::DrawMode::Triangles, 0, object.size);
+    }
+
+    unsigned int empty = 0;
+    RenderingCommand::BindVertexArray(empty);
+
+    for (auto &model : m_Scene->models)
+    {
+        if (!m_UniformRing->Bind(m_ShadowCasterDrawData[caster++], s_DrawDataBinding))
+        {
+            complete = false;
+            continue;
+        }
+
+        model.Draw(m_DepthShader);
+    }
+
+    return complete;
+}
+
+void Renderer::CullScene()
+{
+    MS_PROFILE_FUNCTION();
+
+    m_OcclusionCuller->BeginFrame(m_Scene->activeCamera->GetViewMatrix(), m_Scene->activeCamera->GetProjectionMatrix(),
+                                  m_Scene->isOcclusionCullingEnabled);
+
+    // Bounding spheres around each origin, base cubes span -1 to 1 on every axis
+    m_ObjectVisibility.resize(m_Scene->objects.size());
+    for (size_t i = 0; i < m_Scene->objects.size(); ++i)
+    {
+        const auto &object = m_Scene->objects[i];
+        float scale = std::max(object.scale.x, std::max(object.scale.y, object.scale.z));
+
+        m_ObjectVisibility[i] = m_OcclusionCuller->IsVisible(object.position, std::sqrt(3.0f) * scale);
+    }
+
+    m_ModelVisibility.resize(m_Scene->models.size());
+    for (size_t i = 0; i < m_Scene->models.size(); ++i)
+    {
+        const auto &model = m_Scene->models[i];
+        float scale = std::max(model.scale.x, std::max(model.scale.y, model.scale.z));
+
+        m_ModelVisibility[i] = m_OcclusionCuller->IsVisible(model.position, model.GetBoundingRadius() * scale);
+    }
+}
+
+RingBuffer::Allocation Renderer::AllocateDrawData(const glm::mat4 &model, int materialIndex)
+{
+    DrawData drawData;
+    drawData.model = model;
+    drawData.normalMatrix = glm::transpose(glm::inverse(model));
+    drawData.drawInfo = glm::ivec4(materialIndex, 0, 0, 0);
+
+    return m_UniformRing->Push(drawData);
+}
+
+bool Renderer::PushDrawData(const glm::mat4 &model, int materialIndex)
+{
+    // Drawing without its own data would reuse whatever transform is still bound
+    return m_UniformRing->Bind(AllocateDrawData(model, materialIndex), s_DrawDataBinding);
 }
 
 void Renderer::RenderEditorGrid()
 {
+    GPUProfiler::Scope gpuScope("Grid");
+
     if (!m_Scene->shaders.empty())
     {
         RenderingCommand::DisableFaceCulling();
@@ -98,13 +401,11 @@ void Renderer::RenderEditorGrid()
         {
             RenderingCommand::BindVertexArray(m_VAO);
 
-            RenderingCommand::SetUniformMat4(m_Scene->shaders[0].ID, "model", m_Scene->activeCamera->GetModel());
-            RenderingCommand::SetUniformMat4(m_Scene->shaders[0].ID, "view", m_Scene->activeCamera->GetViewMatrix());
-            RenderingCommand::SetUniformMat4(m_Scene->shaders[0].ID, "projection",
-                                             m_Scene->activeCamera->GetProjectionMatrix());
-
-            RenderingCommand::SubmitDrawArrays(RenderingAPI::DrawMode::Triangles, 0,
-                                               Tools::BaseShapes::gridVerticesSize / 3 * sizeof(float));
+            if (PushDrawData(m_Scene->activeCamera->GetModel()))
+            {
+                RenderingCommand::SubmitDrawArrays(RenderingAPI::DrawMode::Triangles, 0,
+                                                   Tools::BaseShapes::gridVerticesSize / 3 * sizeof(float));
+            }
 
             unsigned int empty = 0;
             RenderingCommand::BindVertexArray(empty);
@@ -124,12 +425,89 @@ void Renderer::RenderEditorGrid()
     }
 }
 
+void Renderer::RenderDepthPrepass()
+{
+    MS_PROFILE_FUNCTION();
+
+    GPUProfiler::Scope gpuScope("Depth Prepass");
+
+    glm::vec3 cameraPosition = m_Scene->activeCamera->GetPosition();
+    auto distanceToCamera = [&cameraPosition](const glm::vec3 &position) {
+        glm::vec3 offset = position - cameraPosition;
+        return glm::dot(offset, offset);
+    };
+
+    m_DepthPrepassDraws.clear();
+
+    for (size_t i = 0; i < m_Scene->objects.size(); ++i)
+    {
+        auto &object = m_Scene->objects[i];
+        if (m_ObjectVisibility[i])
+        {
+            m_DepthPrepassDraws.push_back(
+                {distanceToCamera(object.position), GetTransformationMatrix(object), object.vao, object.size, nullptr});
+        }
+    }
+
+    for (size_t i = 0; i < m_Scene->models.size(); ++i)
+    {
+        auto &model = m_Scene->models[i];
+        if (m_ModelVisibility[i])
+        {
+            m_DepthPrepassDraws.push_back(
+                {distanceToCamera(model.position), GetTransformationMatrix(model), 0, 0, &model});
+        }
+    }
+
+    // Front to back so nearer occluders reject as much of what follows as possible
+    std::sort(m_DepthPrepassDraws.begin(), m_DepthPrepassDraws.end(),
+              [](const DepthPrepassDraw &a, const DepthPrepassDraw &b) { return a.distance < b.distance; });
+
+    RenderingCommand::DisableColorMask();
+    m_DepthShader.Use();
+
+    for (auto &draw : m_DepthPrepassDraws)
+    {
+        if (!PushDrawData(draw.transform))
+        {
+            continue;
+        }
+
+        if (draw.model)
+        {
+            draw.model->Draw(m_DepthShader);
+            continue;
+        }
+
+        RenderingCommand::BindVertexArray(draw.vao);
+        RenderingCommand::SubmitDrawArrays(RenderingAPI::DrawMode::Triangles, 0, draw.size);
+    }
+
+    unsigned int empty = 0;
+    RenderingCommand::BindVertexArray(empty);
+
+    RenderingCommand::EnableColorMask();
+}
+
 void Renderer::RenderVisibleModels()
 {
+    MS_PROFILE_FUNCTION();
+
+    GPUProfiler::Scope gpuScope("Models");
+
     unsigned currentShaderID = 0;
 
-    for (auto &model : m_Scene->models)
+    // Texture arrays and their table are shared by every model, bind them once
+    TextureStreamer::GetTextureStreamerInstance()->Bind();
+
+    for (size_t i = 0; i < m_Scene->models.size(); ++i)
     {
+        auto &model = m_Scene->models[i];
+        if (!m_ModelVisibility[i])
+        {
+            continue;
+        }
+
         if (model.shader.ID != currentShaderID)
         {
             model.shader.Use();
@@ -138,19 +516,18 @@ void Renderer::RenderVisibleModels()
             RenderLighting(model);
         }
 
-        // User applied transformations
-        glm::mat4 modelTransformationMatrix =
-            glm::translate(glm::mat4(1.0f), model.position) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(model.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(model.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(model.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
-            glm::scale(glm::mat4(1.0f), model.scale);
+        if (!PushDrawData(GetTransformationMatrix(model)))
+        {
+            continue;
+        }
 
-        RenderingCommand::SetUniformMat4(model.shader.ID, "model", modelTransformationMatrix);
-        RenderingCommand::SetUniformMat4(model.shader.ID, "view", m_Scene->activeCamera->GetViewMatrix());
-        RenderingCommand::SetUniformMat4(model.shader.ID, "projection", m_Scene->activeCamera->GetProjectionMatrix());
+        // Rough on-screen size of the model's bounding sphere, in pixels, drives how many mips get streamed in
+        float radius = model.GetBoundingRadius() * std::max(model.scale.x, std::max(model.scale.y, model.scale.z));
+        float distance = std::max(glm::length(model.position - m_Scene->activeCamera->GetPosition()), 0.1f);
+        float halfFov = glm::radians(m_Scene->activeCamera->GetFov()) * 0.5f;
+        float projectedPixels = radius / (distance * std::tan(halfFov)) * m_TargetHeight;
 
-        RenderingCommand::SetUniformVec3(model.shader.ID, "viewPos", m_Scene->activeCamera->GetPosition());
+        model.RequestTextureResolution(static_cast<int>(projectedPixels));
 
         model.Draw(model.shader);
     }
@@ -158,10 +535,20 @@ void Renderer::RenderVisibleModels()
 
 void Renderer::RenderVisibleObjects()
 {
+    MS_PROFILE_FUNCTION();
+
+    GPUProfiler::Scope gpuScope("Objects");
+
     unsigned currentShaderID = 0;
 
-    for (auto &object : m_Scene->objects)
+    for (size_t i = 0; i < m_Scene->objects.size(); ++i)
     {
+        auto &object = m_Scene->objects[i];
+        if (!m_ObjectVisibility[i])
+        {
+            continue;
+        }
+
         if (object.shader.ID != currentShaderID)
         {
             object.shader.Use();
@@ -170,27 +557,13 @@ void Renderer::RenderVisibleObjects()
             RenderLighting(object);
         }
 
-        RenderingCommand::BindVertexArray(object.vao);
-
-        // User applied transformations
-        glm::mat4 modelTransformationMatrix =
-            glm::translate(glm::mat4(1.0f), object.position) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(object.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(object.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
-            glm::rotate(glm::mat4(1.0f), glm::radians(object.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
-            glm::scale(glm::mat4(1.0f), object.scale);
-
-        RenderingCommand::SetUniformMat4(object.shader.ID, "model", modelTransformationMatrix);
-        RenderingCommand::SetUniformMat4(object.shader.ID, "view", m_Scene->activeCamera->GetViewMatrix());
-        RenderingCommand::SetUniformMat4(object.shader.ID, "projection", m_Scene->activeCamera->GetProjectionMatrix());
-
-        // If an object doesn't have a material or texture, make it the ugliest pink u can possibly imagine
-        RenderingCommand::SetUniformVec3(object.shader.ID, "material.baseColour", object.material.baseColour);
-        RenderingCommand::SetUniformVec3(object.shader.ID, "material.diffuse", object.material.diffuse);
-        RenderingCommand::SetUniformVec3(object.shader.ID, "material.specular", object.material.specular);
-        RenderingCommand::SetUniformFloat(object.shader.ID, "material.shininess", object.material.shininess);
+        // Material values live in the registry's table, the draw only says which entry to use
+        if (!PushDrawData(GetTransformationMatrix(object), static_cast<int>(object.materialIndex)))
+        {
+            continue;
+        }
 
-        RenderingCommand::SetUniformVec3(object.shader.ID, "viewPos", m_Scene->activeCamera->GetPosition());
+        RenderingCommand::BindVertexArray(object.vao);
 
         // TODO Set to time of day or user set dirlight
         // TODO Fix for a clean blend between cubes and models
@@ -221,110 +594,26 @@ void Renderer::DeactivatePointLight(Lighting::Light &lightToDeactivate)
             return sceneLight.id == lightToDeactivate.id;
         });
 
+    // Point lights are re-clustered every frame, an inactive one simply drops out of the next frame's lists
     if (it != m_Scene->lights.end())
     {
         it->isActive = false;
-
-        int lightIndex = std::distance(m_Scene->lights.begin(), it);
-
-        bool hasDirLight = false;
-        for (int i = 0; i < lightIndex; ++i)
-        {
-            if (m_Scene->lights[i].type == Lighting::LightType::Directional)
-            {
-                hasDirLight = true;
-                break;
-            }
-        }
-
-        if (hasDirLight)
-        {
-            lightIndex -= 1;
-        }
-
-        MS_INFO(lightIndex);
-        for (auto &object : m_Scene->objects)
-        {
-            std::string uniformName = "pointLights[" + std::to_string(lightIndex) + "].isActive";
-            RenderingCommand::SetUniformBool(object.shader.ID, uniformName, false);
-        }
-
-        for (auto &model : m_Scene->models)
-        {
-            std::string uniformName = "pointLights[" + std::to_string(lightIndex) + "].isActive";
-            RenderingCommand::SetUniformBool(model.shader.ID, uniformName, false);
-        }
     }
 }
 
 template <typename T> void Renderer::RenderLighting(T &object)
 {
-    int pointLightIndex = 0;
-    for (int i = 0; i < m_Scene->lights.size(); ++i)
-    {
-        if (m_Scene->lights[i].type == Lighting::LightType::Directional)
-        {
-            RenderingCommand::SetUniformVec3(object.shader.ID, "dirLight.direction", m_Scene->lights[i].direction);
-            RenderingCommand::SetUniformVec3(object.shader.ID, "dirLight.ambient", m_Scene->lights[i].ambient);
-            RenderingCommand::SetUniformVec3(object.shader.ID, "dirLight.diffuse", m_Scene->lights[i].diffuse);
-            RenderingCommand::SetUniformVec3(object.shader.ID, "dirLight.specular", m_Scene->lights[i].specular);
-            RenderingCommand::SetUniformBool(object.shader.ID, "dirLight.isActive", m_Scene->lights[i].isActive);
-        }
-        else if (m_Scene->lights[i].type == Lighting::LightType::Point)
-        {
-            std::stringstream ss;
-
-            ss << "pointLights[" << pointLightIndex << "].position";
-            RenderingCommand::SetUniformVec3(object.shader.ID, ss.str(), m_Scene->lights[i].position);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].ambient";
-            RenderingCommand::SetUniformVec3(object.shader.ID, ss.str(), m_Scene->lights[i].ambient);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].diffuse";
-            RenderingCommand::SetUniformVec3(object.shader.ID, ss.str(), m_Scene->lights[i].diffuse);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].specular";
-            RenderingCommand::SetUniformVec3(object.shader.ID, ss.str(), m_Scene->lights[i].specular);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].constant";
-            RenderingCommand::SetUniformFloat(object.shader.ID, ss.str(), m_Scene->lights[i].constant);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].linear";
-            RenderingCommand::SetUniformFloat(object.shader.ID, ss.str(), m_Scene->lights[i].linear);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].quadratic";
-            RenderingCommand::SetUniformFloat(object.shader.ID, ss.str(), m_Scene->lights[i].quadratic);
-            ss.str("");
-            ss.clear();
-
-            ss << "pointLights[" << pointLightIndex << "].isActive";
-            RenderingCommand::SetUniformBool(object.shader.ID, ss.str(), m_Scene->lights[i].isActive);
-            ss.str("");
-            ss.clear();
-
-            ++pointLightIndex;
-        }
-    }
+    SetLightUniforms(object.shader.ID, m_Scene->lights);
 }
 
 void Renderer::CleanupScene()
 {
-    for (int i = 0; i < m_Scene->objects.size(); ++i)
+    for (auto &object : m_Scene->objects)
     {
-        RenderingCommand::Cleanup(m_VAO, m_VBO, m_Scene->shaders[i].ID);
+        RenderingCommand::Cleanup(object.vao, object.vbo, object.shader.ID);
     }
+
+    RenderingCommand::Cleanup(m_VAO, m_VBO, m_Scene->shaders.front().ID);
 }
 
 } // namespace Rendering
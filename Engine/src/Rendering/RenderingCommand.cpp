@@ -16,6 +16,9 @@ std::unique_ptr<RenderingAPI> RenderingCommand::s_RenderingAPI = std::make_uniqu
 std::unique_ptr<RenderingAPI> RenderingCommand::s_RenderingAPI = std::make_unique<VulkanRenderingAPI>();
 #endif
 
+RenderingCommand::Stats RenderingCommand::s_Stats;
+RenderingCommand::Stats RenderingCommand::s_LastFrameStats;
+
 } // namespace Rendering
 
 } // namespace Moonstone
@@ -0,0 +1,132 @@
+#include "Include/RingBuffer.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+RingBuffer::RingBuffer(RenderingAPI::BufferTarget target, size_t segmentSize, unsigned framesInFlight)
+    : m_Target(target), m_SegmentSize(0), m_FramesInFlight(framesInFlight), m_Fences(framesInFlight, nullptr)
+{
+    m_Alignment = std::max<size_t>(RenderingCommand::GetBufferOffsetAlignment(target), 16);
+
+    Grow(segmentSize);
+}
+
+RingBuffer::~RingBuffer()
+{
+    for (auto &fence : m_Fences)
+    {
+        RenderingCommand::WaitFence(fence);
+    }
+
+    for (auto &retired : m_RetiredBuffers)
+    {
+        RenderingCommand::WaitFence(retired.fence);
+        RenderingCommand::DeleteBuffer(retired.buffer);
+    }
+
+    RenderingCommand::DeleteBuffer(m_Buffer);
+}
+
+void RingBuffer::BeginFrame()
+{
+    m_CurrentSegment = (m_CurrentSegment + 1) % m_FramesInFlight;
+    m_Head = 0;
+
+    // Only blocks when the GPU is more than framesInFlight frames behind
+    RenderingCommand::WaitFence(m_Fences[m_CurrentSegment]);
+
+    // Buffers retired mid-frame only get their fence at the end of that frame
+    for (size_t i = 0; i < m_RetiredBuffers.size();)
+    {
+        RetiredBuffer &retired = m_RetiredBuffers[i];
+
+        if (retired.fence && RenderingCommand::IsFenceSignalled(retired.fence))
+        {
+            RenderingCommand::DeleteBuffer(retired.buffer);
+            m_RetiredBuffers[i] = m_RetiredBuffers.back();
+            m_RetiredBuffers.pop_back();
+            continue;
+        }
+
+        ++i;
+    }
+}
+
+void RingBuffer::EndFrame()
+{
+    m_Fences[m_CurrentSegment] = RenderingCommand::InsertFence();
+
+    for (auto &retired : m_RetiredBuffers)
+    {
+        if (!retired.fence)
+        {
+            retired.fence = RenderingCommand::InsertFence();
+        }
+    }
+}
+
+RingBuffer::Allocation RingBuffer::Allocate(size_t size)
+{
+    size_t alignedSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+    if (!m_MappedData || m_Head + alignedSize > m_SegmentSize)
+    {
+        if (!Grow(std::max(m_SegmentSize * 2, alignedSize)))
+        {
+            return {};
+        }
+    }
+
+    Allocation allocation;
+    allocation.offset = m_CurrentSegment * m_SegmentSize + m_Head;
+    allocation.data = m_MappedData + allocation.offset;
+    allocation.buffer = m_Buffer;
+    allocation.size = size;
+
+    m_Head += alignedSize;
+    return allocation;
+}
+
+bool RingBuffer::Grow(size_t minimumSegmentSize)
+{
+    // Keep every segment start aligned so offsets stay valid for BindBufferRange
+    size_t segmentSize = (minimumSegmentSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+    unsigned buffer = 0;
+    void *mappedData = nullptr;
+    RenderingCommand::InitPersistentBuffer(buffer, segmentSize * m_FramesInFlight, mappedData);
+
+    if (!mappedData)
+    {
+        RenderingCommand::DeleteBuffer(buffer);
+
+        if (!m_OverflowReported)
+        {
+            MS_ERROR("ring buffer could not grow to {0} byte segments, dropping per-frame data", segmentSize);
+            m_OverflowReported = true;
+        }
+
+        return false;
+    }
+
+    // Earlier frames, and this one, may still be reading the old buffer
+    if (m_Buffer != 0)
+    {
+        MS_WARN("ring buffer segment of {0} bytes exhausted, growing to {1} bytes", m_SegmentSize, segmentSize);
+        m_RetiredBuffers.push_back({m_Buffer, nullptr});
+    }
+
+    m_Buffer = buffer;
+    m_MappedData = static_cast<unsigned char *>(mappedData);
+    m_SegmentSize = segmentSize;
+    m_Head = 0;
+
+    return true;
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
@@ -83,6 +83,8 @@ void SceneManager::AddObjectToScene(std::shared_ptr<Scene> scene)
     Rendering::SceneObject cube = {true,      vao,     vbo,      {0, 0, 0},  {0, 0, 0},
                                    {1, 1, 1}, cubeMat, ss.str(), cubeShader, Tools::BaseShapes::cubeVerticesSize};
 
+    cube.materialIndex = MaterialRegistry::GetMaterialRegistryInstance()->RegisterMaterial(cubeMat);
+
     scene->objects.push_back(cube);
 }
 
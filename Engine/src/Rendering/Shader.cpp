@@ -43,6 +43,33 @@ Shader::Shader(const char *vertexPath, const char *fragmentPath)
     Rendering::RenderingCommand::InitShaderProgram(ID, vertex, fragment);
 }
 
+Shader::Shader(const char *computePath)
+{
+    std::string computeCode;
+    std::ifstream cShaderFile;
+
+    cShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    try
+    {
+        std::stringstream cShaderStream;
+
+        cShaderFile.open(computePath);
+        cShaderStream << cShaderFile.rdbuf();
+        cShaderFile.close();
+        computeCode = cShaderStream.str();
+    }
+    catch (std::ifstream::failure e)
+    {
+        MS_ERROR("compute shader file not successfully read");
+    }
+
+    auto cShaderCode = computeCode.c_str();
+
+    unsigned compute;
+    Rendering::RenderingCommand::InitComputeShader(compute, cShaderCode);
+    Rendering::RenderingCommand::InitComputeProgram(ID, compute);
+}
+
 void Shader::Use()
 {
     Rendering::RenderingCommand::UseProgram(ID);
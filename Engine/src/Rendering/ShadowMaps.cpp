@@ -0,0 +1,408 @@
+#include "Include/ShadowMaps.h"
+#include "Core/Include/Profiler.h"
+#include "Rendering/Include/ClusteredLighting.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+ShadowMaps::ShadowMaps() : m_ShadowData{}
+{
+    RenderingCommand::InitDepthFrameBuffer(m_FrameBuffer);
+    RenderingCommand::InitShadowTexture(m_CascadeTexture, RenderingAPI::TextureTarget::Texture2DArray, s_CascadeSize,
+                                        s_CascadeCount);
+    RenderingCommand::InitShadowTexture(m_PointShadowTexture, RenderingAPI::TextureTarget::TextureCubeMapArray,
+                                        s_PointShadowSize, s_MaxPointShadows * 6);
+
+    m_Ring = std::make_unique<RingBuffer>(RenderingAPI::BufferTarget::Uniform, sizeof(ShadowData));
+}
+
+ShadowMaps::~ShadowMaps()
+{
+    RenderingCommand::DeleteTexture(m_CascadeTexture);
+    RenderingCommand::DeleteTexture(m_PointShadowTexture);
+    RenderingCommand::DeleteFrameBuffer(m_FrameBuffer);
+}
+
+void ShadowMaps::Update(const Scene &scene, const glm::mat4 &view, const glm::mat4 &projection, float nearClip,
+                        float farClip)
+{
+    MS_PROFILE_FUNCTION();
+
+    m_Ring->BeginFrame();
+    m_Stats = {};
+
+    UpdateCasters(scene);
+    UpdateCascades(scene, view, projection, nearClip);
+    UpdatePointShadows(scene, glm::vec3(glm::inverse(view)[3]), farClip);
+
+    m_InvalidateAll = false;
+
+    m_ShadowDataAllocation = m_Ring->Push(m_ShadowData);
+}
+
+void ShadowMaps::Render(const CasterPass &pass)
+{
+    RenderingCommand::BindFrameBuffer(m_FrameBuffer);
+    RenderingCommand::EnablePolygonOffset(2.0f, 4.0f);
+
+    if (m_HasDirectionalLight)
+    {
+        RenderingCommand::SetViewport(s_CascadeSize, s_CascadeSize);
+
+        for (int i = 0; i < s_CascadeCount; ++i)
+        {
+            Cascade &cascade = m_Cascades[i];
+            if (!cascade.dirty)
+            {
+                continue;
+            }
+
+            RenderingCommand::AttachDepthLayer(m_FrameBuffer, m_CascadeTexture, i);
+            RenderingCommand::Clear();
+            cascade.dirty = !pass(cascade.view, cascade.projection);
+            ++m_Stats.cascadesRendered;
+        }
+    }
+
+    RenderingCommand::SetViewport(s_PointShadowSize, s_PointShadowSize);
+
+    for (int slot = 0; slot < s_MaxPointShadows; ++slot)
+    {
+        PointShadow &shadow = m_PointShadows[slot];
+        if (!shadow.inUse)
+        {
+            continue;
+        }
+
+        // Far plane matches the radius the light is clustered with, the shaders rebuild depth from it
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, s_PointShadowNear, shadow.radius);
+
+        for (int face = 0; face < 6; ++face)
+        {
+            if (!shadow.dirtyFaces[face])
+            {
+                continue;
+            }
+
+            RenderingCommand::AttachDepthLayer(m_FrameBuffer, m_PointShadowTexture, slot * 6 + face);
+            RenderingCommand::Clear();
+            shadow.dirtyFaces[face] = !pass(FaceView(shadow.position, face), projection);
+            ++m_Stats.facesRendered;
+        }
+    }
+
+    RenderingCommand::DisablePolygonOffset();
+}
+
+void ShadowMaps::Bind() const
+{
+    m_Ring->Bind(m_ShadowDataAllocation, s_ShadowDataBinding);
+
+    RenderingCommand::BindTexture(s_CascadeTextureUnit, RenderingAPI::TextureTarget::Texture2DArray, m_CascadeTexture);
+    RenderingCommand::BindTexture(s_PointShadowTextureUnit, RenderingAPI::TextureTarget::TextureCubeMapArray,
+                                  m_PointShadowTexture);
+}
+
+void ShadowMaps::EndFrame()
+{
+    m_Ring->EndFrame();
+}
+
+template <typename T>
+void ShadowMaps::TrackCaster(std::vector<CasterState> &states, size_t index, const T &caster, float localRadius)
+{
+    float scale = std::max(caster.scale.x, std::max(caster.scale.y, caster.scale.z));
+    Bounds bounds = {caster.position, localRadius * scale};
+
+    CasterState &state = states[index];
+    if (state.position != caster.position || state.rotation != caster.rotation || state.scale != caster.scale)
+    {
+        m_ChangedBounds.push_back(state.bounds);
+        m_ChangedBounds.push_back(bounds);
+
+        state = {caster.position, caster.rotation, caster.scale, bounds};
+    }
+}
+
+void ShadowMaps::UpdateCasters(const Scene &scene)
+{
+    m_ChangedBounds.clear();
+
+    // Adding or removing casters shifts indices, so there is nothing sensible to diff against
+    if (scene.objects.size() != m_ObjectCasters.size() || scene.models.size() != m_ModelCasters.size())
+    {
+        m_InvalidateAll = true;
+        m_ObjectCasters.assign(scene.objects.size(), CasterState{});
+        m_ModelCasters.assign(scene.models.size(), CasterState{});
+    }
+
+    // Base cubes span -1 to 1 on every axis
+    for (size_t i = 0; i < scene.objects.size(); ++i)
+    {
+        TrackCaster(m_ObjectCasters, i, scene.objects[i], std::sqrt(3.0f));
+    }
+
+    for (size_t i = 0; i < scene.models.size(); ++i)
+    {
+        TrackCaster(m_ModelCasters, i, scene.models[i], scene.models[i].GetBoundingRadius());
+    }
+}
+
+void ShadowMaps::UpdateCascades(const Scene &scene, const glm::mat4 &view, const glm::mat4 &projection,
+                                float nearClip)
+{
+    m_ShadowData.shadowParams = glm::vec4(0.0f, s_PointShadowNear, 1.0f / s_CascadeSize, 0.0f);
+
+    auto light = std::find_if(scene.lights.begin(), scene.lights.end(), [](const Lighting::Light &light) {
+        return light.type == Lighting::LightType::Directional && light.isActive;
+    });
+
+    if (light == scene.lights.end())
+    {
+        m_HasDirectionalLight = false;
+        return;
+    }
+
+    glm::vec3 direction = glm::normalize(light->direction);
+    bool lightChanged = !m_HasDirectionalLight || glm::length(direction - m_LightDirection) > 1e-4f;
+
+    m_HasDirectionalLight = true;
+    m_LightDirection = direction;
+
+    glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+
+    float splitNear = nearClip;
+    for (int i = 0; i < s_CascadeCount; ++i)
+    {
+        // Practical split scheme, a blend of logarithmic and uniform splits
+        float ratio = static_cast<float>(i + 1) / s_CascadeCount;
+        float logSplit = nearClip * std::pow(s_ShadowDistance / nearClip, ratio);
+        float uniformSplit = nearClip + (s_ShadowDistance - nearClip) * ratio;
+        float splitFar = glm::mix(uniformSplit, logSplit, s_CascadeSplitLambda);
+
+        // Bounding sphere of this slice of the view frustum, which only changes size with fov or aspect
+        std::array<glm::vec3, 8> corners;
+        glm::vec3 centre(0.0f);
+        int corner = 0;
+        for (float depth : {splitNear, splitFar})
+        {
+            float ndcZ = (projection[2][2] * -depth + projection[3][2]) / depth;
+            for (float y : {-1.0f, 1.0f})
+            {
+                for (float x : {-1.0f, 1.0f})
+                {
+                    glm::vec4 world = inverseViewProjection * glm::vec4(x, y, ndcZ, 1.0f);
+                    corners[corner] = glm::vec3(world) / world.w;
+                    centre += corners[corner++];
+                }
+            }
+        }
+
+        centre /= 8.0f;
+
+        float radius = 0.0f;
+        for (const auto &point : corners)
+        {
+            radius = std::max(radius, glm::length(point - centre));
+        }
+
+        // Headroom lets the camera move without re-centring, whole units keep the texel size stable
+        float extent = std::ceil(radius * (1.0f + s_CascadeHeadroom));
+
+        Cascade &cascade = m_Cascades[i];
+        if (!cascade.valid || lightChanged || extent != cascade.extent ||
+            glm::length(centre - cascade.centre) + radius > cascade.extent)
+        {
+            // Snap to the texel grid in light space so a re-centred cascade rasterises casters identically
+            float texelSize = 2.0f * extent / s_CascadeSize;
+            glm::vec3 lightSpaceCentre = glm::vec3(lightRotation * glm::vec4(centre, 1.0f));
+            lightSpaceCentre.x = std::floor(lightSpaceCentre.x / texelSize) * texelSize;
+            lightSpaceCentre.y = std::floor(lightSpaceCentre.y / texelSize) * texelSize;
+
+            cascade.centre = glm::vec3(glm::inverse(lightRotation) * glm::vec4(lightSpaceCentre, 1.0f));
+            cascade.extent = extent;
+            cascade.view = glm::lookAt(cascade.centre - direction * (extent + s_CasterDistance), cascade.centre, up);
+            cascade.projection = glm::ortho(-extent, extent, -extent, extent, 0.0f, 2.0f * extent + s_CasterDistance);
+            cascade.valid = true;
+            cascade.dirty = true;
+        }
+
+        if (m_InvalidateAll)
+        {
+            cascade.dirty = true;
+        }
+
+        for (const auto &bounds : m_ChangedBounds)
+        {
+            cascade.dirty = cascade.dirty || CascadeTouches(cascade, bounds);
+        }
+
+        m_ShadowData.cascadeViewProjection[i] = cascade.projection * cascade.view;
+        m_ShadowData.cascadeSplits[i] = splitFar;
+
+        splitNear = splitFar;
+    }
+
+    m_ShadowData.shadowParams.x = static_cast<float>(s_CascadeCount);
+}
+
+void ShadowMaps::UpdatePointShadows(const Scene &scene, const glm::vec3 &cameraPosition, float farClip)
+{
+    m_PointShadowSlots.assign(scene.lights.size(), -1);
+
+    // The closest lights to the camera whose reach comes within shadow distance get a cube
+    std::vector<std::pair<float, size_t>> candidates;
+    for (size_t i = 0; i < scene.lights.size(); ++i)
+    {
+        const auto &light = scene.lights[i];
+        if (light.type != Lighting::LightType::Point || !light.isActive)
+        {
+            continue;
+        }
+
+        float radius = ClusteredLighting::LightRadius(light, farClip);
+        float distance = glm::length(light.position - cameraPosition) - radius;
+        if (radius > 0.0f && distance < s_ShadowDistance)
+        {
+            candidates.push_back({distance, i});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.resize(std::min<size_t>(candidates.size(), s_MaxPointShadows));
+
+    // Lights keep the slot they had, so their cached faces survive
+    std::array<bool, s_MaxPointShadows> taken = {};
+    std::vector<size_t> unassigned;
+    for (const auto &candidate : candidates)
+    {
+        const auto &light = scene.lights[candidate.second];
+        auto slot = std::find_if(m_PointShadows.begin(), m_PointShadows.end(), [&light](const PointShadow &shadow) {
+            return shadow.inUse && shadow.lightId == light.id;
+        });
+
+        if (slot == m_PointShadows.end())
+        {
+            unassigned.push_back(candidate.second);
+            continue;
+        }
+
+        int index = static_cast<int>(std::distance(m_PointShadows.begin(), slot));
+        taken[index] = true;
+        m_PointShadowSlots[candidate.second] = index;
+    }
+
+    for (int slot = 0; slot < s_MaxPointShadows; ++slot)
+    {
+        if (!taken[slot])
+        {
+            m_PointShadows[slot].inUse = false;
+        }
+    }
+
+    for (size_t lightIndex : unassigned)
+    {
+        int slot = static_cast<int>(std::distance(taken.begin(), std::find(taken.begin(), taken.end(), false)));
+
+        PointShadow &shadow = m_PointShadows[slot];
+        shadow.lightId = scene.lights[lightIndex].id;
+        shadow.inUse = true;
+        shadow.radius = -1.0f;
+
+        taken[slot] = true;
+        m_PointShadowSlots[lightIndex] = slot;
+    }
+
+    for (size_t i = 0; i < scene.lights.size(); ++i)
+    {
+        int slot = m_PointShadowSlots[i];
+        if (slot < 0)
+        {
+            continue;
+        }
+
+        PointShadow &shadow = m_PointShadows[slot];
+        float radius = ClusteredLighting::LightRadius(scene.lights[i], farClip);
+
+        if (m_InvalidateAll || shadow.position != scene.lights[i].position || shadow.radius != radius)
+        {
+            shadow.position = scene.lights[i].position;
+            shadow.radius = radius;
+            shadow.dirtyFaces.fill(true);
+        }
+
+        for (int face = 0; face < 6; ++face)
+        {
+            for (const auto &bounds : m_ChangedBounds)
+            {
+                shadow.dirtyFaces[face] = shadow.dirtyFaces[face] || FaceTouches(shadow, face, bounds);
+            }
+        }
+
+        ++m_Stats.pointShadowCount;
+    }
+}
+
+bool ShadowMaps::CascadeTouches(const Cascade &cascade, const Bounds &bounds) const
+{
+    glm::vec3 centre = glm::vec3(cascade.view * glm::vec4(bounds.centre, 1.0f));
+    float depthRange = 2.0f * cascade.extent + s_CasterDistance;
+
+    return std::abs(centre.x) <= cascade.extent + bounds.radius &&
+           std::abs(centre.y) <= cascade.extent + bounds.radius && -centre.z >= -bounds.radius &&
+           -centre.z <= depthRange + bounds.radius;
+}
+
+bool ShadowMaps::FaceTouches(const PointShadow &shadow, int face, const Bounds &bounds)
+{
+    glm::vec3 offset = bounds.centre - shadow.position;
+    if (glm::length(offset) > shadow.radius + bounds.radius)
+    {
+        return false;
+    }
+
+    // A face sees the 90 degree pyramid around its axis, test against its four side planes
+    int axis = face / 2;
+    glm::vec3 forward(0.0f);
+    forward[axis] = face % 2 == 0 ? 1.0f : -1.0f;
+
+    for (int side = 1; side < 3; ++side)
+    {
+        glm::vec3 across(0.0f);
+        across[(axis + side) % 3] = 1.0f;
+
+        for (float sign : {-1.0f, 1.0f})
+        {
+            glm::vec3 normal = glm::normalize(forward + sign * across);
+            if (glm::dot(normal, offset) < -bounds.radius)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+glm::mat4 ShadowMaps::FaceView(const glm::vec3 &position, int face)
+{
+    // GL cube map face order and orientation, +X -X +Y -Y +Z -Z
+    static const std::array<glm::vec3, 6> forwards = {glm::vec3(1.0f, 0.0f, 0.0f),  glm::vec3(-1.0f, 0.0f, 0.0f),
+                                                      glm::vec3(0.0f, 1.0f, 0.0f),  glm::vec3(0.0f, -1.0f, 0.0f),
+                                                      glm::vec3(0.0f, 0.0f, 1.0f),  glm::vec3(0.0f, 0.0f, -1.0f)};
+    static const std::array<glm::vec3, 6> ups = {glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+                                                 glm::vec3(0.0f, 0.0f, 1.0f),  glm::vec3(0.0f, 0.0f, -1.0f),
+                                                 glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)};
+
+    return glm::lookAt(position, position + forwards[face], ups[face]);
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone
@@ -0,0 +1,861 @@
+#include "Include/TextureStreamer.h"
+#include "Core/Events/Include/AssetEvents.h"
+#include "Core/Events/Include/EventQueue.h"
+#include "Core/Include/MemoryTracker.h"
+#include "Core/Include/Profiler.h"
+#include "Include/Textures.h"
+
+namespace Moonstone
+{
+
+namespace Rendering
+{
+
+std::shared_ptr<TextureStreamer> TextureStreamer::s_TextureStreamer;
+
+void TextureStreamer::Init()
+{
+    s_TextureStreamer = std::make_shared<TextureStreamer>();
+    MS_INFO("texture streamer initialised");
+}
+
+TextureStreamer::TextureStreamer()
+{
+    m_EventQueue = Core::EventQueue::GetEventQueueInstance();
+    m_Worker = std::thread(&TextureStreamer::WorkerLoop, this);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        m_StopWorker = true;
+    }
+
+    m_JobCondition.notify_all();
+
+    if (m_Worker.joinable())
+    {
+        m_Worker.join();
+    }
+}
+
+unsigned TextureStreamer::RegisterTexture(const std::string &path)
+{
+    auto existing = m_TexturesByPath.find(path);
+    if (existing != m_TexturesByPath.end())
+    {
+        return existing->second;
+    }
+
+    unsigned handle = static_cast<unsigned>(m_Textures.size());
+
+    // Until the tail mips land the handle has no array slot and shaders fall back to a flat colour
+    StreamedTexture texture;
+    texture.path = path;
+    texture.jobPending = true;
+    texture.lastUsedFrame = m_Frame;
+
+    m_Textures.push_back(texture);
+    m_TextureRefs.push_back(TextureRef());
+    m_TexturesByPath[path] = handle;
+    m_TextureTableDirty = true;
+
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        m_Jobs.push_back({handle, path, -1, -1});
+    }
+
+    m_JobCondition.notify_one();
+
+    MS_DEBUG("registered streamed texture: {0}", path);
+    return handle;
+}
+
+void TextureStreamer::RequestResolution(unsigned handle, int pixels)
+{
+    if (handle >= m_Textures.size())
+    {
+        return;
+    }
+
+    StreamedTexture &texture = m_Textures[handle];
+    texture.requestedPixels = std::max(texture.requestedPixels, pixels);
+    texture.lastUsedFrame = m_Frame;
+}
+
+void TextureStreamer::Update()
+{
+    MS_PROFILE_FUNCTION();
+    MS_MEMORY_TAG(Textures);
+
+    std::deque<DecodeResult> results;
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        results.swap(m_Results);
+    }
+
+    size_t uploadedBytes = 0;
+    while (!results.empty() && uploadedBytes < s_MaxUploadBytesPerFrame)
+    {
+        DecodeResult &result = results.front();
+
+        for (auto &level : result.levels)
+        {
+            uploadedBytes += level.data.size();
+        }
+
+        UploadResult(result);
+        results.pop_front();
+    }
+
+    // Anything over this frame's upload allowance goes back to the front of the queue
+    if (!results.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        for (auto it = results.rbegin(); it != results.rend(); ++it)
+        {
+            m_Results.push_front(std::move(*it));
+        }
+    }
+
+    // Settled before anything is evicted, eviction keeps what is on screen at the resolution it asked for
+    for (auto &texture : m_Textures)
+    {
+        texture.desiredBase = DesiredBaseLevel(texture);
+    }
+
+    QueueStreamingRequests();
+
+    if (m_ResidentBytes > m_BudgetBytes)
+    {
+        EvictToBudget();
+    }
+
+    // Draws ask again every frame
+    for (auto &texture : m_Textures)
+    {
+        texture.requestedPixels = 0;
+    }
+
+    UploadTextureTable();
+
+    m_Stats.uploadedBytesLastFrame = uploadedBytes;
+    RefreshStats();
+
+    ++m_Frame;
+}
+
+void TextureStreamer::Bind()
+{
+    for (size_t i = 0; i < m_Arrays.size(); ++i)
+    {
+        RenderingCommand::BindTexture(static_cast<RenderingAPI::Texture>(RenderingAPI::Texture::Texture0 + i),
+                                      RenderingAPI::TextureTarget::Texture2DArray, m_Arrays[i].id);
+    }
+
+    if (m_TextureTableBuffer != 0)
+    {
+        RenderingCommand::BindBufferBase(RenderingAPI::BufferTarget::ShaderStorage, s_TextureTableBinding,
+                                         m_TextureTableBuffer);
+    }
+}
+
+void TextureStreamer::UploadResult(DecodeResult &result)
+{
+    if (result.handle >= m_Textures.size())
+    {
+        return;
+    }
+
+    StreamedTexture &texture = m_Textures[result.handle];
+    texture.jobPending = false;
+
+    if (!result.success)
+    {
+        MS_ERROR("texture failed to load: {0}", texture.path);
+        texture.failed = true;
+        return;
+    }
+
+    if (texture.residentBase < 0)
+    {
+        if (texture.array < 0)
+        {
+            texture.width = result.width;
+            texture.height = result.height;
+            texture.mipCount = MipCount(result.width, result.height);
+
+            if (AcquireLayer(texture) < 0)
+            {
+                texture.failed = true;
+                return;
+            }
+        }
+
+        // Fitted into an array of another size, the tail has to be decoded again at that size
+        if (result.width != texture.width || result.height != texture.height)
+        {
+            texture.jobPending = true;
+
+            {
+                std::lock_guard<std::mutex> lock(m_JobMutex);
+                m_Jobs.push_back({result.handle, texture.path, -1, -1, texture.width, texture.height});
+            }
+
+            m_JobCondition.notify_one();
+            return;
+        }
+
+        texture.tailLevel = result.firstLevel;
+        texture.residentBase = texture.mipCount;
+    }
+
+    TextureArray &array = m_Arrays[texture.array];
+    AllocateArrayLevels(array, result.firstLevel);
+
+    RenderingCommand::BindTexture(RenderingAPI::Texture::Texture0, RenderingAPI::TextureTarget::Texture2DArray,
+                                  array.id);
+
+    int newBase = texture.residentBase;
+    for (size_t i = 0; i < result.levels.size(); ++i)
+    {
+        int level = result.firstLevel + static_cast<int>(i);
+        if (level >= texture.residentBase)
+        {
+            break;
+        }
+
+        MipLevel &mip = result.levels[i];
+        RenderingCommand::UploadTextureArrayLayer(level, texture.layer, mip.width, mip.height,
+                                                  RenderingAPI::TextureFormat::RGBA,
+                                                  RenderingAPI::NumericalDataType::UnsignedByte, mip.data.data());
+
+        newBase = std::min(newBase, level);
+    }
+
+    texture.residentBase = newBase;
+    UpdateTextureRefs(texture.array);
+
+    MS_LOUD_DEBUG("streamed texture {0}: resident from mip {1} of {2}", texture.path, texture.residentBase,
+                  texture.mipCount);
+}
+
+void TextureStreamer::QueueStreamingRequests()
+{
+    std::vector<DecodeJob> jobs;
+
+    for (unsigned handle = 0; handle < m_Textures.size(); ++handle)
+    {
+        StreamedTexture &texture = m_Textures[handle];
+
+        int desired = texture.desiredBase;
+
+        if (texture.jobPending || texture.failed || texture.residentBase < 0 || texture.lastUsedFrame != m_Frame)
+        {
+            continue;
+        }
+
+        if (desired >= texture.residentBase)
+        {
+            continue;
+        }
+
+        size_t needed = BytesToAllocate(texture, desired);
+        if (m_ResidentBytes + needed > m_BudgetBytes)
+        {
+            EvictToBudget(needed);
+        }
+
+        // Settle for fewer mips if eviction could not make room for all of them
+        while (desired < texture.residentBase && m_ResidentBytes + BytesToAllocate(texture, desired) > m_BudgetBytes)
+        {
+            ++desired;
+        }
+
+        if (desired >= texture.residentBase)
+        {
+            continue;
+        }
+
+        texture.jobPending = true;
+        jobs.push_back({handle, texture.path, desired, texture.residentBase, texture.width, texture.height});
+    }
+
+    if (jobs.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        for (auto &job : jobs)
+        {
+            m_Jobs.push_back(std::move(job));
+        }
+    }
+
+    m_JobCondition.notify_all();
+}
+
+void TextureStreamer::EvictToBudget(size_t headroom)
+{
+    size_t target = m_BudgetBytes > headroom ? m_BudgetBytes - headroom : 0;
+
+    // Array storage is shared, so memory comes back a whole level at a time, dropping it from every layer at once.
+    // Stepping a single layer down would cost it quality while freeing nothing until every other layer followed
+    while (m_ResidentBytes > target)
+    {
+        int victim = -1;
+        uint64_t victimFrame = 0;
+
+        for (int i = 0; i < static_cast<int>(m_Arrays.size()); ++i)
+        {
+            uint64_t lastUsedFrame;
+            if (CanEvictTopLevel(i, lastUsedFrame) && (victim < 0 || lastUsedFrame < victimFrame))
+            {
+                victim = i;
+                victimFrame = lastUsedFrame;
+            }
+        }
+
+        if (victim < 0)
+        {
+            break;
+        }
+
+        EvictTopLevel(victim);
+    }
+}
+
+bool TextureStreamer::CanEvictTopLevel(int arrayIndex, uint64_t &lastUsedFrame) const
+{
+    const TextureArray &array = m_Arrays[arrayIndex];
+    if (array.allocatedBase >= array.mipCount)
+    {
+        return false;
+    }
+
+    lastUsedFrame = 0;
+
+    for (auto &texture : m_Textures)
+    {
+        if (texture.array != arrayIndex || texture.residentBase != array.allocatedBase)
+        {
+            continue;
+        }
+
+        // Never evict what is on screen right now below the resolution it asked for
+        int floor = texture.lastUsedFrame == m_Frame ? texture.desiredBase : texture.tailLevel;
+
+        if (texture.jobPending || texture.residentBase >= std::min(floor, texture.tailLevel))
+        {
+            return false;
+        }
+
+        lastUsedFrame = std::max(lastUsedFrame, texture.lastUsedFrame);
+    }
+
+    return true;
+}
+
+void TextureStreamer::EvictTopLevel(int arrayIndex)
+{
+    const TextureArray &array = m_Arrays[arrayIndex];
+    int level = array.allocatedBase;
+
+    for (auto &texture : m_Textures)
+    {
+        if (texture.array == arrayIndex && texture.residentBase == level)
+        {
+            ++texture.residentBase;
+        }
+    }
+
+    ReleaseUnusedArrayLevels(arrayIndex);
+    UpdateTextureRefs(arrayIndex);
+}
+
+int TextureStreamer::AcquireLayer(StreamedTexture &texture)
+{
+    int arrayIndex = -1;
+    for (size_t i = 0; i < m_Arrays.size(); ++i)
+    {
+        const TextureArray &array = m_Arrays[i];
+        if (array.width == texture.width && array.height == texture.height && array.layerCount < s_MaxArrayLayers)
+        {
+            arrayIndex = static_cast<int>(i);
+            break;
+        }
+    }
+
+    if (arrayIndex < 0 && m_Arrays.size() >= s_MaxArraySlots)
+    {
+        arrayIndex = ClosestArray(texture.width, texture.height);
+        if (arrayIndex < 0)
+        {
+            MS_ERROR("out of texture array slots and layers for {0}x{1} texture: {2}", texture.width, texture.height,
+                     texture.path);
+            return -1;
+        }
+
+        const TextureArray &array = m_Arrays[arrayIndex];
+        MS_WARN("out of texture array slots, storing {0}x{1} texture at {2}x{3}: {4}", texture.width, texture.height,
+                array.width, array.height, texture.path);
+
+        texture.width = array.width;
+        texture.height = array.height;
+        texture.mipCount = array.mipCount;
+    }
+
+    if (arrayIndex < 0)
+    {
+        TextureArray array;
+        array.width = texture.width;
+        array.height = texture.height;
+        array.mipCount = texture.mipCount;
+        array.allocatedBase = array.mipCount;
+
+        RenderingCommand::CreateTextureArray(array.id);
+        SetArrayParameters();
+
+        m_Arrays.push_back(array);
+        arrayIndex = static_cast<int>(m_Arrays.size() - 1);
+
+        MS_DEBUG("created {0}x{1} texture array in slot {2}", array.width, array.height, arrayIndex);
+    }
+
+    TextureArray &array = m_Arrays[arrayIndex];
+    if (array.layerCount == array.layerCapacity)
+    {
+        GrowArray(array);
+    }
+
+    texture.array = arrayIndex;
+    texture.layer = array.layerCount++;
+
+    return texture.layer;
+}
+
+int TextureStreamer::ClosestArray(int width, int height) const
+{
+    int closest = -1;
+    float closestDistance = 0.0f;
+
+    // Distance in octaves per axis, so a 512x512 texture prefers 1024x1024 over 512x128
+    for (size_t i = 0; i < m_Arrays.size(); ++i)
+    {
+        const TextureArray &array = m_Arrays[i];
+        if (array.layerCount >= s_MaxArrayLayers)
+        {
+            continue;
+        }
+
+        float distance = std::abs(std::log2(static_cast<float>(array.width) / width)) +
+                         std::abs(std::log2(static_cast<float>(array.height) / height));
+
+        if (closest < 0 || distance < closestDistance)
+        {
+            closest = static_cast<int>(i);
+            closestDistance = distance;
+        }
+    }
+
+    return closest;
+}
+
+void TextureStreamer::GrowArray(TextureArray &array)
+{
+    int newCapacity = std::min(std::max(4, array.layerCapacity * 2), s_MaxArrayLayers);
+
+    if (array.allocatedBase == array.mipCount)
+    {
+        array.layerCapacity = newCapacity;
+        return;
+    }
+
+    // Layer count is fixed per level, so growing means a new array and a GPU side copy of what is resident
+    unsigned grown;
+    RenderingCommand::CreateTextureArray(grown);
+    SetArrayParameters();
+
+    for (int level = array.allocatedBase; level < array.mipCount; ++level)
+    {
+        int width = std::max(1, array.width >> level);
+        int height = std::max(1, array.height >> level);
+
+        m_ResidentBytes -= ArrayLevelBytes(array, level);
+        RenderingCommand::AllocateTextureArrayLevel(level, width, height, newCapacity);
+
+        if (array.layerCount > 0)
+        {
+            RenderingCommand::CopyTextureArrayLayers(array.id, grown, level, width, height, array.layerCount);
+        }
+    }
+
+    RenderingCommand::SetTextureMipRange(RenderingAPI::TextureTarget::Texture2DArray, array.allocatedBase,
+                                         array.mipCount - 1);
+    RenderingCommand::DeleteTexture(array.id);
+
+    array.id = grown;
+    array.layerCapacity = newCapacity;
+
+    for (int level = array.allocatedBase; level < array.mipCount; ++level)
+    {
+        m_ResidentBytes += ArrayLevelBytes(array, level);
+    }
+}
+
+void TextureStreamer::SetArrayParameters()
+{
+    RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2DArray,
+                                           RenderingAPI::TextureParameterName::TextureWrapS,
+                                           RenderingAPI::TextureParameter::Repeat);
+    RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2DArray,
+                                           RenderingAPI::TextureParameterName::TextureWrapT,
+                                           RenderingAPI::TextureParameter::Repeat);
+    RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2DArray,
+                                           RenderingAPI::TextureParameterName::TextureFilteringMin,
+                                           RenderingAPI::TextureParameter::LinearMipmapLinear);
+    RenderingCommand::SetTextureParameters(RenderingAPI::TextureTarget::Texture2DArray,
+                                           RenderingAPI::TextureParameterName::TextureFilteringMag,
+                                           RenderingAPI::TextureParameter::Linear);
+}
+
+void TextureStreamer::AllocateArrayLevels(TextureArray &array, int baseLevel)
+{
+    if (baseLevel >= array.allocatedBase)
+    {
+        return;
+    }
+
+    RenderingCommand::BindTexture(RenderingAPI::Texture::Texture0, RenderingAPI::TextureTarget::Texture2DArray,
+                                  array.id);
+
+    for (int level = array.allocatedBase - 1; level >= baseLevel; --level)
+    {
+        RenderingCommand::AllocateTextureArrayLevel(level, std::max(1, array.width >> level),
+                                                    std::max(1, array.height >> level), array.layerCapacity);
+        m_ResidentBytes += ArrayLevelBytes(array, level);
+    }
+
+    array.allocatedBase = baseLevel;
+    RenderingCommand::SetTextureMipRange(RenderingAPI::TextureTarget::Texture2DArray, array.allocatedBase,
+                                         array.mipCount - 1);
+}
+
+void TextureStreamer::ReleaseUnusedArrayLevels(int arrayIndex)
+{
+    TextureArray &array = m_Arrays[arrayIndex];
+
+    int lowestResident = array.mipCount;
+    for (auto &texture : m_Textures)
+    {
+        if (texture.array == arrayIndex && texture.residentBase >= 0)
+        {
+            lowestResident = std::min(lowestResident, texture.residentBase);
+        }
+    }
+
+    if (lowestResident <= array.allocatedBase)
+    {
+        return;
+    }
+
+    RenderingCommand::BindTexture(RenderingAPI::Texture::Texture0, RenderingAPI::TextureTarget::Texture2DArray,
+                                  array.id);
+
+    while (array.allocatedBase < lowestResident)
+    {
+        m_ResidentBytes -= ArrayLevelBytes(array, array.allocatedBase);
+        RenderingCommand::AllocateTextureArrayLevel(array.allocatedBase, 0, 0, 0);
+
+        ++array.allocatedBase;
+        ++m_Stats.evictedMips;
+    }
+
+    RenderingCommand::SetTextureMipRange(RenderingAPI::TextureTarget::Texture2DArray, array.allocatedBase,
+                                         array.mipCount - 1);
+}
+
+void TextureStreamer::UpdateTextureRefs(int arrayIndex)
+{
+    const TextureArray &array = m_Arrays[arrayIndex];
+
+    for (size_t i = 0; i < m_Textures.size(); ++i)
+    {
+        const StreamedTexture &texture = m_Textures[i];
+        if (texture.array != arrayIndex || texture.residentBase < 0)
+        {
+            continue;
+        }
+
+        // Sampling LOD is relative to the array's base level
+        TextureRef &ref = m_TextureRefs[i];
+        ref.slot = arrayIndex;
+        ref.layer = texture.layer;
+        ref.minLod = static_cast<float>(texture.residentBase - array.allocatedBase);
+    }
+
+    m_TextureTableDirty = true;
+}
+
+void TextureStreamer::UploadTextureTable()
+{
+    if (!m_TextureTableDirty || m_TextureRefs.empty())
+    {
+        return;
+    }
+
+    if (m_TextureRefs.size() > m_TextureTableCapacity)
+    {
+        size_t capacity = std::max<size_t>(m_TextureTableCapacity, 64);
+        while (capacity < m_TextureRefs.size())
+        {
+            capacity *= 2;
+        }
+
+        RenderingCommand::DeleteBuffer(m_TextureTableBuffer);
+        RenderingCommand::InitBuffer(m_TextureTableBuffer, capacity * sizeof(TextureRef), nullptr, true);
+        m_TextureTableCapacity = capacity;
+    }
+
+    RenderingCommand::UpdateBuffer(m_TextureTableBuffer, 0, m_TextureRefs.size() * sizeof(TextureRef),
+                                   m_TextureRefs.data());
+    m_TextureTableDirty = false;
+}
+
+void TextureStreamer::RefreshStats()
+{
+    m_Stats.residentBytes = m_ResidentBytes;
+    m_Stats.peakResidentBytes = std::max(m_Stats.peakResidentBytes, m_ResidentBytes);
+    m_Stats.budgetBytes = m_BudgetBytes;
+    m_Stats.textureCount = static_cast<unsigned>(m_Textures.size());
+    m_Stats.arrayCount = static_cast<unsigned>(m_Arrays.size());
+    m_Stats.fullyResidentCount = 0;
+    m_Stats.pendingRequests = 0;
+
+    for (auto &texture : m_Textures)
+    {
+        if (texture.residentBase == 0)
+        {
+            ++m_Stats.fullyResidentCount;
+        }
+
+        if (texture.jobPending)
+        {
+            ++m_Stats.pendingRequests;
+        }
+    }
+}
+
+int TextureStreamer::DesiredBaseLevel(const StreamedTexture &texture) const
+{
+    if (texture.requestedPixels <= 0)
+    {
+        return texture.tailLevel;
+    }
+
+    int maxDimension = std::max(texture.width, texture.height);
+    int level = 0;
+
+    while (level < texture.tailLevel && (maxDimension >> (level + 1)) >= texture.requestedPixels)
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+size_t TextureStreamer::ArrayLevelBytes(const TextureArray &array, int level) const
+{
+    size_t width = std::max(1, array.width >> level);
+    size_t height = std::max(1, array.height >> level);
+
+    return width * height * 4 * array.layerCapacity;
+}
+
+size_t TextureStreamer::BytesToAllocate(const StreamedTexture &texture, int baseLevel) const
+{
+    const TextureArray &array = m_Arrays[texture.array];
+
+    size_t bytes = 0;
+    for (int level = baseLevel; level < array.allocatedBase; ++level)
+    {
+        bytes += ArrayLevelBytes(array, level);
+    }
+
+    return bytes;
+}
+
+int TextureStreamer::MipCount(int width, int height)
+{
+    int count = 1;
+    int size = std::max(width, height);
+
+    while (size > 1)
+    {
+        size >>= 1;
+        ++count;
+    }
+
+    return count;
+}
+
+void TextureStreamer::WorkerLoop()
+{
+    MS_PROFILE_THREAD("Texture Streamer");
+    MS_MEMORY_TAG(Textures);
+
+    while (true)
+    {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_JobMutex);
+            m_JobCondition.wait(lock, [this]() { return m_StopWorker || !m_Jobs.empty(); });
+
+            if (m_StopWorker)
+            {
+                return;
+            }
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+
+        DecodeResult result = Decode(job);
+
+        // Posting never blocks, a dropped notification only loses the event, the result below still lands
+        m_EventQueue->Post(Core::TextureLoadedEvent(result.handle, result.success, result.width, result.height,
+                                                    result.firstLevel));
+
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        m_Results.push_back(std::move(result));
+    }
+}
+
+TextureStreamer::DecodeResult TextureStreamer::Decode(const DecodeJob &job)
+{
+    MS_PROFILE_FUNCTION();
+
+    constexpr int channels = 4;
+
+    DecodeResult result;
+    result.handle = job.handle;
+
+    // Everything is expanded to RGBA so textures of the same size share an array whatever their source format
+    int width, height, sourceChannels;
+    unsigned char *data = stbi_load(job.path.c_str(), &width, &height, &sourceChannels, channels);
+    if (!data)
+    {
+        return result;
+    }
+
+    MipLevel current{width, height, std::vector<unsigned char>(data, data + width * height * channels)};
+    stbi_image_free(data);
+
+    if (job.width > 0 && (job.width != width || job.height != height))
+    {
+        current = Resample(current, job.width, job.height);
+        width = job.width;
+        height = job.height;
+    }
+
+    int mipCount = MipCount(width, height);
+
+    int tailLevel = 0;
+    while (tailLevel < mipCount - 1 && std::max(width >> tailLevel, height >> tailLevel) > s_TailSize)
+    {
+        ++tailLevel;
+    }
+
+    int firstLevel = job.firstLevel < 0 ? tailLevel : std::min(job.firstLevel, mipCount - 1);
+    int lastLevel = job.lastLevel < 0 ? mipCount : std::min(job.lastLevel, mipCount);
+
+    result.success = true;
+    result.width = width;
+    result.height = height;
+    result.firstLevel = firstLevel;
+
+    // Box filter down the chain, keeping only the levels this job asked for
+    for (int level = 0; level < lastLevel; ++level)
+    {
+        if (level > 0)
+        {
+            MipLevel next{std::max(1, current.width / 2), std::max(1, current.height / 2), {}};
+            next.data.resize(static_cast<size_t>(next.width) * next.height * channels);
+
+            for (int y = 0; y < next.height; ++y)
+            {
+                int y0 = std::min(y * 2, current.height - 1);
+                int y1 = std::min(y * 2 + 1, current.height - 1);
+
+                for (int x = 0; x < next.width; ++x)
+                {
+                    int x0 = std::min(x * 2, current.width - 1);
+                    int x1 = std::min(x * 2 + 1, current.width - 1);
+
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        int sum = current.data[(y0 * current.width + x0) * channels + c] +
+                                  current.data[(y0 * current.width + x1) * channels + c] +
+                                  current.data[(y1 * current.width + x0) * channels + c] +
+                                  current.data[(y1 * current.width + x1) * channels + c];
+
+                        next.data[(y * next.width + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                    }
+                }
+            }
+
+            current = std::move(next);
+        }
+
+        if (level >= firstLevel)
+        {
+            result.levels.push_back(current);
+        }
+    }
+
+    return result;
+}
+
+TextureStreamer::MipLevel TextureStreamer::Resample(const MipLevel &source, int width, int height)
+{
+    constexpr int channels = 4;
+
+    MipLevel resampled{width, height, std::vector<unsigned char>(static_cast<size_t>(width) * height * channels)};
+
+    // Bilinear, good enough for the rare texture that has to be squeezed into another array's size
+    for (int y = 0; y < height; ++y)
+    {
+        float sourceY = std::max(0.0f, (y + 0.5f) * source.height / height - 0.5f);
+        int y0 = std::min(static_cast<int>(sourceY), source.height - 1);
+        int y1 = std::min(y0 + 1, source.height - 1);
+        float fy = sourceY - y0;
+
+        for (int x = 0; x < width; ++x)
+        {
+            float sourceX = std::max(0.0f, (x + 0.5f) * source.width / width - 0.5f);
+            int x0 = std::min(static_cast<int>(sourceX), source.width - 1);
+            int x1 = std::min(x0 + 1, source.width - 1);
+            float fx = sourceX - x0;
+
+            for (int c = 0; c < channels; ++c)
+            {
+                float top = source.data[(y0 * source.width + x0) * channels + c] * (1.0f - fx) +
+                            source.data[(y0 * source.width + x1) * channels + c] * fx;
+                float bottom = source.data[(y1 * source.width + x0) * channels + c] * (1.0f - fx) +
+                               source.data[(y1 * source.width + x1) * channels + c] * fx;
+
+                resampled.data[(y * width + x) * channels + c] =
+                    static_cast<unsigned char>(top * (1.0f - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+
+    return resampled;
+}
+
+} // namespace Rendering
+
+} // namespace Moonstone